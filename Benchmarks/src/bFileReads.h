@@ -0,0 +1,94 @@
+#ifndef BFILEREADS_H
+#define BFILEREADS_H "[multi@bFileReads.h]"
+/*
+*	DESCRIPTION:
+*		Module contains benchmarks of whole file reading of many small assets.
+*		Baseline is std::ifstream + std::stringstream as used by asset loaders.
+*		AsyncFileReader is measured with io_uring and with pool of threads.
+*		Files are in page cache after creation: measurement shows per-file overhead.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+//OUR
+#include "general/cAsyncFileReader.hpp"
+#include "bench.h"
+
+namespace bench {
+
+	/**
+	*	\brief Reads all '_files' by '_reader' in one batch.
+	*	Contents are kept until all files are read, as loader keeps them for decoding.
+	**/
+	inline void readBatch(AsyncFileReader& _reader, const std::vector<std::string>& _files) {
+		std::vector<AsyncFileReader::Content> _contents(_files.size());
+		size_t _left = _files.size();
+		std::mutex _lock;
+		std::condition_variable _finished;
+		for (size_t _index = 0; _index < _files.size(); _index++)
+			_reader.read(_files[_index], [_index, &_contents, &_left, &_lock, &_finished](const std::string&, AsyncFileReader::Content _content, int) {
+				std::lock_guard<std::mutex> _guard(_lock);
+				_contents[_index] = std::move(_content);
+				if (!--_left)
+					_finished.notify_one();
+			});
+		_reader.submit();
+		std::unique_lock<std::mutex> _guard(_lock);
+		_finished.wait(_guard, [&_left]() { return !_left; });
+		for (auto& _content : _contents)
+			if (_content)
+				keep((*_content)[0]);
+	}
+
+	/**
+	*	\brief Measures reads of '_count' files of '_bytes' size.
+	**/
+	inline void fileReads(unsigned int _count, unsigned int _bytes) {
+		std::vector<std::string> _files;
+		std::string _data(_bytes, 'x');
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			_files.push_back("bench_file_" + std::to_string(_index) + ".tmp");
+			std::ofstream(_files.back(), std::ios::binary) << _data;
+		}
+		Timer _timer;
+		{
+			std::vector<std::string> _contents;
+			_contents.reserve(_count);
+			for (auto& _file : _files) {
+				std::ifstream _stream(_file, std::ios::binary);
+				std::stringstream _content;
+				_content << _stream.rdbuf();
+				_contents.push_back(_content.str());
+			}
+			for (auto& _content : _contents)
+				keep(_content[0]);
+		}
+		report("file_reads", "ifstream", "read_all", _count, _timer.elapsed(), _count, _bytes);
+		{
+			AsyncFileReader _reader(ASYNCFILEREADER_QUEUE_DEPTH, false);
+			_timer.reset();
+			readBatch(_reader, _files);
+			report("file_reads", "AsyncFileReader_pool", "read_all", _count, _timer.elapsed(), _count, _bytes);
+		}
+		{
+			AsyncFileReader _reader;
+			if (_reader.usesIoUring()) {
+				_timer.reset();
+				readBatch(_reader, _files);
+				report("file_reads", "AsyncFileReader_io_uring", "read_all", _count, _timer.elapsed(), _count, _bytes);
+			}
+		}
+		for (auto& _file : _files)
+			std::remove(_file.c_str());
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,182 @@
+#ifndef BINDEXPOOLS_H
+#define BINDEXPOOLS_H "[multi@bIndexPools.h]"
+/*
+*	DESCRIPTION:
+*		Module contains benchmarks of framework index pools.
+*		Every pool is measured with same scenario:
+*			new, is_used, copy, move, delete, reuse, bulk_new, bulk_delete
+*		Pool images are measured by restore of used indexes in pool with 100 times bigger interval:
+*			rebuild (allocation one-by-one), load_image, map_image
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <utility>
+#include <cstdio>
+//OUR
+#include "general/CIndexPool.h"
+#include "general/cSimpleIndexPool.hpp"
+#include "general/cSmartSimpleIndexPool.hpp"
+#include "general/cPagedIndexPool.hpp"
+#include "bench.h"
+
+namespace bench {
+
+	//Pool adapters: pools differ in single index allocation and lookup names
+	template < class TPool >
+	inline unsigned int takeIndex(TPool& _pool) { return _pool.newIndex(); }
+
+	inline unsigned int takeIndex(SimpleIndexPool<unsigned int>& _pool) { return _pool.newIndex(-1); }
+
+	template < class TPool >
+	inline bool hasIndex(TPool& _pool, unsigned int _index) { return _pool.isUsed(_index); }
+
+	inline bool hasIndex(IndexPool<unsigned int>& _pool, unsigned int _index) { return _pool.isAllocated(_index); }
+
+	template < class TPool >
+	inline void dropRange(TPool& _pool, unsigned int _begin, unsigned int _end) { _pool.deleteIndex(_begin, _end); }
+
+	inline void dropRange(IndexPool<unsigned int>& _pool, unsigned int _begin, unsigned int _end) {
+		for (unsigned int _index = _begin; _index <= _end; _index++)
+			_pool.deleteIndex(_index);
+	}
+
+	/**
+	*	\brief Measures one index pool with '_size' indexes.
+	*	Pool is created by '_make' functor with interval twice as big as '_size'.
+	*	\param[in]	_name	Name of pool in report.
+	*	\param[in]	_size	Count of indexes to be allocated.
+	*	\param[in]	_make	Functor that constructs empty pool.
+	**/
+	template < class TPool, class TMake >
+	inline void indexPool(const char* _name, unsigned int _size, TMake _make) {
+		std::vector<unsigned int> _indexes(_size);
+		Timer _timer;
+		TPool _pool(_make());
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _size; _index++)
+			_indexes[_index] = takeIndex(_pool);
+		report("index_pool", _name, "new", _size, _timer.elapsed(), _size, _pool.usedMemory());
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _size; _index++)
+			keep(hasIndex(_pool, _indexes[_index]));
+		report("index_pool", _name, "is_used", _size, _timer.elapsed(), _size, _pool.usedMemory());
+		{
+			_timer.reset();
+			TPool _copy(_pool);
+			report("index_pool", _name, "copy", _size, _timer.elapsed(), 1, _copy.usedMemory());
+			_timer.reset();
+			TPool _moved(std::move(_copy));
+			report("index_pool", _name, "move", _size, _timer.elapsed(), 1, _moved.usedMemory());
+		}
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _size; _index++)
+			_pool.deleteIndex(_indexes[_index]);
+		report("index_pool", _name, "delete", _size, _timer.elapsed(), _size, _pool.usedMemory());
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _size; _index++)
+			_indexes[_index] = takeIndex(_pool);
+		report("index_pool", _name, "reuse", _size, _timer.elapsed(), _size, _pool.usedMemory());
+		{
+			TPool _bulk(_make());
+			_timer.reset();
+			unsigned int _allocated = _bulk.newIndex(_indexes.data(), _size);
+			report("index_pool", _name, "bulk_new", _size, _timer.elapsed(), _allocated, _bulk.usedMemory());
+			_timer.reset();
+			dropRange(_bulk, 0, _size * 2);
+			report("index_pool", _name, "bulk_delete", _size, _timer.elapsed(), _allocated, _bulk.usedMemory());
+		}
+	}
+
+	/**
+	*	Measures all framework index pools with '_size' indexes.
+	**/
+	inline void indexPools(unsigned int _size) {
+		unsigned int _max = _size * 2;
+		indexPool< IndexPool<unsigned int> >("IndexPool", _size, [_max]() {
+			IndexPool<unsigned int> _pool(0, _max, _max);
+			//Every 16th index is ignored to measure ignore checks
+			for (unsigned int _index = 0; _index < _max; _index += 16)
+				_pool.ignore(_index);
+			return _pool;
+		});
+		indexPool< SimpleIndexPool<unsigned int> >("SimpleIndexPool", _size, [_max]() {
+			return SimpleIndexPool<unsigned int>(0, _max);
+		});
+		indexPool< SmartSimpleIndexPool<unsigned int> >("SmartSimpleIndexPool", _size, [_max]() {
+			return SmartSimpleIndexPool<unsigned int>(0, _max, 64);
+		});
+		indexPool< PagedIndexPool<unsigned int> >("PagedIndexPool", _size, [_max]() {
+			return PagedIndexPool<unsigned int>(0, _max);
+		});
+	}
+
+	/**
+	*	\brief Measures restore of '_size' used indexes from pool image.
+	*	Pool interval is 100 times bigger than '_size', image file is created in working directory.
+	*	Restore by allocation is compared with loadImage and mapImage of same state.
+	**/
+	inline void indexImages(unsigned int _size) {
+		const char* _path = "bench_index_pool.img";
+		const char* _mapped = "bench_index_pool_mapped.img";
+		unsigned int _max = _size * 100;
+		Timer _timer;
+		{
+			SmartSimpleIndexPool<unsigned int> _pool(0, _max, 64);
+			for (unsigned int _index = 0; _index < _size; _index++)
+				keep(_pool.newIndex());
+			_timer.reset();
+			_pool.saveImage(_path);
+			report("index_image", "SmartSimpleIndexPool", "save_image", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		{
+			SmartSimpleIndexPool<unsigned int> _pool(0, _max, 64);
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				keep(_pool.newIndex());
+			report("index_image", "SmartSimpleIndexPool", "rebuild", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		{
+			SmartSimpleIndexPool<unsigned int> _pool(0, _max, 64);
+			_timer.reset();
+			keep(_pool.loadImage(_path));
+			report("index_image", "SmartSimpleIndexPool", "load_image", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		{
+			//Mapped image is changed by pool: map a copy
+			std::remove(_mapped);
+			std::rename(_path, _mapped);
+			SmartSimpleIndexPool<unsigned int> _pool(0, _max, 64);
+			_timer.reset();
+			keep(_pool.mapImage(_mapped));
+			report("index_image", "SmartSimpleIndexPool", "map_image", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		std::remove(_mapped);
+		{
+			PagedIndexPool<unsigned int> _pool(0, _max);
+			for (unsigned int _index = 0; _index < _size; _index++)
+				keep(_pool.newIndex());
+			_timer.reset();
+			_pool.saveImage(_path);
+			report("index_image", "PagedIndexPool", "save_image", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		{
+			PagedIndexPool<unsigned int> _pool(0, _max);
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				keep(_pool.newIndex());
+			report("index_image", "PagedIndexPool", "rebuild", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		{
+			PagedIndexPool<unsigned int> _pool(0, _max);
+			_timer.reset();
+			keep(_pool.loadImage(_path));
+			report("index_image", "PagedIndexPool", "load_image", _size, _timer.elapsed(), 1, _pool.usedMemory());
+		}
+		std::remove(_path);
+	}
+}
+#endif
\ No newline at end of file
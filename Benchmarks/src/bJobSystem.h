@@ -0,0 +1,129 @@
+#ifndef BJOBSYSTEM_H
+#define BJOBSYSTEM_H "[multi@bJobSystem.h]"
+/*
+*	DESCRIPTION:
+*		Module contains benchmarks of framework job schedulers.
+*		Throughput: empty_jobs (run + wait), parallel_for (grain 1 and 64).
+*		Latency: roundtrip (one job from main thread and wait), main_queue (worker job
+*		that schedules main queue job), dependency_chain (jobs started by runAfter one by one).
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+//OUR
+#include "general/cThreadPool.hpp"
+#include "general/cJobSystem.hpp"
+#include "bench.h"
+
+namespace bench {
+
+	//Light loop body of parallel_for measurement
+	inline void spin(size_t _begin, size_t _end) {
+		unsigned int _value = 0;
+		for (size_t _index = _begin; _index < _end; _index++)
+			_value = _value * 31u + (unsigned int)_index;
+		keep(_value);
+	}
+
+	/**
+	*	\brief Measures parallelFor of scheduler with '_size' indexes.
+	**/
+	template < class TScheduler >
+	inline void parallelFor(const char* _name, TScheduler& _scheduler, unsigned int _size) {
+		Timer _timer;
+		_scheduler.parallelFor(_size, 1, spin);
+		report("job_system", _name, "parallel_for_grain1", _size, _timer.elapsed(), _size);
+		_timer.reset();
+		_scheduler.parallelFor(_size, 64, spin);
+		report("job_system", _name, "parallel_for_grain64", _size, _timer.elapsed(), _size);
+	}
+
+	/**
+	*	\brief Measures JobSystem with '_size' jobs.
+	**/
+	inline void jobSystem(JobSystem& _jobs, unsigned int _size) {
+		Timer _timer;
+		{
+			JobSystem::Counter _counter;
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				_jobs.run([]() {}, &_counter);
+			_jobs.wait(_counter);
+			report("job_system", "JobSystem", "empty_jobs", _size, _timer.elapsed(), _size);
+		}
+		parallelFor("JobSystem", _jobs, _size);
+		unsigned int _rounds = std::min(_size, 10000u);
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _rounds; _index++) {
+			JobSystem::Counter _counter;
+			_jobs.run([]() {}, &_counter);
+			_jobs.wait(_counter);
+		}
+		report("job_system", "JobSystem", "roundtrip", _size, _timer.elapsed(), _rounds);
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _rounds; _index++) {
+			JobSystem::Counter _counter;
+			_jobs.run([&_jobs, &_counter]() { _jobs.runOnMain([]() {}, &_counter); }, &_counter);
+			_jobs.wait(_counter);
+		}
+		report("job_system", "JobSystem", "main_queue", _size, _timer.elapsed(), _rounds);
+		{
+			//Every link waits for previous one
+			std::unique_ptr<JobSystem::Counter[]> _links(new JobSystem::Counter[_rounds]);
+			_timer.reset();
+			_jobs.run([]() {}, &_links[0]);
+			for (unsigned int _index = 1; _index < _rounds; _index++)
+				_jobs.runAfter(_links[_index - 1], []() {}, &_links[_index]);
+			_jobs.wait(_links[_rounds - 1]);
+			report("job_system", "JobSystem", "dependency_chain", _size, _timer.elapsed(), _rounds);
+		}
+	}
+
+	/**
+	*	\brief Measures ThreadPool with '_size' tasks: baseline for JobSystem.
+	**/
+	inline void threadPool(ThreadPool& _pool, unsigned int _size) {
+		Timer _timer;
+		{
+			std::atomic<unsigned int> _left(_size);
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				_pool.submit([&_left]() { _left.fetch_sub(1); });
+			while (_left.load())
+				std::this_thread::yield();
+			report("job_system", "ThreadPool", "empty_jobs", _size, _timer.elapsed(), _size);
+		}
+		parallelFor("ThreadPool", _pool, _size);
+		unsigned int _rounds = std::min(_size, 10000u);
+		_timer.reset();
+		for (unsigned int _index = 0; _index < _rounds; _index++) {
+			std::atomic<bool> _done(false);
+			_pool.submit([&_done]() { _done.store(true); });
+			while (!_done.load())
+				std::this_thread::yield();
+		}
+		report("job_system", "ThreadPool", "roundtrip", _size, _timer.elapsed(), _rounds);
+	}
+
+	/**
+	*	Measures job schedulers with '_size' jobs, both use all hardware threads.
+	**/
+	inline void jobSystems(unsigned int _size) {
+		unsigned int _workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		{
+			JobSystem _jobs(_workers);
+			jobSystem(_jobs, _size);
+		}
+		{
+			ThreadPool _pool(_workers);
+			threadPool(_pool, _size);
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef BMESHLOADS_H
+#define BMESHLOADS_H "[multi@bMeshLoads.h]"
+/*
+*	DESCRIPTION:
+*		Module contains benchmarks of baked mesh loading up to buffer upload.
+*		glBufferData is modeled by copy of vertex and index blobs to upload buffer.
+*		Baseline is whole file read to memory, as non-mapped loaders do.
+*		File is in page cache after creation: measurement shows loader overhead.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+//OUR
+#include "general/cMeshFile.hpp"
+#include "bench.h"
+
+namespace bench {
+
+	/**
+	*	\brief Measures loads of mesh file of '_vertices' vertices and twice as many triangles.
+	**/
+	inline void meshLoads(unsigned int _vertices) {
+		const unsigned int _rounds = 5;
+		const char* _path = "bench_mesh.gmsh";
+		MeshFile::Header _header;
+		std::memset(&_header, 0, sizeof(_header));
+		for (auto& _attribute : _header.attributes)
+			_attribute[0] = -1;
+		_header.stride = 8;
+		_header.attributes[MeshFile::POSITION][0] = 0;
+		_header.attributes[MeshFile::POSITION][1] = 3;
+		_header.attributes[MeshFile::TEXCOORD][0] = 3;
+		_header.attributes[MeshFile::TEXCOORD][1] = 2;
+		_header.attributes[MeshFile::NORMAL][0] = 5;
+		_header.attributes[MeshFile::NORMAL][1] = 3;
+		std::vector<float> _vertexData((size_t)_vertices * _header.stride, 0.5f);
+		std::vector<uint32_t> _indexData((size_t)_vertices * 6);
+		for (size_t _index = 0; _index < _indexData.size(); _index++)
+			_indexData[_index] = (uint32_t)(_index % _vertices);
+		{
+			std::vector<char> _file;
+			MeshFile::write(_header, _vertexData, _indexData, _file);
+			std::ofstream(_path, std::ios::binary).write(_file.data(), (std::streamsize)_file.size());
+		}
+		size_t _bytes = _vertexData.size() * sizeof(float) + _indexData.size() * sizeof(uint32_t);
+		std::vector<char> _upload(_bytes);
+		VirtualFileSystem _fileSystem;
+		Timer _timer;
+		for (unsigned int _round = 0; _round < _rounds; _round++) {
+			std::vector<char> _file;
+			_fileSystem.read(_path, _file);
+			const MeshFile::Header* _mesh = MeshFile::parse(_file.data(), _file.size());
+			std::memcpy(_upload.data(), MeshFile::vertices(_file.data()), (size_t)_mesh->vertexSize);
+			std::memcpy(_upload.data() + _mesh->vertexSize, MeshFile::indices(_file.data()), (size_t)_mesh->indexSize);
+			keep(_upload[_round]);
+		}
+		report("mesh_loads", "read_whole_file", "load_upload", _vertices, _timer.elapsed(), _rounds, _bytes);
+		_timer.reset();
+		for (unsigned int _round = 0; _round < _rounds; _round++) {
+			MeshFileMapping _mesh;
+			_mesh.open(_path, _fileSystem);
+			std::memcpy(_upload.data(), _mesh.vertices(), (size_t)_mesh.header().vertexSize);
+			std::memcpy(_upload.data() + _mesh.header().vertexSize, _mesh.indices(), (size_t)_mesh.header().indexSize);
+			keep(_upload[_round]);
+		}
+		report("mesh_loads", "MeshFileMapping", "load_upload", _vertices, _timer.elapsed(), _rounds, _bytes);
+		_timer.reset();
+		//Lower bound: blobs already in memory
+		for (unsigned int _round = 0; _round < _rounds; _round++) {
+			std::memcpy(_upload.data(), _vertexData.data(), _vertexData.size() * sizeof(float));
+			std::memcpy(_upload.data() + _vertexData.size() * sizeof(float), _indexData.data(), _indexData.size() * sizeof(uint32_t));
+			keep(_upload[_round]);
+		}
+		report("mesh_loads", "in_memory", "load_upload", _vertices, _timer.elapsed(), _rounds, _bytes);
+		std::remove(_path);
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,314 @@
+#ifndef BPOLYMORPHICMAPS_H
+#define BPOLYMORPHICMAPS_H "[multi@bPolymorphicMaps.h]"
+/*
+*	DESCRIPTION:
+*		Module contains benchmarks of framework polymorphic containers.
+*		Every container is measured with same scenario:
+*			create, lookup, walk, new_copy, copy_object, move_object, delete, bulk_create, bulk_copy
+*		'walk' touches every object: through storage map with virtual call or
+*		through type chunks with direct call for SegregatedPolymorphicMap.
+*		Clones of big resources are measured separately for deep copied and
+*		copy-on-write payload: clone, first_write. 'bytes' is payload memory held by all clones.
+*		Lookups from render thread are measured while loader thread creates and deletes objects:
+*		lookup (mean), lookup_p999 (99.9 percentile of single call) for mutex guarded PolymorphicMap and RcuPolymorphicMap.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+//OUR
+#include "general/cPolymorphicMap.hpp"
+#include "general/cStrictPolymorphicMap.hpp"
+#include "general/cSegregatedPolymorphicMap.hpp"
+#include "general/cRcuPolymorphicMap.hpp"
+#include "general/cCowPayload.hpp"
+#include "bench.h"
+
+namespace bench {
+
+	/**
+	*	Base of benchmark objects, mimics RHE resources.
+	**/
+	struct Item {
+		allocateStrategy strategy;
+
+		Item() : strategy(allocateStrategy::DEFAULT) {}
+
+		virtual ~Item() {}
+
+		virtual void touch() = 0;
+
+		allocateStrategy getAllocStrategy() { return strategy; }
+	};
+
+	//Small object type
+	struct SmallItem final : public Item {
+		unsigned int value;
+
+		SmallItem() : value(0) {}
+
+		void touch() { value++; }
+	};
+
+	//Big object type
+	struct BigItem final : public Item {
+		float data[16];
+
+		BigItem() { strategy = allocateStrategy::BIG; data[0] = 0.0f; }
+
+		void touch() { data[0] += 1.0f; }
+	};
+
+	//Resource with deep copied payload (mesh data)
+	struct DeepItem final : public Item {
+		std::vector<float> payload;
+
+		explicit DeepItem(size_t _count = 0) : payload(_count, 1.0f) {}
+
+		void touch() { payload[0] += 1.0f; }
+
+		const void* block() const { return payload.data(); }
+	};
+
+	//Resource with copy-on-write payload (mesh data)
+	struct CowItem final : public Item {
+		CowPayload< std::vector<float> > payload;
+
+		explicit CowItem(size_t _count = 0) : payload(std::vector<float>(_count, 1.0f)) {}
+
+		void touch() { payload.write()[0] += 1.0f; }
+
+		const void* block() const { return payload.block(); }
+	};
+
+	/**
+	*	Opens protected storage of container for walk measurement.
+	**/
+	template < class TMap >
+	struct Exposed : public TMap {
+		using TMap::storage;
+	};
+
+	//Walk over whole storage with virtual calls
+	template < class TMap >
+	inline void walk(Exposed<TMap>& _map) {
+		for (auto& _entry : _map.storage)
+			_entry.second->touch();
+	}
+
+	//Walk over type chunks with direct calls
+	template < class TIndex, class TBase >
+	inline void walk(Exposed< SegregatedPolymorphicMap<TIndex, TBase> >& _map) {
+		_map.template forEachOf<SmallItem>([](SmallItem& _item) { _item.touch(); });
+		_map.template forEachOf<BigItem>([](BigItem& _item) { _item.touch(); });
+	}
+
+	/**
+	*	\brief Measures one polymorphic container with '_size' objects.
+	*	Objects with even identifiers are SmallItem, with odd ones are BigItem.
+	*	\param[in]	_name	Name of container in report.
+	*	\param[in]	_size	Count of objects to be created.
+	**/
+	template < class TMap >
+	inline void polymorphicMap(const char* _name, unsigned int _size) {
+		Timer _timer;
+		{
+			Exposed<TMap> _map;
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++) {
+				if (_index & 1)
+					keep(_map.template newObject<BigItem>(_index, allocateStrategy::BIG).get());
+				else
+					keep(_map.template newObject<SmallItem>(_index).get());
+			}
+			report("polymorphic_map", _name, "create", _size, _timer.elapsed(), _size);
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				_map.template getObject<Item>(_index)->touch();
+			report("polymorphic_map", _name, "lookup", _size, _timer.elapsed(), _size);
+			_timer.reset();
+			walk(_map);
+			report("polymorphic_map", _name, "walk", _size, _timer.elapsed(), _size);
+			//Copies are placed to [_size, 2 * _size)
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++) {
+				if (_index & 1)
+					keep(_map.template newCopy<BigItem>(_index, _size + _index).get());
+				else
+					keep(_map.template newCopy<SmallItem>(_index, _size + _index).get());
+			}
+			report("polymorphic_map", _name, "new_copy", _size, _timer.elapsed(), _size);
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++) {
+				if (_index & 1)
+					keep(_map.template copyObject<BigItem>(_index, _size + _index).get());
+				else
+					keep(_map.template copyObject<SmallItem>(_index, _size + _index).get());
+			}
+			report("polymorphic_map", _name, "copy_object", _size, _timer.elapsed(), _size);
+			//Copies are moved back over originals
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				keep(_map.template moveObject<Item>(_size + _index, _index).get());
+			report("polymorphic_map", _name, "move_object", _size, _timer.elapsed(), _size);
+			_timer.reset();
+			for (unsigned int _index = 0; _index < _size; _index++)
+				_map.deleteObject(_index);
+			report("polymorphic_map", _name, "delete", _size, _timer.elapsed(), _size);
+		}
+		{
+			TMap _map;
+			std::vector<unsigned int> _ids(_size);
+			for (unsigned int _index = 0; _index < _size; _index++)
+				_ids[_index] = _index;
+			std::vector< std::shared_ptr<SmallItem> > _result(_size);
+			_timer.reset();
+			unsigned int _created = _map.template newObject<SmallItem>(_ids.data(), _result.data(), _size);
+			report("polymorphic_map", _name, "bulk_create", _size, _timer.elapsed(), _created);
+			SmallItem _prototype;
+			for (unsigned int _index = 0; _index < _size; _index++)
+				_ids[_index] += _size;
+			_timer.reset();
+			_created = _map.newObject(_prototype, _ids.data(), _result.data(), _size);
+			report("polymorphic_map", _name, "bulk_copy", _size, _timer.elapsed(), _created);
+		}
+	}
+
+	/**
+	*	\brief Measures cloning of one big resource through PolymorphicMap::newCopy.
+	*	\param[in]	_name		Name of resource type in report.
+	*	\param[in]	_bytes		Payload size of resource in bytes.
+	*	\param[in]	_clones		Count of clones to be made.
+	**/
+	template < class TItem >
+	inline void payloadClones(const char* _name, unsigned int _bytes, unsigned int _clones) {
+		typedef PolymorphicMap<unsigned int, Item> Map;
+		Map _map;
+		Timer _timer;
+		_map.newObject(TItem(_bytes / sizeof(float)), 0);
+		//Payload memory held by objects: every distinct block is counted once
+		auto _held = [&_map, _bytes, _clones]() {
+			std::set<const void*> _blocks;
+			for (unsigned int _index = 0; _index <= _clones; _index++)
+				_blocks.insert(_map.template getObject<TItem>(_index)->block());
+			return (size_t)_blocks.size() * _bytes;
+		};
+		_timer.reset();
+		for (unsigned int _index = 1; _index <= _clones; _index++)
+			keep(_map.template newCopy<TItem>(0, _index).get());
+		double _elapsed = _timer.elapsed();
+		report("payload_clone", _name, "clone", _bytes, _elapsed, _clones, _held());
+		_timer.reset();
+		for (unsigned int _index = 1; _index <= _clones; _index++)
+			_map.template getObject<TItem>(_index)->touch();
+		_elapsed = _timer.elapsed();
+		report("payload_clone", _name, "first_write", _bytes, _elapsed, _clones, _held());
+	}
+
+	/**
+	*	Measures cloning of resources with '_bytes' payload: deep copy against copy-on-write.
+	**/
+	inline void payloadClones(unsigned int _bytes) {
+		payloadClones<DeepItem>("DeepPayload", _bytes, 32);
+		payloadClones<CowItem>("CowPayload", _bytes, 32);
+	}
+
+	/**
+	*	PolymorphicMap shared between threads with mutex: baseline for RcuPolymorphicMap.
+	**/
+	struct LockedMap {
+		PolymorphicMap<unsigned int, Item> map;
+		std::mutex lock;
+
+		std::shared_ptr<Item> getObject(unsigned int _Id) {
+			std::lock_guard<std::mutex> _lock(lock);
+			return map.template getObject<Item>(_Id);
+		}
+
+		void newObject(unsigned int _Id) {
+			std::lock_guard<std::mutex> _lock(lock);
+			map.template newObject<SmallItem>(_Id);
+		}
+
+		void deleteObject(unsigned int _Id) {
+			std::lock_guard<std::mutex> _lock(lock);
+			map.deleteObject(_Id);
+		}
+	};
+
+	//Adapter of RcuPolymorphicMap to LockedMap interface
+	struct RcuMap {
+		RcuPolymorphicMap<unsigned int, Item> map;
+
+		std::shared_ptr<Item> getObject(unsigned int _Id) { return map.template getObject<Item>(_Id); }
+
+		void newObject(unsigned int _Id) { map.template newObject<SmallItem>(_Id); }
+
+		void deleteObject(unsigned int _Id) { map.deleteObject(_Id); }
+	};
+
+	/**
+	*	\brief Measures lookups of reader thread while writer thread changes container.
+	*	Writer replaces one object of '_size' every 50 microseconds.
+	*	\param[in]	_name		Name of container in report.
+	*	\param[in]	_size		Count of objects in container.
+	*	\param[in]	_lookups	Count of lookups made by reader.
+	**/
+	template < class TMap >
+	inline void concurrentLookup(const char* _name, unsigned int _size, unsigned int _lookups) {
+		TMap _map;
+		for (unsigned int _index = 0; _index < _size; _index++)
+			_map.newObject(_index);
+		std::atomic<bool> _done(false);
+		std::thread _writer([&_map, &_done, _size]() {
+			unsigned int _index = 0;
+			while (!_done.load()) {
+				_map.deleteObject(_index);
+				_map.newObject(_index);
+				_index = (_index + 1) % _size;
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			}
+		});
+		std::vector<double> _latency(_lookups);
+		Timer _total;
+		for (unsigned int _lookup = 0; _lookup < _lookups; _lookup++) {
+			Timer _timer;
+			keep(_map.getObject((_lookup * 7919u) % _size).get());
+			_latency[_lookup] = _timer.elapsed();
+		}
+		double _elapsed = _total.elapsed();
+		_done.store(true);
+		_writer.join();
+		auto _percentile = _latency.begin() + (_lookups - _lookups / 1000);
+		std::nth_element(_latency.begin(), _percentile, _latency.end());
+		report("concurrent_lookup", _name, "lookup", _size, _elapsed, _lookups);
+		report("concurrent_lookup", _name, "lookup_p999", _size, *_percentile, 1);
+	}
+
+	/**
+	*	Measures lookups under concurrent writes with '_size' objects.
+	**/
+	inline void concurrentLookups(unsigned int _size) {
+		concurrentLookup<LockedMap>("LockedPolymorphicMap", _size, 2000000);
+		concurrentLookup<RcuMap>("RcuPolymorphicMap", _size, 2000000);
+	}
+
+	/**
+	*	Measures all framework polymorphic containers with '_size' objects.
+	**/
+	inline void polymorphicMaps(unsigned int _size) {
+		polymorphicMap< PolymorphicMap<unsigned int, Item> >("PolymorphicMap", _size);
+		polymorphicMap< StrictPolymorphicMap<unsigned int, Item> >("StrictPolymorphicMap", _size);
+		polymorphicMap< SegregatedPolymorphicMap<unsigned int, Item> >("SegregatedPolymorphicMap", _size);
+	}
+}
+#endif
\ No newline at end of file
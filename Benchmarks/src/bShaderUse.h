@@ -0,0 +1,146 @@
+#ifndef BSHADERUSE_H
+#define BSHADERUSE_H "[multi@bShaderUse.h]"
+/*
+*	DESCRIPTION:
+*		Module contains model of uniform binding algorithms of Shader::Use().
+*		Shader class itself isn't measured: it needs OpenGL context. Both algorithms
+*		are rewritten over model types: location lookup is search of name in
+*		table of active uniforms and glUniform is write to memory.
+*		Every fourth registered uniform is missing in program. Every eighth uniform
+*		observes value that changes every call, every sixteenth is set every call,
+*		values of others stay the same.
+*		Results compare algorithms only, they aren't measured gain of Shader::Use().
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <vector>
+#include <string>
+#include <unordered_map>
+//OUR
+#include "bench.h"
+
+namespace bench {
+
+	/**
+	*	\brief Model of uniform handler: virtual bind call that stores value by location.
+	*	Version is changed by every new value, observer takes value from '_observed' on refresh.
+	**/
+	struct ModelUniform {
+		float value;
+		float* storage;
+		unsigned int version;
+		const float* observed;
+
+		ModelUniform(float _value, float* _storage, const float* _observed = nullptr) :
+			value(_value), storage(_storage), version(0), observed(_observed) {}
+
+		virtual ~ModelUniform() {}
+
+		virtual void bindUniform(int _location) { storage[_location] = value; }
+
+		virtual void refresh() {
+			if (observed && *observed != value) {
+				value = *observed;
+				version++;
+			}
+		}
+
+		void setValue(float _value) {
+			value = _value;
+			version++;
+		}
+	};
+
+	/**
+	*	\brief Model of program: names of active uniforms and their locations.
+	**/
+	struct ModelProgram {
+		std::unordered_map<std::string, int> active;
+
+		int getUniformLocation(const std::string& _name) const {
+			auto _found = active.find(_name);
+			return _found == active.end() ? -1 : _found->second;
+		}
+	};
+
+	/**
+	*	\brief Measures modeled Use() algorithms with '_count' registered uniforms.
+	**/
+	inline void shaderUse(unsigned int _count) {
+		const unsigned int _calls = 100000;
+		ModelProgram _program;
+		std::vector<float> _storage(_count);
+		std::vector<ModelUniform> _handlers;
+		std::vector<std::string> _names;
+		//Value observed by every eighth uniform
+		float _observed = 0.0f;
+		_handlers.reserve(_count);
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			_names.push_back("material.uniform_" + std::to_string(_index));
+			_handlers.emplace_back((float)_index, _storage.data(), _index % 8 == 0 ? &_observed : nullptr);
+			if (_index % 4 != 3)
+				_program.active[_names.back()] = (int)_index;
+		}
+		//Changes made by application between calls
+		auto _update = [&_handlers, &_observed, _count](unsigned int _call) {
+			_observed = (float)_call;
+			for (unsigned int _index = 5; _index < _count; _index += 16)
+				_handlers[_index].setValue((float)_call);
+		};
+		{
+			//Model of previous Shader::Use(): map walk, unresolved and missing uniforms are requested every call
+			struct Information { ModelUniform* ptr; int location; };
+			std::map<std::string, Information> _uniforms;
+			for (unsigned int _index = 0; _index < _count; _index++)
+				_uniforms[_names[_index]] = Information{ &_handlers[_index], -1 };
+			Timer _timer;
+			for (unsigned int _call = 0; _call < _calls; _call++) {
+				_update(_call);
+				for (auto& _value : _uniforms) {
+					//Observer value is taken on every bind
+					if (_value.second.ptr->observed)
+						_value.second.ptr->refresh();
+					if (_value.second.location < 0) {
+						int _location = _program.getUniformLocation(_value.first);
+						if (_location == -1)
+							continue;
+						_value.second.location = _location;
+					}
+					_value.second.ptr->bindUniform(_value.second.location);
+				}
+			}
+			report("shader_use_model", "map_lookup", "use", _count, _timer.elapsed(), _calls);
+			keep(_storage[0]);
+		}
+		{
+			//Model of Shader::Use(): binding table resolved once, observers are refreshed,
+			//value with version that program already has isn't uploaded
+			struct Binding { int location; ModelUniform* handler; unsigned int uploaded; bool observer; };
+			std::vector<Binding> _bindings;
+			Timer _timer;
+			for (unsigned int _index = 0; _index < _count; _index++) {
+				int _location = _program.getUniformLocation(_names[_index]);
+				if (_location >= 0)
+					_bindings.push_back(Binding{ _location, &_handlers[_index], _handlers[_index].version - 1, _handlers[_index].observed != nullptr });
+			}
+			for (unsigned int _call = 0; _call < _calls; _call++) {
+				_update(_call);
+				for (auto& _binding : _bindings) {
+					if (_binding.observer)
+						_binding.handler->refresh();
+					if (_binding.handler->version == _binding.uploaded)
+						continue;
+					_binding.uploaded = _binding.handler->version;
+					_binding.handler->bindUniform(_binding.location);
+				}
+			}
+			report("shader_use_model", "binding_table", "use", _count, _timer.elapsed(), _calls);
+			keep(_storage[0]);
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef BENCH_H
+#define BENCH_H "[multi@bench.h]"
+/*
+*	DESCRIPTION:
+*		Module contains minimal timing harness for framework microbenchmarks.
+*		Every measurement is printed as one CSV line:
+*			group,container,operation,size,ns_per_op,bytes
+*		Lines starting with '#' are comments.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+namespace bench {
+
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	*	\brief Simple stopwatch.
+	*	Struct definition: Timer
+	**/
+	struct Timer {
+		Clock::time_point start;
+
+		Timer() : start(Clock::now()) {}
+
+		//Restart time measurement
+		void reset() { start = Clock::now(); }
+
+		//Nanoseconds since construction or last reset
+		double elapsed() { return std::chrono::duration<double, std::nano>(Clock::now() - start).count(); }
+	};
+
+	/**
+	*	Prints CSV header of results table.
+	**/
+	inline void header() {
+		std::printf("group,container,operation,size,ns_per_op,bytes\n");
+	}
+
+	/**
+	*	\brief Prints one measurement.
+	*	\param[in]	_group		Benchmark group name.
+	*	\param[in]	_container	Measured container.
+	*	\param[in]	_operation	Measured operation.
+	*	\param[in]	_size		Count of elements in container.
+	*	\param[in]	_ns			Total time of '_ops' operations in nanoseconds.
+	*	\param[in]	_ops		Count of performed operations.
+	*	\param[in]	_bytes		Memory used by container, 0 if not known.
+	**/
+	inline void report(	const char* _group, const char* _container, const char* _operation,
+						size_t _size, double _ns, size_t _ops, size_t _bytes = 0)
+	{
+		std::printf("%s,%s,%s,%zu,%.2f,%zu\n", _group, _container, _operation, _size, _ops ? _ns / _ops : 0.0, _bytes);
+		std::fflush(stdout);
+	}
+
+	//Sink of values that must not be optimised away
+	static volatile unsigned char sink = 0;
+
+	/**
+	*	Prevents compiler from optimising away computed '_value'.
+	**/
+	template < class T >
+	inline void keep(const T& _value) {
+		sink ^= *(const volatile unsigned char*)&_value;
+	}
+}
+#endif
\ No newline at end of file
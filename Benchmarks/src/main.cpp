@@ -0,0 +1,58 @@
+/*
+*	DESCRIPTION:
+*		Standalone microbenchmarks of framework containers (no OpenGL required).
+*		Covers index pools and polymorphic maps, sizes from 1k to 'max_size' (1M by default).
+*		Index pool images are restored with 1k to 'max_size' used indexes.
+*		Resource clones are measured with payloads from 64KiB to 16MiB.
+*		Concurrent lookups are measured with 1k and 10k objects.
+*		Job schedulers are measured with 1k to 'max_size' jobs.
+*		File reads are measured with 100 and 1000 files of 4KiB and 256KiB in working directory.
+*		Baked mesh loads are measured with 100k and 1M vertices.
+*		Binding algorithms of Shader::Use() are modeled with 4 to 256 uniforms (no OpenGL, see bShaderUse.h).
+*		Build (Linux):
+*			g++ -std=c++14 -O2 -I../../Framework -I../../Framework/general main.cpp -pthread -o bench
+*		Run:
+*			./bench [max_size] > bench_output.txt
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <cstdlib>
+//OUR
+#include "bench.h"
+#include "bIndexPools.h"
+#include "bPolymorphicMaps.h"
+#include "bJobSystem.h"
+#include "bFileReads.h"
+#include "bMeshLoads.h"
+#include "bShaderUse.h"
+
+int main(int argc, char* argv[])
+{
+	unsigned int _maxSize = 1000000;
+	if (argc > 1)
+		_maxSize = (unsigned int)std::strtoul(argv[1], nullptr, 10);
+
+	bench::header();
+	for (unsigned int _size = 1000; _size <= _maxSize; _size *= 10) {
+		bench::indexPools(_size);
+		bench::indexImages(_size);
+		bench::polymorphicMaps(_size);
+		bench::jobSystems(_size);
+	}
+	for (unsigned int _bytes = 1u << 16; _bytes <= 1u << 24; _bytes <<= 4)
+		bench::payloadClones(_bytes);
+	for (unsigned int _size = 1000; _size <= 10000 && _size <= _maxSize; _size *= 10)
+		bench::concurrentLookups(_size);
+	for (unsigned int _count = 100; _count <= 1000 && _count <= _maxSize; _count *= 10) {
+		bench::fileReads(_count, 1u << 12);
+		bench::fileReads(_count, 1u << 18);
+	}
+	for (unsigned int _vertices = 100000; _vertices <= 1000000 && _vertices <= _maxSize; _vertices *= 10)
+		bench::meshLoads(_vertices);
+	for (unsigned int _uniforms = 4; _uniforms <= 256; _uniforms *= 4)
+		bench::shaderUse(_uniforms);
+	return 0;
+}
\ No newline at end of file
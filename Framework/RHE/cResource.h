@@ -9,9 +9,8 @@
 *		https://github.com/echo-Mike
 */
 //STD
-#ifdef RHE_USE_RESOURCE_NAMES
-	#include <string>
-#endif
+#include <string>
+#include <vector>
 #ifdef UNUSED_V006
 	#include <fstream>
 #endif
@@ -19,6 +18,7 @@
 #include "RHE\vResourceGeneral.h"
 #include "general\vs2013tweaks.h"
 #include "general\vPolymorphicContainerGeneral.hpp"
+#include "general\cVirtualFileSystem.hpp"
 //DEBUG
 #if defined(DEBUG_RESOURCE) && !defined(OTHER_DEBUG)
 	#include "general\mDebug.h"		
@@ -228,6 +228,33 @@ namespace resources {
 			return false; 
 		}
 
+		/**
+		*	\brief Asynchronous loading stage: reading of resource data, runs on worker thread.
+		*	Stages of ResourceHandler::loadAsync run in order LoadRead, LoadDecode on workers
+		*	and LoadUpload on main (GL) thread. Resource that doesn't override stages is loaded by Load on main thread.
+		*	\param[in]	_fileSystem	File system of engine that loads resource: resource files must be read from it.
+		*	\throw Resource dependent.
+		*	\return Success of stage, next stages aren't run on failure.
+		**/
+		virtual inline bool LoadRead(const VirtualFileSystem&) { return true; }
+
+		/**
+		*	\brief Path of file that is read for asynchronous loading, empty if resource reads its data in LoadRead.
+		*	Called on thread that starts loading. File on disk is read by AsyncFileReader without
+		*	blocking workers, file of pack is read on worker. Content is given to LoadContent instead of LoadRead.
+		*	\throw Resource dependent.
+		**/
+		virtual inline std::string LoadPath() { return std::string(); }
+
+		//Asynchronous loading stage: takes content of file LoadPath() (may be swapped out), runs on worker thread before LoadDecode.
+		virtual inline bool LoadContent(std::vector<char>&) { return true; }
+
+		//Asynchronous loading stage: decoding of read data, runs on worker thread after LoadRead.
+		virtual inline bool LoadDecode() { return true; }
+
+		//Asynchronous loading stage: creation of GL objects, runs on main thread after LoadDecode.
+		virtual inline bool LoadUpload() { return Load(); }
+
 		#ifdef UNUSED_V006
 			//A resource dependent implementation of safe resource caching.
 			virtual inline bool Cache(std::istream& _cacheFile) {
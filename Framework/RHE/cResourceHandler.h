@@ -12,8 +12,8 @@
 //STD
 #include <memory>
 #include <algorithm>
+#include <vector>
 #ifdef UNUSED_V006
-	#include <vector>
 	#include <fstream>
 	#include <sstream>
 	#include <cstdio>
@@ -23,8 +23,13 @@
 #include "RHE\vResourceGeneral.h"
 #include "RHE\cResource.h"
 #include "general\vPolymorphicContainerGeneral.hpp"
+#include "general\cJobSystem.hpp"
+#include "general\cAsyncTask.hpp"
+#include "general\cAsyncFileReader.hpp"
 #ifdef RESOURCE_HANDLER_STRICT
 	#include "general\cStrictPolymorphicMap.hpp"
+#elif defined(RESOURCE_HANDLER_SEGREGATED)
+	#include "general\cSegregatedPolymorphicMap.hpp"
 #else
 	#include "general\cPolymorphicMap.hpp"
 #endif // RESOURCE_HANDLER_STRICT
@@ -35,6 +40,7 @@
 //#define DEBUG_RESOURCEHANDLER
 //#define RESOURCEHANDLER_MINOR_ERRORS
 //#define RESOURCE_HANDLER_STRICT
+//#define RESOURCE_HANDLER_SEGREGATED
 #if defined(DEBUG_RESOURCEHANDLER) && !defined(OTHER_DEBUG)
 	#include "general\mDebug.h"		
 #elif defined(DEBUG_RESOURCEHANDLER) && defined(OTHER_DEBUG)
@@ -82,18 +88,26 @@ namespace resources {
 	*	Class that represents resource storage for one scene.
 	*	This is a helper class with API open only to ResourceHandlingEngine.
 	*	Class have two modes NORMAL and STRICT defined in compile-time.
+	*	NORMAL mode may use type segregated storage (RESOURCE_HANDLER_SEGREGATED) that
+	*	enables public per-type bulk operations: loadAllOf, unloadAllOf.
+	*	Iteration over valid resources of some type is public: forEach, parallelForEach.
+	*	Asynchronous staged loading is public: loadAsync.
 	*	Class definition: ResourceHandler
 	**/
 	class ResourceHandler final :
 	#ifdef RESOURCE_HANDLER_STRICT
 		protected StrictPolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>
+	#elif defined(RESOURCE_HANDLER_SEGREGATED)
+		protected SegregatedPolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>
 	#else
 		protected PolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>
 	#endif
 	{
 		friend class ResourceHandlingEngine;
 		#ifdef RESOURCE_HANDLER_STRICT
-			using Base = StrictPolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>
+			using Base = StrictPolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>;
+		#elif defined(RESOURCE_HANDLER_SEGREGATED)
+			using Base = SegregatedPolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>;
 		#else
 			using Base = PolymorphicMap<ResourceID, Resource, &Resource::getAllocStrategy>;
 		#endif
@@ -183,9 +197,188 @@ namespace resources {
 			//End of bits indicator
 			MAX			= PRESENTED
 		};
+
+		template < class T, class TFunc >
+		/**
+		*	\brief Calls '_func' for every valid resource of type "T" or derived from "T".
+		*	NORMAL/STRICT : Invalid resources are skipped, not deleted.
+		*	Resources are visited in identifier order. Handler must not be changed from '_func'.
+		*	\param[in]	_func	Functor with signature void(T&).
+		*	\throw Any exception of '_func'.
+		*	\return Count of processed resources.
+		**/
+		unsigned int forEach(TFunc _func) {
+			unsigned int _processed = 0;
+			for (auto &v : storage) {
+				if (v.second->status & Resource::ResourceStatus::INVALID)
+					continue;
+				T* _resource = dynamic_cast<T*>(v.second.get());
+				if (!_resource)
+					continue;
+				_func(*_resource);
+				_processed++;
+			}
+			return _processed;
+		}
+
+		template < class T, class TFunc, class TPool = JobSystem >
+		/**
+		*	\brief Calls '_func' for every valid resource of type "T" or derived from "T" using threads of '_pool'.
+		*	NORMAL/STRICT : Resources are filtered as in forEach on calling thread, then processed
+		*	by chunks of '_grain' resources. Calling thread takes part and returns when all chunks are done.
+		*	'_func' must be safe to call for different resources simultaneously.
+		*	Handler must not be changed until return.
+		*	\param[in]	_func	Functor with signature void(T&).
+		*	\param[in]	_grain	Count of resources processed by one task.
+		*	\param[in]	_pool	Worker threads: JobSystem or other type with same parallelFor.
+		*	\throw First exception thrown by '_func', std::bad_alloc.
+		*	\return Count of processed resources.
+		**/
+		unsigned int parallelForEach(TFunc _func, unsigned int _grain = RHE_PARALLEL_GRAIN, TPool& _pool = JobSystem::global()) {
+			std::vector<T*> _resources;
+			_resources.reserve(storage.size());
+			forEach<T>([&_resources](T& _resource) { _resources.push_back(&_resource); });
+			_pool.parallelFor(_resources.size(), _grain, [&_resources, &_func](size_t _begin, size_t _end) {
+				for (size_t _index = _begin; _index < _end; _index++)
+					_func(*_resources[_index]);
+			});
+			return (unsigned int)_resources.size();
+		}
+
+		template < class T >
+		/**
+		*	\brief Starts asynchronous loading of resource with id '_Id' of type "T" or derived from "T".
+		*	NORMAL/STRICT : Resource is checked as in loadResource on calling thread.
+		*	Stages LoadRead and LoadDecode run on workers of '_jobs', LoadUpload runs on its main thread.
+		*	Resource with LoadPath gets LoadContent instead of LoadRead: file that '_fileSystem' resolves
+		*	to disk is only queued to AsyncFileReader::global(), queued reads are submitted as one batch
+		*	by pumpLoads (or AsyncFileReader::global().submit()); pack entry is read on worker.
+		*	Loads of different resources overlap. Task keeps resource alive until it is finished.
+		*	\param[in]	_Id			Identificator of resource to be processed.
+		*	\param[in]	_jobs		Job system that runs stages, its main thread must own GL context.
+		*	\param[in]	_fileSystem	File system of resource files, it must outlive task.
+		*	\throw std::bad_alloc
+		*	\return Task of loaded resource, nullptr if check, cast or any stage fails.
+		**/
+		AsyncTask< std::shared_ptr<T> > loadAsync(	const ResourceID _Id, JobSystem& _jobs = JobSystem::global(),
+													const VirtualFileSystem& _fileSystem = VirtualFileSystem::global())
+		{
+			typedef AsyncTask< std::shared_ptr<T> > Task;
+			std::shared_ptr<T> _resource;
+		#ifdef RESOURCE_HANDLER_STRICT
+			if (checkResourceAll(_Id, ResourceCheckFlags::PRESDEF, ResourceCheckFlags::LOADED | ResourceCheckFlags::INVALID))
+		#else
+			if (checkResourceAll(_Id))
+		#endif
+				_resource = std::dynamic_pointer_cast<T>(storage[_Id]);
+			if (!_resource)
+				return Task::ready(_jobs, nullptr);
+			std::string _path;
+			try { _path = _resource->LoadPath(); }
+			catch (...) { return Task::ready(_jobs, nullptr); }
+			const VirtualFileSystem* _files = &_fileSystem;
+			std::string _diskPath;
+			Task _read;
+			if (_path.empty()) {
+				_read = Task::run(_jobs, AsyncThread::WORKER, [_resource, _files]() { return loadStage(_resource, &Resource::LoadRead, *_files); });
+			} else if (_fileSystem.resolve(_path, _diskPath)) {
+				//Failed read gives nullptr content: task fails only by stage result
+				auto _content = AsyncTask<AsyncFileReader::Content>::deferred(_jobs);
+				AsyncFileReader::global().read(_diskPath, [_content](const std::string&, AsyncFileReader::Content _data, int) mutable {
+					_content.resolve(std::move(_data));
+				});
+				_read = _content.then(AsyncThread::WORKER, [_resource](AsyncFileReader::Content& _data) {
+					return _data ? loadStage(_resource, &Resource::LoadContent, *_data) : nullptr;
+				});
+			} else {
+				_read = Task::run(_jobs, AsyncThread::WORKER, [_resource, _files, _path]() -> std::shared_ptr<T> {
+					std::vector<char> _data;
+					try {
+						if (!_files->read(_path, _data))
+							return nullptr;
+					}
+					catch (...) { return nullptr; }
+					return loadStage(_resource, &Resource::LoadContent, _data);
+				});
+			}
+			return _read
+				.then(AsyncThread::WORKER, [](std::shared_ptr<T>& _loaded) { return loadStage(_loaded, &Resource::LoadDecode); })
+				.then(AsyncThread::MAIN, [](std::shared_ptr<T>& _loaded) { return loadStage(_loaded, &Resource::LoadUpload); });
+		}
+
+		/**
+		*	\brief Submits reads queued by loadAsync as one batch and runs main queue of '_jobs'.
+		*	Call once per frame (or per batch of loadAsync) on main thread instead of '_jobs.pumpMain'.
+		*	\param[in]	_jobs	Job system of loads.
+		*	\param[in]	_limit	Max count of main thread jobs to run, 0 for all queued.
+		*	\return Count of run jobs.
+		**/
+		static unsigned int pumpLoads(JobSystem& _jobs = JobSystem::global(), unsigned int _limit = 0) {
+			AsyncFileReader::global().submit();
+			return _jobs.pumpMain(_limit);
+		}
+
+		#ifdef RESOURCE_HANDLER_SEGREGATED
+			template < class T >
+			/**
+			*	\brief Performs an attempt to call Load function of all valid resources of concrete type "T".
+			*	Resources are processed in storage order with direct (non-virtual) call of T::Load.
+			*	Resources of types derived from "T" aren't processed.
+			*	\throw nothrow
+			*	\return Return true if and only if all valid resources of type "T" are successfully processed.
+			**/
+			bool loadAllOf() NOEXCEPT {
+				bool _result = true;
+				try {
+					Base::forEachOf<T>([&_result](T& _resource) {
+						if (_resource.status & Resource::ResourceStatus::INVALID)
+							return;
+						try { _result &= _resource.T::Load(); }
+						catch (...) { _result = false; }
+					});
+				}
+				catch (...) { return false; }
+				return _result;
+			}
+
+			template < class T >
+			/**
+			*	\brief Performs an attempt to call Unload function of all valid resources of concrete type "T".
+			*	Resources are processed in storage order with direct (non-virtual) call of T::Unload.
+			*	Resources of types derived from "T" aren't processed.
+			*	\throw nothrow
+			*	\return Return true if and only if all valid resources of type "T" are successfully processed.
+			**/
+			bool unloadAllOf() NOEXCEPT {
+				bool _result = true;
+				try {
+					Base::forEachOf<T>([&_result](T& _resource) {
+						if (_resource.status & Resource::ResourceStatus::INVALID)
+							return;
+						try { _result &= _resource.T::Unload(); }
+						catch (...) { _result = false; }
+					});
+				}
+				catch (...) { return false; }
+				return _result;
+			}
+		#endif // RESOURCE_HANDLER_SEGREGATED
 		
 	private:
 
+		template < class T, class... TArgs >
+		/**
+		*	\brief Runs one stage of loadAsync on '_resource' with '_args'.
+		*	\throw nothrow
+		*	\return '_resource' if stage succeeded, nullptr if it failed, threw or previous stage failed.
+		**/
+		static std::shared_ptr<T> loadStage(const std::shared_ptr<T>& _resource, bool (Resource::*_stage)(TArgs&...), TArgs&... _args) NOEXCEPT {
+			if (!_resource)
+				return nullptr;
+			try { return ((*_resource).*_stage)(_args...) ? _resource : nullptr; }
+			catch (...) { return nullptr; }
+		}
+
 		/**
 		*	\brief Check resource status to satisfy certain flag arrangement.
 		*	Checks that ALL '_upFlags' are UP and ALL '_downFlags' are DOWN.
@@ -14,10 +14,15 @@
 //OUR
 #include "general\vs2013tweaks.h"
 #include "general\mConcepts.hpp"
-#include "general\CIndexPool.h"
+#ifdef RHE_PAGED_INDEX_POOL
+	#include "general\cPagedIndexPool.hpp"
+#else
+	#include "general\cSmartSimpleIndexPool.hpp"
+#endif
 #include "RHE\vResourceGeneral.h"
 #include "RHE\cResource.h"
 #include "RHE\cResourceHandler.h"
+#include "general\cVirtualFileSystem.hpp"
 //DEBUG
 #if defined(DEBUG_RHE) && !defined(OTHER_DEBUG)
 	#include "general\mDebug.h"		
@@ -35,15 +40,30 @@ namespace resources {
 
 		using HandlersStorage = std::map<Resource*const, std::unique_ptr<ResourceHandler>>;
 
+		#ifdef RHE_PAGED_INDEX_POOL
+			//Sparse pool: memory is spent only on pages with used identificators
+			using IndexPoolType = PagedIndexPool<ResourceID>;
+		#else
+			using IndexPoolType = SmartSimpleIndexPool<ResourceID>;
+		#endif
+
 		HandlersStorage handlers;
 		
-		SmartSimpleIndexPool<ResourceID> indexPool;
+		IndexPoolType indexPool;
+
+		//File system of resource files
+		VirtualFileSystem* fileSystem = &VirtualFileSystem::global();
 	public:
 
 		ResourceHandlingEngine() = delete;
 
 		ResourceHandlingEngine(	ResourceID _maxId = RHE_GLOBAL_MAX_RESOURCES, 
-								unsigned int _bandwidth = RHE_ALLOCATION_BANDWIDTH) : indexPool(1, _maxId, _bandwidth)
+								unsigned int _bandwidth = RHE_ALLOCATION_BANDWIDTH) : 
+		#ifdef RHE_PAGED_INDEX_POOL
+								indexPool(1, _maxId)
+		#else
+								indexPool(1, _maxId, _bandwidth)
+		#endif
 		{
 			handlers[this] = std::make_unique<ResourceHandler>(ResourceHandler::ResourceHandlerStatus::PUBLIC, this);
 		}
@@ -158,6 +178,99 @@ namespace resources {
 
 		void deleteResource(ResourceID _Id, std::shared_ptr<Resource> _owner) {	deleteResource(_Id, _owner.get()); }
 
+		template < class T, class TFunc >
+		/**
+		*	\brief Calls '_func' for every valid resource of type "T" handled for '_owner'.
+		*	See ResourceHandler::forEach.
+		*	\throw std::out_of_range If '_owner' has no handler, any exception of '_func'.
+		*	\return Count of processed resources.
+		**/
+		unsigned int forEach(TFunc _func, Resource* _owner) {
+			return handlers.at(_owner)->forEach<T>(_func);
+		}
+
+		template < class T, class TFunc >
+		/**
+		*	\brief Calls '_func' in parallel for every valid resource of type "T" handled for '_owner'.
+		*	See ResourceHandler::parallelForEach.
+		*	\throw std::out_of_range If '_owner' has no handler, first exception of '_func'.
+		*	\return Count of processed resources.
+		**/
+		unsigned int parallelForEach(TFunc _func, Resource* _owner, unsigned int _grain = RHE_PARALLEL_GRAIN) {
+			return handlers.at(_owner)->parallelForEach<T>(_func, _grain);
+		}
+
+		#ifdef RESOURCE_HANDLER_SEGREGATED
+			template < class T >
+			/**
+			*	\brief Calls Load of all valid resources of concrete type "T" handled for '_owner'.
+			*	See ResourceHandler::loadAllOf.
+			*	\throw std::out_of_range If '_owner' has no handler.
+			*	\return Return true if and only if all valid resources of type "T" are successfully processed.
+			**/
+			bool loadAllOf(Resource* _owner) { return handlers.at(_owner)->loadAllOf<T>(); }
+
+			template < class T >
+			/**
+			*	\brief Calls Unload of all valid resources of concrete type "T" handled for '_owner'.
+			*	See ResourceHandler::unloadAllOf.
+			*	\throw std::out_of_range If '_owner' has no handler.
+			*	\return Return true if and only if all valid resources of type "T" are successfully processed.
+			**/
+			bool unloadAllOf(Resource* _owner) { return handlers.at(_owner)->unloadAllOf<T>(); }
+		#endif // RESOURCE_HANDLER_SEGREGATED
+
+		template < class T >
+		/**
+		*	\brief Starts asynchronous loading of resource with id '_Id' handled for '_owner'.
+		*	See ResourceHandler::loadAsync. Resource files are read from file system of engine.
+		*	\throw std::out_of_range If '_owner' has no handler, std::bad_alloc.
+		*	\return Task of loaded resource, nullptr if loading fails.
+		**/
+		AsyncTask< std::shared_ptr<T> > loadAsync(const ResourceID _Id, Resource* _owner, JobSystem& _jobs = JobSystem::global()) {
+			return handlers.at(_owner)->loadAsync<T>(_Id, _jobs, *fileSystem);
+		}
+
+		/**
+		*	\brief Submits reads queued by loadAsync as one batch and runs main queue of '_jobs'.
+		*	See ResourceHandler::pumpLoads.
+		*	\return Count of run jobs.
+		**/
+		unsigned int pumpLoads(JobSystem& _jobs = JobSystem::global(), unsigned int _limit = 0) { return ResourceHandler::pumpLoads(_jobs, _limit); }
+
+		/**
+		*	\brief Writes state of resource identificator pool to image file '_path'.
+		*	Image lets restarted process restore used identificators without resource reallocation.
+		*	\throw nothrow
+		*	\return Success of writing.
+		**/
+		bool saveIndexImage(const char* _path) NOEXCEPT { return indexPool.saveImage(_path); }
+
+		/**
+		*	\brief Restores state of resource identificator pool from image file '_path'.
+		*	Image must be made by engine with same maximal identificator. Pool is unchanged on failure.
+		*	\throw nothrow
+		*	\return Success of reading.
+		**/
+		bool loadIndexImage(const char* _path) NOEXCEPT { return indexPool.loadImage(_path); }
+
+		#ifndef RHE_PAGED_INDEX_POOL
+			/**
+			*	\brief Moves resource identificator pool to memory mapped image file '_path'.
+			*	Every later identificator allocation is stored in file. See SmartSimpleIndexPool::mapImage.
+			*	Sparse pool has no contiguous bitmap to map: only save/load are available with RHE_PAGED_INDEX_POOL.
+			*	\throw nothrow
+			*	\return Success of mapping.
+			**/
+			bool mapIndexImage(const char* _path) NOEXCEPT { return indexPool.mapImage(_path); }
+		#endif
+
+		//File system resources are loaded from
+		inline VirtualFileSystem& getFileSystem() const NOEXCEPT { return *fileSystem; }
+
+		//Sets file system given to loading stages of resources, '_fileSystem' must outlive engine and running loads
+		inline void setFileSystem(VirtualFileSystem& _fileSystem) NOEXCEPT { fileSystem = &_fileSystem; }
+
 		void secureRemove(const ResourceID _Id, ResourceHandler* const _owner) NOEXCEPT {
 			for (const auto& v : handlers) {
 				if (v.second.get() == _owner) {
@@ -62,8 +62,14 @@ namespace resources {
 		MAX = FONT
 	};
 
-	//Unsigned integer type used as resources identificator.
-	typedef unsigned int ResourceID;
+	#ifdef RHE_WIDE_RESOURCE_ID
+		//Unsigned 64-bit integer type used as resources identificator.
+		//Use with RHE_PAGED_INDEX_POOL: dense pool can't handle such intervals.
+		typedef unsigned long long ResourceID;
+	#else
+		//Unsigned integer type used as resources identificator.
+		typedef unsigned int ResourceID;
+	#endif
 
 	#ifndef RHE_GLOBAL_MAX_RESOURCES
 		/**
@@ -78,5 +84,12 @@ namespace resources {
 		**/
 		#define RHE_ALLOCATION_BANDWIDTH ((unsigned int)0x9C4)
 	#endif
+
+	#ifndef RHE_PARALLEL_GRAIN
+		/**
+		*	Default count of resources processed by one task of parallelForEach.
+		**/
+		#define RHE_PARALLEL_GRAIN ((unsigned int)0x40)
+	#endif
 }
 #endif
\ No newline at end of file
@@ -64,6 +64,17 @@ struct DirectionalLightPOD : public DirectionalLightStructComponents {
 	DirectionalLightPOD(const DirectionalLightPOD& other) :
 						ambient(other.ambient),		diffuse(other.diffuse),
 						specular(other.specular),	direction(other.direction) {}
+
+	//Write as std140 struct of uniform block: members in order of in-shader struct
+	template < class TWriter >
+	void writeStd140(TWriter& _writer) const {
+		_writer.beginStruct();
+		_writer.vec4(direction);
+		_writer.vec3(ambient);
+		_writer.vec3(diffuse);
+		_writer.vec3(specular);
+		_writer.endStruct();
+	}
 };
 
 #ifndef DIRECTIONAL_LIGHT_NAMES
@@ -133,22 +144,23 @@ struct DirectionalLightsourceStorage : public TBase {
 
 	void operator() (TPOD _light, TShader* _shader, std::string _structName) {
 		structName = std::move(_structName);
+		UniformNameId _structId = UniformNames::intern(structName);
 		TMemberInterface* _buff = nullptr;
 		_buff = data[0];
 		dynamic_cast<TMemberVector4*>(_buff)->setValue(_light.direction);
-		dynamic_cast<TMemberVector4*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[0]);
+		dynamic_cast<TMemberVector4*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[0]));
 		dynamic_cast<TMemberVector4*>(_buff)->setShader(_shader);
 		_buff = data[1];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_light.ambient);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[1]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[1]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[2];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_light.diffuse);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[2]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[2]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[3];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_light.specular);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[3]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[3]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 	}
 
@@ -178,15 +190,19 @@ struct DirectionalLightsourceStorage : public TBase {
 
 	void operator() (std::string _structName) {
 		structName = std::move(_structName);
+		setMemberNames(UniformNames::intern(structName));
+	}
+
+	void setMemberNames(UniformNameId _structId) {
 		TMemberInterface* _buff = nullptr;
 		_buff = data[0];
-		dynamic_cast<TMemberVector4*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[0]);
+		dynamic_cast<TMemberVector4*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[0]));
 		_buff = data[1];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[1]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[1]));
 		_buff = data[2];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[2]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[2]));
 		_buff = data[3];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + DIRECTIONAL_LIGHT_NAMES[3]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, DIRECTIONAL_LIGHT_NAMES[3]));
 	}
 	
 	#ifdef FWCPP17
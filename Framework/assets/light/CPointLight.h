@@ -71,6 +71,20 @@ struct PointLightPOD : public PointLightStructComponents {
 					specular(other.specular),	position(other.position),
 					constant(other.constant),	linear(other.linear),
 					quadratic(other.quadratic) {}
+
+	//Write as std140 struct of uniform block: members in order of in-shader struct
+	template < class TWriter >
+	void writeStd140(TWriter& _writer) const {
+		_writer.beginStruct();
+		_writer.vec4(position);
+		_writer.vec3(ambient);
+		_writer.vec3(diffuse);
+		_writer.vec3(specular);
+		_writer.number(constant);
+		_writer.number(linear);
+		_writer.number(quadratic);
+		_writer.endStruct();
+	}
 };
 
 #ifndef POINT_LIGHT_NAMES
@@ -166,34 +180,35 @@ struct PointLightsourceStorage : public TBase {
 
 	void operator() (TPOD _light, TShader* _shader, std::string _structName) {
 		structName = std::move(_structName);
+		UniformNameId _structId = UniformNames::intern(structName);
 		TMemberInterface* _buff = nullptr;
 		_buff = data[0];
 		dynamic_cast<TMemberVector4*>(_buff)->setValue(_light.position);
-		dynamic_cast<TMemberVector4*>(_buff)->setName(structName + POINT_LIGHT_NAMES[0]);
+		dynamic_cast<TMemberVector4*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[0]));
 		dynamic_cast<TMemberVector4*>(_buff)->setShader(_shader);
 		_buff = data[1];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_light.ambient);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + POINT_LIGHT_NAMES[1]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[1]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[2];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_light.diffuse);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + POINT_LIGHT_NAMES[2]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[2]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[3];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_light.specular);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + POINT_LIGHT_NAMES[3]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[3]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[4];
 		dynamic_cast<TMemberNumber*>(_buff)->setValue(_light.constant);
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + POINT_LIGHT_NAMES[4]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[4]));
 		dynamic_cast<TMemberNumber*>(_buff)->setShader(_shader);
 		_buff = data[5];
 		dynamic_cast<TMemberNumber*>(_buff)->setValue(_light.linear);
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + POINT_LIGHT_NAMES[5]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[5]));
 		dynamic_cast<TMemberNumber*>(_buff)->setShader(_shader);
 		_buff = data[6];
 		dynamic_cast<TMemberNumber*>(_buff)->setValue(_light.quadratic);
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + POINT_LIGHT_NAMES[6]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[6]));
 		dynamic_cast<TMemberNumber*>(_buff)->setShader(_shader);
 	}
 
@@ -235,21 +250,25 @@ struct PointLightsourceStorage : public TBase {
 
 	void operator() (std::string _structName) {
 		structName = std::move(_structName);
+		setMemberNames(UniformNames::intern(structName));
+	}
+
+	void setMemberNames(UniformNameId _structId) {
 		TMemberInterface* _buff = nullptr;
 		_buff = data[0];
-		dynamic_cast<TMemberVector4*>(_buff)->setName(structName + POINT_LIGHT_NAMES[0]);
+		dynamic_cast<TMemberVector4*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[0]));
 		_buff = data[1];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + POINT_LIGHT_NAMES[1]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[1]));
 		_buff = data[2];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + POINT_LIGHT_NAMES[2]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[2]));
 		_buff = data[3];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + POINT_LIGHT_NAMES[3]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[3]));
 		_buff = data[4];
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + POINT_LIGHT_NAMES[4]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[4]));
 		_buff = data[5];
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + POINT_LIGHT_NAMES[5]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[5]));
 		_buff = data[6];
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + POINT_LIGHT_NAMES[6]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, POINT_LIGHT_NAMES[6]));
 	}
 
 	#ifdef FWCPP17
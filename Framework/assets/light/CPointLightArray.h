@@ -0,0 +1,295 @@
+#ifndef POINTLIGHTARRAY_H
+#define POINTLIGHTARRAY_H "[0.0.5@CPointLightArray.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of point lightsource array for in-shader loading.
+*		Lights are gathered to one staging array per member (structure of arrays)
+*		and every member is uploaded by one glUniform*v call for all lights.
+*		Lights are added and removed at runtime: count is uploaded as uniform,
+*		names of uniforms don't depend on count.
+*		Shader must declare arrays instead of array of structs (see EXAMPLE_SHADERS):
+*			uniform vec4 pointLightPosition[N]; ... uniform int pointLightCount;
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <string>
+#include <vector>
+//GLEW
+#include <GL/glew.h>
+//GLM
+#include <GLM/glm.hpp>
+//OUR
+#include "CPointLight.h"
+#include "assets\shader\CUniforms.h"
+#include "assets\shader\CShader.h"
+//DEBUG
+#ifdef DEBUG_POINTLIGHTARRAY
+	#ifndef DEBUG_OUT
+		#define DEBUG_OUT std::cout
+	#endif
+	#ifndef DEBUG_NEXT_LINE
+		#define DEBUG_NEXT_LINE std::endl
+	#endif
+#endif
+
+#ifndef POINT_LIGHT_ARRAY_NAMES
+#define POINT_LIGHT_ARRAY_NAMES ___pointLightArrayNames
+	//Static array for in-shader array names: appended to array name
+	static const char* POINT_LIGHT_ARRAY_NAMES[] = {
+		"Position", "Ambient", "Diffuse", "Specular",
+		"Constant", "Linear", "Quadratic", "Count"
+	};
+#endif
+
+#ifndef POINT_LIGHT_ARRAY_STD_SHADER_VARIABLE_NAME
+	//In shader name prefix of arrays
+	#define POINT_LIGHT_ARRAY_STD_SHADER_VARIABLE_NAME "pointLight"
+#endif
+
+#ifndef POINT_LIGHT_ARRAY_STD_CAPACITY
+	//Maximal count of lights: size of in-shader arrays
+	#define POINT_LIGHT_ARRAY_STD_CAPACITY 4
+#endif
+
+/* Array of point lightsources uploaded as structure of arrays.
+*  Class template definition: PointLightArray
+*/
+template < class TVector4 = glm::vec4, class TVector3 = glm::vec3, class TNumber = float, class TShader = Shader >
+class PointLightArray : public PointLightStructComponents {
+public:
+	typedef PointLightPOD<TVector4, TVector3, TNumber> POD;
+	//Selector of count uniform: follows members of PointLightStructComponents
+	static const int COUNT = QUADRATIC + 1;
+private:
+	//NO COPYCONSTRUCT
+	PointLightArray(const PointLightArray&) = delete;
+	PointLightArray& operator=(const PointLightArray&) = delete;
+
+	/* One in-shader array: automatic uniform bound by Shader::Use.
+	*  Class definition: Member
+	*/
+	class Member : public UniformAutomaticInteface {
+		PointLightArray* owner;
+		int data;
+		UniformNameId uniformId;
+	public:
+		Member(PointLightArray* _owner, int _data) : owner(_owner), data(_data), uniformId(0) {}
+
+		void setName(UniformNameId _uniformId) { uniformId = _uniformId; }
+
+		void push() {
+			if (owner->shader)
+				owner->shader->newUniform(uniformId, this);
+		}
+
+		void pull() {
+			if (owner->shader)
+				owner->shader->deleteUniform(uniformId);
+		}
+
+		//All arrays are changed together: version of owner is shared
+		const unsigned int* getVersion() { return &owner->version; }
+
+		void bindUniform(GLint _location) {
+			owner->gather();
+			GLsizei _count = (GLsizei)owner->lights.size();
+			switch (data) {
+				case POSITION:
+					if (_count)
+						glUniform4fv(_location, _count, owner->position.data());
+					break;
+				case AMBIENT:
+				case DIFFUSE:
+				case SPECULAR:
+					if (_count)
+						glUniform3fv(_location, _count, owner->colours[data - AMBIENT].data());
+					break;
+				case CONSTANT:
+				case LINEAR:
+				case QUADRATIC:
+					if (_count)
+						glUniform1fv(_location, _count, owner->attenuation[data - CONSTANT].data());
+					break;
+				case COUNT:
+					glUniform1i(_location, (GLint)_count);
+					break;
+			}
+		}
+	};
+
+	std::vector<POD> lights;
+	//Staging arrays: vec4 positions, vec3 ambient/diffuse/specular, float constant/linear/quadratic
+	std::vector<GLfloat> position;
+	std::vector<GLfloat> colours[3];
+	std::vector<GLfloat> attenuation[3];
+	//Staging arrays must be gathered from lights
+	bool gathered;
+	//Changed on every change of lights
+	unsigned int version;
+	size_t capacity;
+	std::string arrayName;
+	TShader* shader;
+	Member members[COUNT + 1];
+
+	//Writes lights to staging arrays once per change
+	void gather() {
+		if (gathered)
+			return;
+		size_t _count = lights.size();
+		position.resize(_count * 4);
+		for (auto &_colour : colours)
+			_colour.resize(_count * 3);
+		for (auto &_number : attenuation)
+			_number.resize(_count);
+		for (size_t _index = 0; _index < _count; _index++) {
+			const POD& _light = lights[_index];
+			GLfloat* _position = &position[_index * 4];
+			_position[0] = _light.position.x;
+			_position[1] = _light.position.y;
+			_position[2] = _light.position.z;
+			_position[3] = _light.position.w;
+			const TVector3* _values[3] = { &_light.ambient, &_light.diffuse, &_light.specular };
+			for (int _colour = 0; _colour < 3; _colour++) {
+				GLfloat* _rgb = &colours[_colour][_index * 3];
+				_rgb[0] = _values[_colour]->x;
+				_rgb[1] = _values[_colour]->y;
+				_rgb[2] = _values[_colour]->z;
+			}
+			attenuation[0][_index] = _light.constant;
+			attenuation[1][_index] = _light.linear;
+			attenuation[2][_index] = _light.quadratic;
+		}
+		gathered = true;
+	}
+
+	void changed() {
+		gathered = false;
+		version++;
+	}
+public:
+	PointLightArray(TShader* _shader = nullptr,
+					std::string _arrayName = std::string(POINT_LIGHT_ARRAY_STD_SHADER_VARIABLE_NAME),
+					size_t _capacity = POINT_LIGHT_ARRAY_STD_CAPACITY) :
+					gathered(false), version(0), capacity(_capacity), shader(nullptr),
+					members{ Member(this, POSITION),	Member(this, AMBIENT),
+							 Member(this, DIFFUSE),		Member(this, SPECULAR),
+							 Member(this, CONSTANT),	Member(this, LINEAR),
+							 Member(this, QUADRATIC),	Member(this, COUNT) }
+	{
+		lights.reserve(capacity);
+		setName(std::move(_arrayName));
+		setShader(_shader);
+	}
+
+	~PointLightArray() { pull(); }
+
+	/* Adds light to end of array.
+	*  \return Index of light or -1 if array is full.
+	*/
+	int add(const POD& _light) {
+		if (lights.size() >= capacity) {
+			#ifdef DEBUG_POINTLIGHTARRAY
+				DEBUG_OUT << "ERROR::POINT_LIGHT_ARRAY::add::CAPACITY_EXCEEDED: " << capacity << DEBUG_NEXT_LINE;
+			#endif
+			return -1;
+		}
+		lights.push_back(_light);
+		changed();
+		return (int)lights.size() - 1;
+	}
+
+	//Removes light at '_index': lights after it are shifted down
+	void remove(int _index) {
+		if (_index < 0 || (size_t)_index >= lights.size())
+			return;
+		lights.erase(lights.begin() + _index);
+		changed();
+	}
+
+	//Replaces light at '_index'
+	void set(int _index, const POD& _light) {
+		lights.at(_index) = _light;
+		changed();
+	}
+
+	const POD& get(int _index) const { return lights.at(_index); }
+
+	//Removes all lights
+	void clear() {
+		lights.clear();
+		changed();
+	}
+
+	size_t size() const { return lights.size(); }
+
+	size_t getCapacity() const { return capacity; }
+
+	//Push arrays to uniform handle queue of current saved shader
+	void push() {
+		for (auto &_member : members)
+			_member.push();
+	}
+
+	//Pull arrays from uniform handle queue of current saved shader
+	void pull() {
+		for (auto &_member : members)
+			_member.pull();
+	}
+
+	//Shader pointer setup
+	void setShader(TShader* _shader) {
+		pull();
+		shader = _shader;
+		push();
+	}
+
+	//Set new in-shader prefix of array names
+	void setName(std::string _arrayName) {
+		pull();
+		arrayName = std::move(_arrayName);
+		UniformNameId _arrayId = UniformNames::intern(arrayName);
+		for (int _index = 0; _index <= COUNT; _index++)
+			members[_index].setName(UniformNames::append(_arrayId, POINT_LIGHT_ARRAY_NAMES[_index]));
+		push();
+	}
+
+	const std::string& getName() const { return arrayName; }
+};
+
+#ifdef EXAMPLE_SHADERS
+	const std::string PointLightArrayShaderExampleFS(R"**(
+		#version 330 core
+		#define NR_POINT_LIGHTS 4
+
+		uniform vec4  pointLightPosition[NR_POINT_LIGHTS];
+		uniform vec3  pointLightAmbient[NR_POINT_LIGHTS];
+		uniform vec3  pointLightDiffuse[NR_POINT_LIGHTS];
+		uniform vec3  pointLightSpecular[NR_POINT_LIGHTS];
+		uniform float pointLightConstant[NR_POINT_LIGHTS];
+		uniform float pointLightLinear[NR_POINT_LIGHTS];
+		uniform float pointLightQuadratic[NR_POINT_LIGHTS];
+		uniform int   pointLightCount;
+
+		in vec3 FragPos;
+		in vec3 Normal;
+
+		out vec4 color;
+
+		void main()
+		{
+			vec3 result = vec3(0.0);
+			vec3 norm = normalize(Normal);
+			for (int i = 0; i < min(pointLightCount, NR_POINT_LIGHTS); i++) {
+				vec3 lightDir = normalize(pointLightPosition[i].xyz - FragPos);
+				float distance = length(pointLightPosition[i].xyz - FragPos);
+				float attenuation = 1.0f / (pointLightConstant[i] + pointLightLinear[i] * distance + pointLightQuadratic[i] * (distance * distance));
+				result += attenuation * (pointLightAmbient[i] + pointLightDiffuse[i] * max(dot(norm, lightDir), 0.0));
+			}
+			color = vec4(result, 1.0f);
+		}
+	)**");
+#endif
+#endif
\ No newline at end of file
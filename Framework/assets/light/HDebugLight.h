@@ -11,9 +11,11 @@
 #ifdef DEBUG_LIGHT
 	#define DEBUG_DIRECTIONALLIGHT
 	#define DEBUG_POINTLIGHT
+	#define DEBUG_POINTLIGHTARRAY
 	#define DEBUG_SPOTLIGHT
 #endif
 #include "CDirectionalLight.h"
 #include "CPointLight.h"
+#include "CPointLightArray.h"
 //#include "CSpotlight.h"
 #endif
\ No newline at end of file
@@ -61,6 +61,17 @@ struct MaterialPOD : public MaterialStructComponents {
 	MaterialPOD(const MaterialPOD& other) : 
 				ambient(other.ambient), diffuse(other.diffuse),
 				specular(other.specular), shininess(other.shininess) {}
+
+	//Write as std140 struct of uniform block: members in order of in-shader struct
+	template < class TWriter >
+	void writeStd140(TWriter& _writer) const {
+		_writer.beginStruct();
+		_writer.vec3(ambient);
+		_writer.vec3(diffuse);
+		_writer.vec3(specular);
+		_writer.number(shininess);
+		_writer.endStruct();
+	}
 };
 
 #ifndef MATERIAL_NAMES
@@ -130,22 +141,23 @@ struct MaterialStorage : public TBase {
 
 	void operator() (TPOD _material, Shader* _shader, std::string _structName) {
 		structName = std::move(_structName);
+		UniformNameId _structId = UniformNames::intern(structName);
 		UniformManualInteface* _buff = nullptr;
 		_buff = data[0];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_material.ambient);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + MATERIAL_NAMES[0]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[0]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[1];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_material.diffuse);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + MATERIAL_NAMES[1]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[1]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[2];
 		dynamic_cast<TMemberVector3*>(_buff)->setValue(_material.specular);
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + MATERIAL_NAMES[2]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[2]));
 		dynamic_cast<TMemberVector3*>(_buff)->setShader(_shader);
 		_buff = data[3];
 		dynamic_cast<TMemberNumber*>(_buff)->setValue( _material.shininess);
-		dynamic_cast<TMemberNumber*>(_buff)->setName( structName + MATERIAL_NAMES[3]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[3]));
 		dynamic_cast<TMemberNumber*>(_buff)->setShader( _shader);
 	}
 
@@ -175,15 +187,19 @@ struct MaterialStorage : public TBase {
 
 	void operator() (std::string _structName) {
 		structName = std::move(_structName);
+		setMemberNames(UniformNames::intern(structName));
+	}
+
+	void setMemberNames(UniformNameId _structId) {
 		TMemberInterface* _buff = nullptr;
 		_buff = data[0];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + MATERIAL_NAMES[0]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[0]));
 		_buff = data[1];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + MATERIAL_NAMES[1]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[1]));
 		_buff = data[2];
-		dynamic_cast<TMemberVector3*>(_buff)->setName(structName + MATERIAL_NAMES[2]);
+		dynamic_cast<TMemberVector3*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[2]));
 		_buff = data[3];
-		dynamic_cast<TMemberNumber*>(_buff)->setName( structName + MATERIAL_NAMES[3]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, MATERIAL_NAMES[3]));
 	}
 
 	#ifdef FWCPP17
@@ -159,18 +159,19 @@ struct TextureMaterialStorage : public TBase {
 
 	void operator() (TPOD _material, Shader* _shader, std::string _structName) {
 		structName = std::move(_structName);
+		UniformNameId _structId = UniformNames::intern(structName);
 		UniformManualInteface* _buff = nullptr;
 		_buff = data[0];
 		dynamic_cast<TMemberTexture*>(_buff)->setValue(TTexture(_material.diffuseMap));
-		dynamic_cast<TMemberTexture*>(_buff)->setName(structName + TEXTURE_MATERIAL_NAMES[0]);
+		dynamic_cast<TMemberTexture*>(_buff)->setName(UniformNames::append(_structId, TEXTURE_MATERIAL_NAMES[0]));
 		dynamic_cast<TMemberTexture*>(_buff)->setShader(_shader);
 		_buff = data[1];
 		dynamic_cast<TMemberTexture*>(_buff)->setValue(TTexture(_material.specularMap));
-		dynamic_cast<TMemberTexture*>(_buff)->setName(structName + TEXTURE_MATERIAL_NAMES[1]);
+		dynamic_cast<TMemberTexture*>(_buff)->setName(UniformNames::append(_structId, TEXTURE_MATERIAL_NAMES[1]));
 		dynamic_cast<TMemberTexture*>(_buff)->setShader(_shader);
 		_buff = data[2];
 		dynamic_cast<TMemberNumber*>(_buff)->setValue(_material.shininess);
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + TEXTURE_MATERIAL_NAMES[2]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, TEXTURE_MATERIAL_NAMES[2]));
 		dynamic_cast<TMemberNumber*>(_buff)->setShader(_shader);
 
 		dynamic_cast<TMemberTexture*>(data[0])->LoadTexture();
@@ -202,13 +203,17 @@ struct TextureMaterialStorage : public TBase {
 
 	void operator() (std::string _structName) {
 		structName = std::move(_structName);
+		setMemberNames(UniformNames::intern(structName));
+	}
+
+	void setMemberNames(UniformNameId _structId) {
 		TMemberInterface* _buff = nullptr;
 		_buff = data[0];
-		dynamic_cast<TMemberTexture*>(_buff)->setName(structName + TEXTURE_MATERIAL_NAMES[0]);
+		dynamic_cast<TMemberTexture*>(_buff)->setName(UniformNames::append(_structId, TEXTURE_MATERIAL_NAMES[0]));
 		_buff = data[1];
-		dynamic_cast<TMemberTexture*>(_buff)->setName(structName + TEXTURE_MATERIAL_NAMES[1]);
+		dynamic_cast<TMemberTexture*>(_buff)->setName(UniformNames::append(_structId, TEXTURE_MATERIAL_NAMES[1]));
 		_buff = data[2];
-		dynamic_cast<TMemberNumber*>(_buff)->setName(structName + TEXTURE_MATERIAL_NAMES[2]);
+		dynamic_cast<TMemberNumber*>(_buff)->setName(UniformNames::append(_structId, TEXTURE_MATERIAL_NAMES[2]));
 	}
 	
 	#ifdef FWCPP17
@@ -13,6 +13,7 @@
 #include <GL/glew.h>
 //OUR
 #include "CSimpleMesh.h"
+#include "general\cMeshFile.hpp"
 
 /* Implementation of storage of mesh represented by arrays of data and layout structure.
 *  Class template definition: CombinedModel
@@ -26,6 +27,7 @@ public:
 		int color_offset,		color_length;
 		int texCoord_offset,	texCoord_length;
 		int normal_offset,		normal_length;
+		//Count of vertices and count of indices (three per triangle)
 		int vertices_count,		indexes_count;
 		bool indexed;
 		int stride;
@@ -53,6 +55,14 @@ public:
 								normal_offset(no),		normal_length(nl),
 								vertices_count(vc),		indexes_count(ic),
 								indexed(ind),			stride(st) {}
+
+		//Layout of baked mesh file '_mesh'
+		explicit Layout(const MeshFile::Header& _mesh) :	vertex_offset(_mesh.attributes[MeshFile::POSITION][0]),		vertex_length(_mesh.attributes[MeshFile::POSITION][1]),
+															color_offset(_mesh.attributes[MeshFile::COLOR][0]),			color_length(_mesh.attributes[MeshFile::COLOR][1]),
+															texCoord_offset(_mesh.attributes[MeshFile::TEXCOORD][0]),	texCoord_length(_mesh.attributes[MeshFile::TEXCOORD][1]),
+															normal_offset(_mesh.attributes[MeshFile::NORMAL][0]),		normal_length(_mesh.attributes[MeshFile::NORMAL][1]),
+															vertices_count((int)_mesh.vertexCount),						indexes_count((int)_mesh.indexCount),
+															indexed(_mesh.indexCount != 0),								stride((int)_mesh.stride) {}
 	};
 private:
 	Layout layout;
@@ -78,6 +88,11 @@ public:
 		SimpleMesh::allocate(bufferAlocator);
 	}
 
+	/*	Mesh of baked mesh file: mapped blobs are given to OpenGL as is.
+	*	'_mesh' must be kept open until Build() is called.
+	*/
+	explicit CombinedMesh(const MeshFileMapping& _mesh) : CombinedMesh(Layout(_mesh.header()), _mesh.vertices(), _mesh.header().indexCount ? _mesh.indices() : nullptr) {}
+
 	void drawInstance(int index = 0, GLboolean applay_shader = GL_TRUE) {
 		if (applay_shader == GL_TRUE)
 			(shader->*ApplyShader)();
@@ -88,7 +103,7 @@ public:
 		} else {
 			glDrawArrays(GL_TRIANGLES, 0, layout.vertices_count);
 		}
-		glBindVertexArray(0);
+		//Vertex array is left bound: next instance of same mesh doesn't bind it again
 	}
 
 	/*	Fix current model state in VAO
@@ -145,10 +160,10 @@ public:
 			// 2. Copy our index array in a element buffer for OpenGL to use
 			if (layout.indexed) {
 				bindBuffer(ELEMENT, GL_ELEMENT_ARRAY_BUFFER);
-				glBufferData(GL_ELEMENT_ARRAY_BUFFER, layout.indexes_count * sizeof(GLuint) * 3, elements, GL_STATIC_DRAW);
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, layout.indexes_count * sizeof(GLuint), elements, GL_STATIC_DRAW);
 			}
 		}
-		glBindVertexArray(0);
+		GLStateCache::global().bindVertexArray(0);
 	}
 };
 #endif
\ No newline at end of file
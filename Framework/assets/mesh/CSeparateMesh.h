@@ -84,7 +84,7 @@ public:
 		bindInstance(index);
 		bindBuffer(VERTEXARRAY);
 		glDrawElements(GL_TRIANGLES, indexes_count, GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
+		//Vertex array is left bound: next instance of same mesh doesn't bind it again
 	}
 
 	/*	Fix current model state in VAO
@@ -126,9 +126,9 @@ public:
 			}
 			// 2. Copy our index array in a element buffer for OpenGL to use
 			bindBuffer(ELEMENT, GL_ELEMENT_ARRAY_BUFFER);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes_count * sizeof(GLuint)* 3, elements, GL_STATIC_DRAW);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes_count * sizeof(GLuint), elements, GL_STATIC_DRAW);
 		}
-		glBindVertexArray(0);
+		GLStateCache::global().bindVertexArray(0);
 	}
 };
 #endif
\ No newline at end of file
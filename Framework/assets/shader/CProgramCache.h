@@ -0,0 +1,226 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H "[0.0.5@CProgramCache.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of on-disk cache of linked program binaries.
+*		Program is found by key: hash of shader sources, defines and
+*		vendor/renderer/version strings of driver. Binary rejected by driver
+*		(driver update, other GPU) is removed and program is compiled again.
+*		File layout:
+*			Header (24 bytes) | binary
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+//GLEW
+#include <GL/glew.h>
+//DEBUG
+#ifdef DEBUG_PROGRAMCACHE
+	#ifndef DEBUG_OUT
+		#define DEBUG_OUT std::cout
+	#endif
+	#ifndef DEBUG_NEXT_LINE
+		#define DEBUG_NEXT_LINE std::endl
+	#endif
+#endif
+
+#ifndef PROGRAM_CACHE_STD_DIRECTORY
+	//Directory of cached program binaries: must exist, empty string is working directory
+	#define PROGRAM_CACHE_STD_DIRECTORY ""
+#endif
+
+/* On-disk cache of program binaries (glGetProgramBinary/glProgramBinary).
+*  Usage: key() of sources, load() to fresh program; if it fails compile
+*  program after prepare() and store() it after successful link.
+*  Class definition: ProgramCache
+*/
+class ProgramCache {
+	//NO COPYCONSTRUCT
+	ProgramCache(const ProgramCache&) = delete;
+	ProgramCache& operator=(const ProgramCache&) = delete;
+
+	//Header of cache file
+	struct Header {
+		char magic[4];
+		GLenum format;
+		uint64_t key;
+		uint32_t length;
+		uint32_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 24, "ProgramCache: unexpected padding of header");
+
+	std::string directory;
+	//Hash of driver strings, 0 until first key is made
+	uint64_t driver;
+	bool enabled;
+	//Driver supports at least one binary format: checked on first use
+	int supported;
+
+	std::string path(uint64_t _key) const {
+		char _name[32];
+		std::snprintf(_name, sizeof(_name), "%016llx.glprog", (unsigned long long)_key);
+		return directory + _name;
+	}
+
+	bool isSupported() {
+		if (supported < 0) {
+			GLint _formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &_formats);
+			supported = _formats > 0 ? 1 : 0;
+		}
+		return supported == 1;
+	}
+public:
+	//Count of programs loaded from cache and compiled from sources
+	unsigned int hits, misses;
+
+	ProgramCache(std::string _directory = std::string(PROGRAM_CACHE_STD_DIRECTORY)) :	driver(0), enabled(true), supported(-1),
+																						hits(0), misses(0)
+	{
+		setDirectory(std::move(_directory));
+	}
+
+	//Cache used by Shader
+	static ProgramCache& global() {
+		static ProgramCache _cache;
+		return _cache;
+	}
+
+	//FNV-1a hash of '_size' bytes of '_data' continued from '_hash'
+	static uint64_t hash(const void* _data, size_t _size, uint64_t _hash = 14695981039346656037ull) {
+		const unsigned char* _bytes = (const unsigned char*)_data;
+		for (size_t _index = 0; _index < _size; _index++) {
+			_hash ^= _bytes[_index];
+			_hash *= 1099511628211ull;
+		}
+		return _hash;
+	}
+
+	void setDirectory(std::string _directory) {
+		directory = std::move(_directory);
+		if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+			directory += '/';
+	}
+
+	const std::string& getDirectory() const { return directory; }
+
+	//Turns cache on and off: disabled cache never loads and stores
+	void setEnabled(bool _enabled) { enabled = _enabled; }
+
+	bool isEnabled() const { return enabled; }
+
+	/* Key of program made from '_vertex' and '_fragment' sources with '_defines'.
+	*  OpenGL context must be current.
+	*/
+	uint64_t key(const std::string& _vertex, const std::string& _fragment, const std::string& _defines = std::string()) {
+		if (!driver) {
+			const GLenum _names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+			driver = hash(nullptr, 0);
+			for (GLenum _name : _names) {
+				const char* _string = (const char*)glGetString(_name);
+				if (_string)
+					driver = hash(_string, std::strlen(_string) + 1, driver);
+			}
+		}
+		//Sizes are hashed too: sources can't be shifted between stages
+		uint64_t _sizes[3] = { _vertex.size(), _fragment.size(), _defines.size() };
+		uint64_t _key = hash(_sizes, sizeof(_sizes), driver);
+		_key = hash(_vertex.data(), _vertex.size(), _key);
+		_key = hash(_fragment.data(), _fragment.size(), _key);
+		return hash(_defines.data(), _defines.size(), _key);
+	}
+
+	/* Loads binary of '_key' to '_program' made by glCreateProgram.
+	*  Rejected binary is removed from cache.
+	*  \return True if '_program' is linked.
+	*/
+	bool load(uint64_t _key, GLuint _program) {
+		if (!enabled || !isSupported())
+			return false;
+		std::string _path = path(_key);
+		std::ifstream _file(_path, std::ios::binary);
+		if (!_file)
+			return false;
+		Header _header;
+		std::vector<char> _binary;
+		bool _valid = (bool)_file.read((char*)&_header, sizeof(Header)) && !std::memcmp(_header.magic, "GPBC", 4) && _header.key == _key && _header.length;
+		if (_valid) {
+			_binary.resize(_header.length);
+			_valid = (bool)_file.read(_binary.data(), (std::streamsize)_binary.size());
+		}
+		_file.close();
+		GLint _success = GL_FALSE;
+		if (_valid) {
+			glProgramBinary(_program, _header.format, _binary.data(), (GLsizei)_binary.size());
+			glGetProgramiv(_program, GL_LINK_STATUS, &_success);
+		}
+		if (_success != GL_TRUE) {
+			#ifdef DEBUG_PROGRAMCACHE
+				DEBUG_OUT << "WARNING::PROGRAM_CACHE::load::BINARY_REJECTED" << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tPath: " << _path << DEBUG_NEXT_LINE;
+			#endif
+			std::remove(_path.c_str());
+			return false;
+		}
+		hits++;
+		return true;
+	}
+
+	//Asks driver to keep binary of '_program': call before glLinkProgram
+	void prepare(GLuint _program) {
+		if (enabled && isSupported())
+			glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	/* Stores binary of linked '_program' as '_key'.
+	*  File is written to temporary name first: partly written file is never loaded.
+	*/
+	void store(uint64_t _key, GLuint _program) {
+		misses++;
+		if (!enabled || !isSupported())
+			return;
+		GLint _length = 0;
+		glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &_length);
+		if (_length <= 0)
+			return;
+		std::vector<char> _binary((size_t)_length);
+		Header _header;
+		std::memcpy(_header.magic, "GPBC", 4);
+		_header.key = _key;
+		_header.reserved = 0;
+		GLsizei _written = 0;
+		glGetProgramBinary(_program, _length, &_written, &_header.format, _binary.data());
+		if (_written <= 0)
+			return;
+		_header.length = (uint32_t)_written;
+		std::string _path = path(_key);
+		std::string _temporary = _path + ".tmp";
+		{
+			std::ofstream _file(_temporary, std::ios::binary | std::ios::trunc);
+			_file.write((const char*)&_header, sizeof(Header));
+			_file.write(_binary.data(), _written);
+			if (!_file) {
+				#ifdef DEBUG_PROGRAMCACHE
+					DEBUG_OUT << "WARNING::PROGRAM_CACHE::store::FILE_NOT_WRITTEN" << DEBUG_NEXT_LINE;
+					DEBUG_OUT << "\tPath: " << _temporary << DEBUG_NEXT_LINE;
+				#endif
+				_file.close();
+				std::remove(_temporary.c_str());
+				return;
+			}
+		}
+		//Rename doesn't replace existing file on Windows
+		std::remove(_path.c_str());
+		std::rename(_temporary.c_str(), _path.c_str());
+	}
+};
+#endif
\ No newline at end of file
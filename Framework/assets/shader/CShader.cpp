@@ -1,101 +1,290 @@
 #include "CShader.h"
+
+#ifndef GL_COMPLETION_STATUS_KHR
+	//GL_KHR_parallel_shader_compile: non-blocking query of compile and link completion
+	#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+Shader* Shader::placeholder = nullptr;
+
+//Read all active uniforms of program: no location is requested by name after this
+void Shader::reflectUniforms() {
+	activeUniforms.clear();
+	GLint _count = 0, _maxLength = 0;
+	glGetProgramiv(Program, GL_ACTIVE_UNIFORMS, &_count);
+	glGetProgramiv(Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &_maxLength);
+	if (_count <= 0)
+		return;
+	std::vector<GLuint> _indices(_count);
+	std::vector<GLint> _blocks(_count);
+	for (GLint _index = 0; _index < _count; _index++)
+		_indices[_index] = (GLuint)_index;
+	glGetActiveUniformsiv(Program, _count, _indices.data(), GL_UNIFORM_BLOCK_INDEX, _blocks.data());
+	std::vector<GLchar> _buffer(_maxLength + 1);
+	activeUniforms.reserve(_count);
+	for (GLint _index = 0; _index < _count; _index++) {
+		if (_blocks[_index] != -1) //Members of uniform blocks have no location
+			continue;
+		GLsizei _length = 0;
+		ActiveUniform _uniform{ -1, GL_NONE, 0 };
+		glGetActiveUniform(Program, (GLuint)_index, (GLsizei)_buffer.size(), &_length, &_uniform.size, &_uniform.type, _buffer.data());
+		std::string _name(_buffer.data(), _length);
+		_uniform.location = glGetUniformLocation(Program, _name.c_str());
+		if (_uniform.location < 0)
+			continue;
+		activeUniforms[UniformNames::intern(_name)] = _uniform;
+		//Array is reported by first element "name[0]": base name and every element are added
+		if (_name.size() > 3 && !_name.compare(_name.size() - 3, 3, "[0]")) {
+			std::string _base = _name.substr(0, _name.size() - 3);
+			activeUniforms[UniformNames::intern(_base)] = _uniform;
+			for (GLint _element = 1; _element < _uniform.size; _element++) {
+				std::string _elementName = _base + '[' + std::to_string(_element) + ']';
+				ActiveUniform _item{ glGetUniformLocation(Program, _elementName.c_str()), _uniform.type, _uniform.size - _element };
+				if (_item.location >= 0)
+					activeUniforms[UniformNames::intern(_elementName)] = _item;
+			}
+		}
+	}
+}
+
+GLint Shader::findUniformLocation(UniformNameId _uniformId, const char* _uniformName) {
+	if (!Program)
+		return -1;
+	auto _found = activeUniforms.find(_uniformId);
+	if (_found != activeUniforms.end())
+		return _found->second.location;
+	#ifdef DEBUG_SHADERCPP
+		DEBUG_OUT << "WARNING::SHADER::findUniformLocation::UNIFORM_INACTIVE" << DEBUG_NEXT_LINE;
+		DEBUG_OUT << "\tName: " << (_uniformName ? std::string(_uniformName) : UniformNames::name(_uniformId)) << DEBUG_NEXT_LINE;
+		DEBUG_OUT << "\tFPath: " << fpath << DEBUG_NEXT_LINE;
+	#endif
+	//Inactive name is kept with size 0: it is reported once per program
+	activeUniforms.emplace(_uniformId, ActiveUniform{ -1, GL_NONE, 0 });
+	return -1;
+}
+
+//Resolve locations of new uniforms and rebuild binding table
+void Shader::resolveBindings() {
+	bindings.clear();
+	for (auto &_value : uniforms) {
+		if (_value.second.location == UniformInformation::UNRESOLVED) {
+			_value.second.location = findUniformLocation(_value.first);
+			if (_value.second.location == -1) //Uniform is inactive: it is never requested again
+				_value.second.location = UniformInformation::ABSENT;
+		}
+		if (_value.second.location >= 0) {
+			UniformBinding _binding{ _value.second.location, _value.second.ptr, _value.second.ptr->getVersion(), 0, _value.second.ptr->isObserver() };
+			//Program state is unknown after rebuild: first use uploads value
+			if (_binding.version)
+				_binding.uploaded = *_binding.version - 1;
+			bindings.push_back(_binding);
+		}
+	}
+	bindingsDirty = false;
+}
+
+void Shader::applyBlocks() {
+	if (!Program)
+		return;
+	for (auto &_block : blocks) {
+		GLuint _index = glGetUniformBlockIndex(Program, _block.first.c_str());
+		if (_index == GL_INVALID_INDEX) { //Block is optimized out or isn't declared
+			#ifdef DEBUG_SHADERCPP
+				DEBUG_OUT << "ERROR::SHADER::applyBlocks::BLOCK_NAME_MISSING" << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tName: " << _block.first << DEBUG_NEXT_LINE;
+			#endif
+			continue;
+		}
+		glUniformBlockBinding(Program, _index, _block.second);
+	}
+}
+
 //Bind shader program to OpenGL and update all uniforms
 void Shader::Use() {
-	glUseProgram(Program);
-	GLint _location = 0;
-	for (auto &_value : uniforms) {
-		if (_value.second.location < 0) {
-			_location = glGetUniformLocation(Program, _value.first.c_str());
-			if (_location == -1) { //Check if uniform not found
-				#ifdef DEBUG_SHADERCPP
-					DEBUG_OUT << "ERROR::SHADER::Use::UNIFORM_NAME_MISSING"<< DEBUG_NEXT_LINE;
-					DEBUG_OUT << "\tName: " << _value.first << DEBUG_NEXT_LINE;
-				#endif
+	if (!Program) { //Program isn't built yet: placeholder is drawn instead
+		if (placeholder && placeholder != this && placeholder->Program)
+			placeholder->Use();
+		else
+			GLStateCache::global().useProgram(0);
+		return;
+	}
+	GLStateCache::global().useProgram(Program);
+	if (bindingsDirty)
+		resolveBindings();
+	for (auto &_binding : bindings) {
+		if (_binding.observer)
+			_binding.handler->refresh();
+		if (_binding.version) {
+			if (*_binding.version == _binding.uploaded) { //Program keeps uniform values: nothing to upload
+				statistics.skipped++;
 				continue;
 			}
-			_value.second.location = _location;
+			_binding.uploaded = *_binding.version;
 		}
-		_value.second.ptr->bindUniform(_value.second.location);
+		_binding.handler->bindUniform(_binding.location);
+		statistics.bound++;
 	}
 }
 
 //Reload shader from disk (read, build and link)
 void Shader::Reload() {
-	if (Program)
-		glDeleteProgram(Program);
-	uniforms.clear();
+	cancelBuild();
+	prepareBuild();
+	submitBuild();
+	finishBuild();
+}
+
+bool Shader::prepareSources(std::string& _vertexCode, std::string& _fragmentCode) const {
 	// 1. Retrieve the vertex/fragment source code from filePath
-	std::string vertexCode;
-	std::string fragmentCode;
-	std::ifstream vShaderFile;
-	std::ifstream fShaderFile;
-	// ensures ifstream objects can throw exceptions:
-	vShaderFile.exceptions(std::ifstream::badbit);
-	fShaderFile.exceptions(std::ifstream::badbit);
-	try {
-		// Open files
-		vShaderFile.open(vpath);
-		fShaderFile.open(fpath);
-		std::stringstream vShaderStream, fShaderStream;
-		// Read file's buffer contents into streams
-		vShaderStream << vShaderFile.rdbuf();
-		fShaderStream << fShaderFile.rdbuf();
-		// close file handlers
-		vShaderFile.close();
-		fShaderFile.close();
-		// Convert stream into GLchar array
-		vertexCode = vShaderStream.str();
-		fragmentCode = fShaderStream.str();
-	}
-	catch (const std::ifstream::failure& e) {
+	// Includes are resolved and defines are injected
+	ShaderPreprocessor _preprocessor;
+	return _preprocessor.load(vpath, defines, _vertexCode) && _preprocessor.load(fpath, defines, _fragmentCode);
+}
+
+bool Shader::prepareBuild() {
+	std::string _vertexCode, _fragmentCode;
+	bool _success = prepareSources(_vertexCode, _fragmentCode);
+	prepareBuild(std::move(_vertexCode), std::move(_fragmentCode), _success);
+	return _success;
+}
+
+void Shader::prepareBuild(std::string _vertexCode, std::string _fragmentCode, bool _success) {
+	cancelBuild();
+	if (!_success) { //Nothing is submitted: failure is reported by finishBuild
 		#ifdef DEBUG_SHADERCPP
 			DEBUG_OUT << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << DEBUG_NEXT_LINE;
+			DEBUG_OUT << "\tFPath: " << fpath << DEBUG_NEXT_LINE;
 		#endif
+		build.failed = true;
+		return;
 	}
-	const GLchar* vShaderCode = vertexCode.c_str();
-	const GLchar* fShaderCode = fragmentCode.c_str();
-
-	// 2. Compile shaders
-	GLuint vertex, fragment;
-	GLint success;
-	GLchar infoLog[512];
-	// Vertex Shader
-	vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertex, 1, &vShaderCode, NULL);
-	glCompileShader(vertex);
-	// Print compile errors if any
-	glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
-	if (!success) {
-		#ifdef DEBUG_SHADERCPP
-			glGetShaderInfoLog(vertex, 512, NULL, infoLog);
-			DEBUG_OUT << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << DEBUG_NEXT_LINE;
-		#endif
-	};
-	// Similiar for Fragment Shader
-	fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragment, 1, &fShaderCode, NULL);
-	glCompileShader(fragment);
-	glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-	if (!success) {
-		#ifdef DEBUG_SHADERCPP
-			glGetShaderInfoLog(fragment, 512, NULL, infoLog);
-			DEBUG_OUT << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << DEBUG_NEXT_LINE;
-		#endif
+	build.vertexCode = std::move(_vertexCode);
+	build.fragmentCode = std::move(_fragmentCode);
+	build.prepared = true;
+}
+
+void Shader::submitBuild() {
+	if (build.submitted || build.failed)
+		return;
+	if (!build.prepared && !prepareBuild())
+		return;
+	// Linked program of same sources and driver is taken from cache
+	ProgramCache& _cache = ProgramCache::global();
+	build.key = _cache.key(build.vertexCode, build.fragmentCode, defines);
+	build.program = glCreateProgram();
+	build.cached = _cache.load(build.key, build.program);
+	if (!build.cached) {
+		const GLchar* vShaderCode = build.vertexCode.c_str();
+		const GLchar* fShaderCode = build.fragmentCode.c_str();
+		// 2. Compile shaders: status is checked by finishBuild, driver may work in background
+		build.vertex = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(build.vertex, 1, &vShaderCode, NULL);
+		glCompileShader(build.vertex);
+		build.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(build.fragment, 1, &fShaderCode, NULL);
+		glCompileShader(build.fragment);
+		// Shader Program: created before cache lookup, binary rejected by driver doesn't prevent linking
+		glAttachShader(build.program, build.vertex);
+		glAttachShader(build.program, build.fragment);
+		_cache.prepare(build.program);
+		glLinkProgram(build.program);
 	}
-	// Shader Program
-	this->Program = glCreateProgram();
-	glAttachShader(this->Program, vertex);
-	glAttachShader(this->Program, fragment);
-	glLinkProgram(this->Program);
-	// Print linking errors if any
-	glGetProgramiv(this->Program, GL_LINK_STATUS, &success);
-	if (!success) {
-		#ifdef DEBUG_SHADERCPP
-			glGetProgramInfoLog(this->Program, 512, NULL, infoLog);
-			DEBUG_OUT << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << DEBUG_NEXT_LINE;
-		#endif
+	std::string().swap(build.vertexCode);
+	std::string().swap(build.fragmentCode);
+	build.prepared = false;
+	build.submitted = true;
+}
+
+bool Shader::isBuildComplete() {
+	if (!build.submitted || build.cached || !isParallelCompileSupported())
+		return true;
+	GLint _complete = GL_TRUE;
+	glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &_complete);
+	return _complete == GL_TRUE;
+}
+
+bool Shader::finishBuild() {
+	if (build.failed) { //Sources weren't read: previous program is kept
+		cancelBuild();
+		return false;
 	}
+	if (!build.submitted)
+		return Program != 0;
+	GLint success = GL_TRUE;
+	if (!build.cached) {
+		GLchar infoLog[512];
+		// Print compile errors if any
+		glGetShaderiv(build.vertex, GL_COMPILE_STATUS, &success);
+		if (!success) {
+			#ifdef DEBUG_SHADERCPP
+				glGetShaderInfoLog(build.vertex, 512, NULL, infoLog);
+				DEBUG_OUT << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << DEBUG_NEXT_LINE;
+			#endif
+		};
+		// Similiar for Fragment Shader
+		glGetShaderiv(build.fragment, GL_COMPILE_STATUS, &success);
+		if (!success) {
+			#ifdef DEBUG_SHADERCPP
+				glGetShaderInfoLog(build.fragment, 512, NULL, infoLog);
+				DEBUG_OUT << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << DEBUG_NEXT_LINE;
+			#endif
+		}
+		// Print linking errors if any
+		glGetProgramiv(build.program, GL_LINK_STATUS, &success);
+		if (!success) {
+			#ifdef DEBUG_SHADERCPP
+				glGetProgramInfoLog(build.program, 512, NULL, infoLog);
+				DEBUG_OUT << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tFPath: " << fpath << DEBUG_NEXT_LINE;
+			#endif
+		} else {
+			ProgramCache::global().store(build.key, build.program);
+		}
+	}
+	GLuint _program = build.program;
+	build.program = 0;
 	// Delete the shaders as they're linked into our program now and no longer necessery
-	glDeleteShader(vertex);
-	glDeleteShader(fragment);
+	cancelBuild();
+	if (!success) { //Previous program is kept
+		glDeleteProgram(_program);
+		return false;
+	}
+	if (Program)
+		GLStateCache::global().deleteProgram(Program);
+	Program = _program;
+	// Locations are requested from new program: pushed uniforms are kept
+	for (auto &_value : uniforms)
+		_value.second.location = UniformInformation::UNRESOLVED;
+	bindings.clear();
+	bindingsDirty = true;
+	// Locations of all active uniforms are read once
+	reflectUniforms();
+	// Binding points of uniform blocks are part of program state
+	applyBlocks();
+	return true;
+}
+
+void Shader::cancelBuild() {
+	if (build.vertex)
+		glDeleteShader(build.vertex);
+	if (build.fragment)
+		glDeleteShader(build.fragment);
+	if (build.program)
+		glDeleteProgram(build.program);
+	build = Build();
+}
+
+bool Shader::isParallelCompileSupported() {
+	static int _supported = -1;
+	if (_supported < 0) {
+		_supported = 0;
+		GLint _count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &_count);
+		for (GLint _index = 0; _index < _count; _index++) {
+			const char* _name = (const char*)glGetStringi(GL_EXTENSIONS, _index);
+			if (_name && (!std::strcmp(_name, "GL_KHR_parallel_shader_compile") || !std::strcmp(_name, "GL_ARB_parallel_shader_compile")))
+				_supported = 1;
+		}
+	}
+	return _supported == 1;
 }
\ No newline at end of file
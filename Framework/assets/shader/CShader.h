@@ -16,12 +16,20 @@
 #include <iostream>
 //std::map
 #include <map>
+#include <unordered_map>
 //std::pair, std::make_pair
 #include <utility>
+#include <vector>
+//std::strcmp
+#include <cstring>
 //GLEW
 #include <GL/glew.h>
 //OUR
 #include "CUniforms.h"
+#include "CProgramCache.h"
+#include "CShaderPreprocessor.h"
+#include "general\cVirtualFileSystem.hpp"
+#include "ogl\CGLStateCache.h"
 //DEBUG
 
 #ifdef DEBUG_SHADER
@@ -43,8 +51,15 @@
 *  Struct definition: UniformInformation
 */
 struct UniformInformation {
+	enum : GLint {
+		//Location isn't requested from program yet
+		UNRESOLVED	= -1,
+		//Program has no such active uniform
+		ABSENT		= -2
+	};
+
 	UniformAutomaticInteface* ptr = nullptr;
-	GLint location = -1;
+	GLint location = UNRESOLVED;
 
 	UniformInformation(UniformAutomaticInteface* _ptr, GLint _location = -1) : ptr(_ptr), location(_location) {}
 
@@ -53,6 +68,40 @@ struct UniformInformation {
 	~UniformInformation() {	ptr = nullptr; }
 };
 
+/* Active uniform of linked program found by reflection after link.
+*  Struct definition: ActiveUniform
+*/
+struct ActiveUniform {
+	GLint location;
+	//Type returned by glGetActiveUniform (GL_FLOAT_VEC3, GL_SAMPLER_2D...)
+	GLenum type;
+	//Count of array elements from this one to end of array, 1 for non-arrays
+	GLint size;
+};
+
+/* Entry of flat binding table of shader: resolved location and its handler.
+*  Version uploaded to this program is kept: unchanged value isn't uploaded again.
+*  Struct definition: UniformBinding
+*/
+struct UniformBinding {
+	GLint location;
+	UniformAutomaticInteface* handler;
+	//Version counter of handler, nullptr if handler must be bound on every use
+	const unsigned int* version;
+	//Version of value in program
+	unsigned int uploaded;
+	//Handler must be refreshed before version is compared
+	bool observer;
+};
+
+/* Counters of automatic uniform uploads made and skipped by Shader::Use.
+*  Struct definition: UniformStatistics
+*/
+struct UniformStatistics {
+	unsigned int bound = 0;
+	unsigned int skipped = 0;
+};
+
 /* This class represents a shader (fragment and vertex) of OpenGL pipeline.
 *  Class definition: Shader
 */
@@ -61,10 +110,50 @@ class Shader {
 	Shader() = delete;
 	Shader(const Shader& s) = delete;
 	Shader(const Shader&& s) = delete;
-	//Uniform container
-	std::map<std::string, UniformInformation> uniforms;
+	//Uniform container: handlers by interned name
+	std::unordered_map<UniformNameId, UniformInformation> uniforms;
+	//Active uniforms of Program by interned name: arrays are found by "name", "name[0]" and "name[i]"
+	std::unordered_map<UniformNameId, ActiveUniform> activeUniforms;
+	//Uniforms present in program: walked by Use()
+	std::vector<UniformBinding> bindings;
+	//Bindings must be rebuilt from uniforms
+	bool bindingsDirty;
+	//Uploads made and skipped since last reset
+	UniformStatistics statistics;
+	//Program build in flight: replaces Program when it is finished successfully
+	struct Build {
+		std::string vertexCode, fragmentCode;
+		bool prepared = false;
+		bool submitted = false;
+		//Sources can't be read: finishBuild reports failure
+		bool failed = false;
+		//Program is loaded from binary cache: there are no stages to check
+		bool cached = false;
+		GLuint program = 0, vertex = 0, fragment = 0;
+		uint64_t key = 0;
+	} build;
+	//Program used by Use() of any shader that has no linked program yet
+	static Shader* placeholder;
+	//Uniform block names and their binding points: kept through Reload
+	std::map<std::string, GLuint> blocks;
+	//Define block injected to both stages (ShaderPreprocessor::definesText)
+	std::string defines;
 	//The program ID //SPO ID
 	GLuint Program;
+
+	//Fills active uniform table of Program: called once after link
+	void reflectUniforms();
+
+	/* Location of '_uniformId' in active uniform table: inactive name is reported once.
+	*  '_uniformName' is used by report if name isn't interned.
+	*/
+	GLint findUniformLocation(UniformNameId _uniformId, const char* _uniformName = nullptr);
+
+	//Resolves new uniforms once and rebuilds bindings
+	void resolveBindings();
+
+	//Connects uniform blocks of linked program to their binding points
+	void applyBlocks();
 public:
 	//Vertex and Fragment shader paths
 	std::string vpath, fpath;
@@ -73,58 +162,93 @@ public:
 	GLuint getShaderId() { return Program; }
 
 	//Returns result of uniform search: location detemined by name
-	GLint getUniformLocation(const char* _uniformName) {
-		GLint _location;
-		_location = glGetUniformLocation(Program, _uniformName);
-		if (_location == -1) { //Check if uniform not found
-			#ifdef DEBUG_SHADER
-				DEBUG_OUT << "ERROR::SHADER::getUniformLocation::UNIFORM_NAME_MISSING"<< DEBUG_NEXT_LINE;
-				DEBUG_OUT << "\tName: " << _uniformName << DEBUG_NEXT_LINE;
-				DEBUG_OUT << "\tFPath: " << fpath << DEBUG_NEXT_LINE;
-			#endif
-		}
-		return _location;
-	}
+	GLint getUniformLocation(const char* _uniformName) { return findUniformLocation(UniformNames::hash(_uniformName, std::strlen(_uniformName)), _uniformName); }
 
 	//Returns result of uniform search: location detemined by name
-	GLint getUniformLocation(std::string &_uniformName) {
-		GLint _location;
-		_location = glGetUniformLocation(Program, _uniformName.c_str());
-		if (_location == -1) { //Check if uniform not found
-			#ifdef DEBUG_SHADER
-				DEBUG_OUT << "ERROR::SHADER::getUniformLocation::UNIFORM_NAME_MISSING"<< DEBUG_NEXT_LINE;
-				DEBUG_OUT << "\tName: " << _uniformName << DEBUG_NEXT_LINE;
-				DEBUG_OUT << "\tFPath: " << fpath << DEBUG_NEXT_LINE;
-			#endif
-		}
-		return _location;
+	GLint getUniformLocation(std::string &_uniformName) { return findUniformLocation(UniformNames::hash(_uniformName), _uniformName.c_str()); }
+
+	//Returns result of uniform search: location detemined by name identity
+	GLint getUniformLocation(UniformNameId _uniformId) { return findUniformLocation(_uniformId); }
+
+	//Returns reflected information of active uniform '_uniformId' or nullptr if it isn't active
+	const ActiveUniform* getActiveUniform(UniformNameId _uniformId) const {
+		auto _found = activeUniforms.find(_uniformId);
+		return _found != activeUniforms.end() && _found->second.size > 0 ? &_found->second : nullptr;
 	}
 
-	Shader(const GLchar* vertexPath, const GLchar* fragmentPath) :	vpath(vertexPath), 
-																	fpath(fragmentPath), 
-																	Program(0) { Reload(); }
+	const ActiveUniform* getActiveUniform(const std::string& _uniformName) const { return getActiveUniform(UniformNames::hash(_uniformName)); }
+
+	//Returns table of active uniforms of program: names are found by UniformNames::name
+	const std::unordered_map<UniformNameId, ActiveUniform>& getActiveUniforms() const { return activeUniforms; }
+
+	Shader(const GLchar* vertexPath, const GLchar* fragmentPath,
+			const ShaderDefines& _defines = ShaderDefines()) :	vpath(vertexPath), 
+																fpath(fragmentPath), 
+																bindingsDirty(true),
+																defines(ShaderPreprocessor::definesText(_defines)),
+																Program(0) { Reload(); }
+
+	Shader(std::string& vertexPath, std::string& fragmentPath,
+			const ShaderDefines& _defines = ShaderDefines()) :	vpath(vertexPath),
+																fpath(fragmentPath), 
+																bindingsDirty(true),
+																defines(ShaderPreprocessor::definesText(_defines)),
+																Program(0) { Reload(); }
+
+	//Tag of constructor that doesn't build program
+	struct Deferred {};
 
-	Shader(std::string& vertexPath, std::string& fragmentPath) : vpath(vertexPath),
-																 fpath(fragmentPath), 
-																 Program(0) { Reload(); }
+	/* Shader without program: build is made by ShaderCompileQueue or Reload.
+	*  Uniforms can be pushed before program is ready.
+	*/
+	Shader(std::string vertexPath, std::string fragmentPath, const ShaderDefines& _defines, Deferred) :
+			vpath(std::move(vertexPath)), fpath(std::move(fragmentPath)), bindingsDirty(true),
+			defines(ShaderPreprocessor::definesText(_defines)), Program(0) {}
+
+	//Returns define block of this variant
+	const std::string& getDefines() const { return defines; }
 
 	~Shader() {
 		//Prevent external values from destructor calls
 		for (auto &v : uniforms)
 			v.second.ptr = nullptr;
-		glDeleteProgram(this->Program); 
+		if (placeholder == this)
+			placeholder = nullptr;
+		cancelBuild();
+		GLStateCache::global().deleteProgram(this->Program);
+	}
+
+	void newUniform(UniformNameId _uniformId, UniformAutomaticInteface* _handler) {
+		auto _found = uniforms.find(_uniformId);
+		if (_found != uniforms.end())
+			_found->second.ptr = _handler;
+		else
+			uniforms.emplace(_uniformId, UniformInformation(_handler));
+		bindingsDirty = true;
 	}
 
-	void newUniform(std::string &_uniformName, UniformAutomaticInteface* _handler) {
-		uniforms[_uniformName] = std::move(UniformInformation(_handler));
+	void newUniform(std::string &_uniformName, UniformAutomaticInteface* _handler) { newUniform(UniformNames::intern(_uniformName), _handler); }
+
+	void deleteUniform(UniformNameId _uniformId) {
+		uniforms.erase(_uniformId);
+		bindingsDirty = true;
 	}
 
-	void deleteUniform(const char* _key) { uniforms.erase(std::string(_key)); }
+	void deleteUniform(const char* _key) { deleteUniform(UniformNames::hash(_key, std::strlen(_key))); }
 
-	void deleteUniform(std::string &_key) { uniforms.erase(_key); }
+	void deleteUniform(std::string &_key) { deleteUniform(UniformNames::hash(_key)); }
 	
+	//Connects uniform block '_blockName' to binding point '_binding' now and after every Reload
+	void bindBlock(const std::string& _blockName, GLuint _binding) {
+		blocks[_blockName] = _binding;
+		applyBlocks();
+	}
+
 	//Find uniform in queue by it's name
-	bool find(std::string &_key) { return uniforms.find(_key) != uniforms.end(); }
+	bool find(std::string &_key) { return find(UniformNames::hash(_key)); }
+
+	//Find uniform in queue by identity of it's name
+	bool find(UniformNameId _uniformId) { return uniforms.find(_uniformId) != uniforms.end(); }
 
 	//Find uniform in queue by pointer to it
 	bool find(UniformAutomaticInteface* _toFind) {
@@ -136,6 +260,58 @@ public:
 
 	void Use();
 
+	//Returns counters of uniform uploads made and skipped by Use()
+	const UniformStatistics& getUniformStatistics() const { return statistics; }
+
+	//Resets counters of uniform uploads: call once per frame to get per-frame numbers
+	void resetUniformStatistics() { statistics = UniformStatistics(); }
+
+	//Reload shader from disk: build is made and finished at once
 	void Reload();
+
+	/* Reads and preprocesses sources to '_vertexCode' and '_fragmentCode'.
+	*  Reads only paths and defines, which don't change after construction: may run on worker thread.
+	*  \return False if sources can't be read.
+	*/
+	bool prepareSources(std::string& _vertexCode, std::string& _fragmentCode) const;
+
+	/* Build stage 1: reads and preprocesses sources (see prepareSources).
+	*  \return False if sources can't be read.
+	*/
+	bool prepareBuild();
+
+	//Build stage 1 with sources read by prepareSources: '_success' is its result
+	void prepareBuild(std::string _vertexCode, std::string _fragmentCode, bool _success);
+
+	/* Build stage 2: loads program from cache or issues compiles and link without status checks.
+	*  Driver may compile in background (GL_KHR_parallel_shader_compile).
+	*/
+	void submitBuild();
+
+	//Checks without blocking that submitted build can be finished
+	bool isBuildComplete();
+
+	/* Build stage 3: checks status, reports errors and replaces program by built one.
+	*  If build failed previous program is kept.
+	*  \return Success of build.
+	*/
+	bool finishBuild();
+
+	//Drops build in flight
+	void cancelBuild();
+
+	//Checks that program is linked and can be used
+	bool isReady() const { return Program != 0; }
+
+	//Checks that build is started and not finished
+	bool isBuilding() const { return build.prepared || build.submitted || build.failed; }
+
+	//Sets program drawn instead of shaders without program ('nullptr' draws nothing special)
+	static void setPlaceholder(Shader* _placeholder) { placeholder = _placeholder; }
+
+	static Shader* getPlaceholder() { return placeholder; }
+
+	//Checks that driver compiles in background: GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile
+	static bool isParallelCompileSupported();
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+#ifndef SHADERCOMPILEQUEUE_H
+#define SHADERCOMPILEQUEUE_H "[0.0.5@CShaderCompileQueue.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of shader compile queue: sources are read
+*		and preprocessed by workers of JobSystem to job of queue and handed to shader
+*		on main thread, all compiles and links are issued at once and their status
+*		is polled later. With GL_KHR_parallel_shader_compile
+*		driver compiles in background and poll never blocks; without it status
+*		check waits for driver but still after all work is issued.
+*		Shader without finished program draws Shader::getPlaceholder() instead.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+//OUR
+#include "CShader.h"
+#include "general\cJobSystem.hpp"
+
+/* Queue of shader builds: add() from main thread, then poll() once per frame.
+*  Shader must be removed from queue before it is destroyed.
+*  Class definition: ShaderCompileQueue
+*/
+class ShaderCompileQueue {
+	//NO COPYCONSTRUCT
+	ShaderCompileQueue(const ShaderCompileQueue&) = delete;
+	ShaderCompileQueue& operator=(const ShaderCompileQueue&) = delete;
+
+	/* Sources of one shader read by worker: worker doesn't touch build of shader.
+	*  Struct definition: Job
+	*/
+	struct Job {
+		Shader* shader;
+		std::string vertexCode, fragmentCode;
+		bool success = false;
+		//Set by worker after sources are written: job can be handed to shader
+		std::atomic<bool> prepared;
+
+		Job(Shader* _shader) : shader(_shader), prepared(false) {}
+	};
+
+	JobSystem& jobs;
+	//Source preparation jobs in flight
+	JobSystem::Counter preparing;
+	//Shaders with sources prepared or being prepared: jobs don't move while workers write them
+	std::vector<std::unique_ptr<Job>> waiting;
+	//Shaders with submitted compiles and links
+	std::vector<Shader*> building;
+	//Count of finished builds that failed
+	unsigned int failed;
+	//Count of builds submitted by one poll, 0 is all
+	size_t budget;
+
+	std::vector<std::unique_ptr<Job>>::iterator findWaiting(Shader* _shader) {
+		return std::find_if(waiting.begin(), waiting.end(), [_shader](const std::unique_ptr<Job>& _job) { return _job->shader == _shader; });
+	}
+
+	//Waits for worker to finish '_job': calling thread runs other jobs meanwhile
+	void waitPrepared(Job& _job) {
+		while (!_job.prepared.load(std::memory_order_acquire))
+			if (!jobs.help())
+				std::this_thread::yield();
+	}
+
+	/* Hands sources to at most '_count' shaders which sources are read and issues their compiles and links.
+	*  Jobs which are still read by workers are kept for next call.
+	*/
+	void submit(size_t _count) {
+		size_t _kept = 0;
+		for (size_t _index = 0; _index < waiting.size(); _index++) {
+			Job& _job = *waiting[_index];
+			if (!_count || !_job.prepared.load(std::memory_order_acquire)) {
+				waiting[_kept++] = std::move(waiting[_index]);
+				continue;
+			}
+			_job.shader->prepareBuild(std::move(_job.vertexCode), std::move(_job.fragmentCode), _job.success);
+			_job.shader->submitBuild();
+			building.push_back(_job.shader);
+			_count--;
+		}
+		waiting.resize(_kept);
+	}
+public:
+	ShaderCompileQueue(JobSystem& _jobs = JobSystem::global()) : jobs(_jobs), failed(0), budget(0) {}
+
+	//Workers must not touch jobs after queue is gone: builds in flight are dropped
+	~ShaderCompileQueue() {
+		jobs.wait(preparing);
+		for (auto _shader : building)
+			_shader->cancelBuild();
+	}
+
+	//Starts build of '_shader': previous program is used until new one is ready
+	void add(Shader* _shader) {
+		if (!_shader || findWaiting(_shader) != waiting.end())
+			return;
+		remove(_shader);
+		std::unique_ptr<Job> _job(new Job(_shader));
+		Job* _sources = _job.get();
+		waiting.push_back(std::move(_job));
+		jobs.run([_sources]() {
+			_sources->success = _sources->shader->prepareSources(_sources->vertexCode, _sources->fragmentCode);
+			_sources->prepared.store(true, std::memory_order_release);
+		}, &preparing);
+	}
+
+	//Makes shader without program and starts its build: caller owns shader
+	Shader* create(std::string _vertexPath, std::string _fragmentPath, const ShaderDefines& _defines = ShaderDefines()) {
+		Shader* _shader = new Shader(std::move(_vertexPath), std::move(_fragmentPath), _defines, Shader::Deferred());
+		add(_shader);
+		return _shader;
+	}
+
+	//Drops build of '_shader' if it is queued
+	void remove(Shader* _shader) {
+		auto _job = findWaiting(_shader);
+		if (_job != waiting.end()) {
+			waitPrepared(**_job);
+			waiting.erase(_job);
+		}
+		auto _found = std::find(building.begin(), building.end(), _shader);
+		if (_found != building.end()) {
+			building.erase(_found);
+			_shader->cancelBuild();
+		}
+	}
+
+	/* Limits count of builds submitted by one poll.
+	*  Driver that compiles on calling thread (no background compile) spreads the work over frames.
+	*/
+	void setBudget(size_t _budget) { budget = _budget; }
+
+	//Waits for all sources and issues compiles and links of all shaders without status checks
+	void submit() {
+		jobs.wait(preparing);
+		submit(waiting.size());
+	}
+
+	/* Submits shaders which sources are read (within budget) and finishes completed builds.
+	*  Never waits for workers: shaders which sources are still read are submitted by later poll.
+	*  \return Count of shaders that are still in queue.
+	*/
+	size_t poll() {
+		submit(budget ? budget : waiting.size());
+		size_t _kept = 0;
+		for (auto _shader : building) {
+			if (_shader->isBuildComplete()) {
+				if (!_shader->finishBuild())
+					failed++;
+			} else {
+				building[_kept++] = _shader;
+			}
+		}
+		building.resize(_kept);
+		return size();
+	}
+
+	//Finishes all builds: waits for driver
+	void finish() {
+		submit();
+		for (auto _shader : building)
+			if (!_shader->finishBuild())
+				failed++;
+		building.clear();
+	}
+
+	//Count of shaders in queue
+	size_t size() const { return waiting.size() + building.size(); }
+
+	//Count of failed builds
+	unsigned int getFailed() const { return failed; }
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#ifndef SHADERPREPROCESSOR_H
+#define SHADERPREPROCESSOR_H "[0.0.5@CShaderPreprocessor.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of GLSL preprocessing stage of Shader:
+*		#include "file" is replaced by file content (path relative to including file),
+*		define set is injected after #version.
+*		Conditionals aren't evaluated here: every #include is expanded, so file that
+*		can be included more than once must have its own #ifndef guard. Include of file
+*		that is being expanded is skipped (guarded file is empty there).
+*		#line directives keep line numbers of compiler messages: source string number
+*		is index of file in order of first inclusion, 0 is main file.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+//OUR
+#include "general/cVirtualFileSystem.hpp"
+//DEBUG
+#ifdef DEBUG_SHADERPREPROCESSOR
+	#ifndef DEBUG_OUT
+		#define DEBUG_OUT std::cout
+	#endif
+	#ifndef DEBUG_NEXT_LINE
+		#define DEBUG_NEXT_LINE std::endl
+	#endif
+#endif
+
+#ifndef SHADER_PREPROCESSOR_MAX_INCLUDE_DEPTH
+	//Maximal depth of nested includes
+	#define SHADER_PREPROCESSOR_MAX_INCLUDE_DEPTH 16
+#endif
+
+//Define set of shader variant: name -> value (empty value defines name only)
+typedef std::map<std::string, std::string> ShaderDefines;
+
+/* GLSL preprocessing stage: #include resolution and define injection.
+*  Class definition: ShaderPreprocessor
+*/
+class ShaderPreprocessor {
+	const VirtualFileSystem& fileSystem;
+	//Files in order of first inclusion
+	std::vector<std::string> files;
+	//Files that are being expanded: outer first
+	std::vector<std::string> including;
+	//Define block is written after #version of main file
+	bool injected;
+
+	//Directory part of '_path' with trailing '/'
+	static std::string directory(const std::string& _path) {
+		size_t _slash = _path.find_last_of('/');
+		return _slash == std::string::npos ? std::string() : _path.substr(0, _slash + 1);
+	}
+
+	//Parses '#include "name"' or '#include <name>' line: returns false for other lines
+	static bool parseInclude(const std::string& _line, std::string& _name) {
+		size_t _index = _line.find_first_not_of(" \t");
+		if (_index == std::string::npos || _line[_index] != '#')
+			return false;
+		_index = _line.find_first_not_of(" \t", _index + 1);
+		if (_index == std::string::npos || _line.compare(_index, 7, "include"))
+			return false;
+		_index = _line.find_first_not_of(" \t", _index + 7);
+		if (_index == std::string::npos || (_line[_index] != '"' && _line[_index] != '<'))
+			return false;
+		size_t _end = _line.find(_line[_index] == '"' ? '"' : '>', _index + 1);
+		if (_end == std::string::npos)
+			return false;
+		_name = _line.substr(_index + 1, _end - _index - 1);
+		return true;
+	}
+
+	static bool isVersion(const std::string& _line) {
+		size_t _index = _line.find_first_not_of(" \t");
+		if (_index == std::string::npos || _line[_index] != '#')
+			return false;
+		_index = _line.find_first_not_of(" \t", _index + 1);
+		return _index != std::string::npos && !_line.compare(_index, 7, "version");
+	}
+
+	bool expand(const std::string& _path, const std::string& _defines, int _depth, std::string& _out) {
+		if (_depth > SHADER_PREPROCESSOR_MAX_INCLUDE_DEPTH) {
+			#ifdef DEBUG_SHADERPREPROCESSOR
+				DEBUG_OUT << "ERROR::SHADER_PREPROCESSOR::expand::INCLUDE_TOO_DEEP" << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tPath: " << _path << DEBUG_NEXT_LINE;
+			#endif
+			return false;
+		}
+		std::string _text;
+		if (!fileSystem.readText(_path, _text)) {
+			#ifdef DEBUG_SHADERPREPROCESSOR
+				DEBUG_OUT << "ERROR::SHADER_PREPROCESSOR::expand::FILE_NOT_SUCCESFULLY_READ" << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tPath: " << _path << DEBUG_NEXT_LINE;
+			#endif
+			return false;
+		}
+		size_t _source = std::find(files.begin(), files.end(), _path) - files.begin();
+		if (_source == files.size())
+			files.push_back(_path);
+		including.push_back(_path);
+		if (_source)
+			_out += "#line 1 " + std::to_string(_source) + '\n';
+		std::string _base = directory(_path), _line, _name;
+		size_t _begin = 0, _number = 0;
+		while (_begin < _text.size()) {
+			size_t _end = _text.find('\n', _begin);
+			if (_end == std::string::npos)
+				_end = _text.size();
+			_line.assign(_text, _begin, _end - _begin);
+			if (!_line.empty() && _line.back() == '\r')
+				_line.pop_back();
+			_begin = _end + 1;
+			_number++;
+			if (parseInclude(_line, _name)) {
+				std::string _included = VirtualFileSystem::normalize(_base + _name);
+				if (std::find(including.begin(), including.end(), _included) == including.end()) {
+					if (!expand(_included, std::string(), _depth + 1, _out))
+						return false;
+					_out += "#line " + std::to_string(_number + 1) + ' ' + std::to_string(_source) + '\n';
+				} else {
+					//Recursive include: empty line keeps numbering
+					_out += '\n';
+				}
+				continue;
+			}
+			_out += _line;
+			_out += '\n';
+			if (!_defines.empty() && !injected && isVersion(_line)) {
+				injected = true;
+				_out += _defines;
+				_out += "#line " + std::to_string(_number + 1) + ' ' + std::to_string(_source) + '\n';
+			}
+		}
+		including.pop_back();
+		return true;
+	}
+public:
+	ShaderPreprocessor(const VirtualFileSystem& _fileSystem = VirtualFileSystem::global()) : fileSystem(_fileSystem), injected(false) {}
+
+	/* Define set as block of #define lines: same set gives same text.
+	*  Used as define part of program cache key.
+	*/
+	static std::string definesText(const ShaderDefines& _defines) {
+		std::string _text;
+		for (auto &_define : _defines) {
+			_text += "#define " + _define.first;
+			if (!_define.second.empty())
+				_text += ' ' + _define.second;
+			_text += '\n';
+		}
+		return _text;
+	}
+
+	/* Reads '_path' and included files to '_out', '_defines' block (see definesText)
+	*  is injected after #version line or at beginning of source without it.
+	*  \return False if any file can't be read or includes are nested too deep.
+	*/
+	bool load(const std::string& _path, const std::string& _defines, std::string& _out) {
+		files.clear();
+		including.clear();
+		injected = false;
+		_out.clear();
+		if (!expand(VirtualFileSystem::normalize(_path), _defines, 0, _out))
+			return false;
+		if (!_defines.empty() && !injected)
+			_out = _defines + "#line 1 0\n" + _out;
+		return true;
+	}
+
+	//Files read by last load: index is source string number of #line
+	const std::vector<std::string>& getFiles() const { return files; }
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef SHADERVARIANTS_H
+#define SHADERVARIANTS_H "[0.0.5@CShaderVariants.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of shader permutation set: one program
+*		per define set of same vertex/fragment sources, built on first request.
+*		Renderer picks variant specialized for its case (light count, features)
+*		instead of one program that pays for the worst case.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <memory>
+#include <string>
+//OUR
+#include "CShader.h"
+#include "CShaderPreprocessor.h"
+
+/* Set of programs built from one pair of sources with different define sets.
+*  Variants are owned by set: pointers are valid until set is destroyed.
+*  Class definition: ShaderVariants
+*/
+class ShaderVariants {
+	//NO COPYCONSTRUCT
+	ShaderVariants(const ShaderVariants&) = delete;
+	ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+	std::string vpath, fpath;
+	//Programs by define block
+	std::map<std::string, std::unique_ptr<Shader>> variants;
+public:
+	ShaderVariants(std::string vertexPath, std::string fragmentPath) :	vpath(std::move(vertexPath)),
+																		fpath(std::move(fragmentPath)) {}
+
+	//Returns variant of '_defines': it is built by first call
+	Shader* get(const ShaderDefines& _defines = ShaderDefines()) {
+		std::string _key = ShaderPreprocessor::definesText(_defines);
+		auto _found = variants.find(_key);
+		if (_found != variants.end())
+			return _found->second.get();
+		std::unique_ptr<Shader> _variant(new Shader(vpath, fpath, _defines));
+		Shader* _result = _variant.get();
+		variants.emplace(std::move(_key), std::move(_variant));
+		return _result;
+	}
+
+	//Checks that variant of '_defines' is built
+	bool isBuilt(const ShaderDefines& _defines) const { return variants.count(ShaderPreprocessor::definesText(_defines)) != 0; }
+
+	//Count of built variants
+	size_t size() const { return variants.size(); }
+
+	//Reloads all built variants from disk
+	void Reload() {
+		for (auto &_variant : variants)
+			_variant.second->Reload();
+	}
+
+	//Destroys all built variants
+	void clear() { variants.clear(); }
+};
+#endif
\ No newline at end of file
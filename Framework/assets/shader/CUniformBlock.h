@@ -0,0 +1,232 @@
+#ifndef UNIFORMBLOCK_H
+#define UNIFORMBLOCK_H "[0.0.5@CUniformBlock.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of uniform buffer objects with std140 layout:
+*		data shared by many programs is written once and uploaded by one glBufferSubData.
+*		Block is bound to fixed binding point, program connects its block of same name
+*		to that point once after link (Shader::bindBlock).
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <string>
+#include <vector>
+#include <cstring>
+//GLEW
+#include <GL/glew.h>
+//OUR
+#include "CShader.h"
+//DEBUG
+#ifdef DEBUG_UNIFORMBLOCK
+	#ifndef DEBUG_OUT
+		#define DEBUG_OUT std::cout
+	#endif
+	#ifndef DEBUG_NEXT_LINE
+		#define DEBUG_NEXT_LINE std::endl
+	#endif
+#endif
+
+#ifndef UNIFORM_BLOCK_CAMERA_BINDING
+	//Binding point of camera block: projection, view and position of viewer
+	#define UNIFORM_BLOCK_CAMERA_BINDING 0
+#endif
+
+#ifndef UNIFORM_BLOCK_LIGHTS_BINDING
+	//Binding point of lightsources block
+	#define UNIFORM_BLOCK_LIGHTS_BINDING 1
+#endif
+
+#ifndef UNIFORM_BLOCK_MATERIAL_BINDING
+	//Binding point of material block
+	#define UNIFORM_BLOCK_MATERIAL_BINDING 2
+#endif
+
+/* Writes values to buffer by std140 rules:
+*  scalars are aligned to 4 bytes, vec3 and vec4 to 16 bytes,
+*  matrix is four vec4 columns, struct and array element start and end at 16 bytes.
+*  Buffer is changed only where written value differs: unchanged block isn't uploaded.
+*  Values are written in order, so offset after last write is size of block:
+*  bytes left from longer previous write are kept for comparison but aren't part of block.
+*  Class definition: Std140Writer
+*/
+class Std140Writer {
+	std::vector<unsigned char> data;
+	//End of last written value: size of block since reset
+	size_t offset;
+	bool changed;
+
+	void align(size_t _alignment) {
+		size_t _aligned = (offset + _alignment - 1) / _alignment * _alignment;
+		if (_aligned > data.size()) {
+			data.resize(_aligned, 0);
+			changed = true;
+		}
+		offset = _aligned;
+	}
+
+	void put(const void* _value, size_t _size, size_t _alignment) {
+		align(_alignment);
+		if (offset + _size > data.size()) {
+			data.resize(offset + _size, 0);
+			changed = true;
+		}
+		if (std::memcmp(data.data() + offset, _value, _size)) {
+			std::memcpy(data.data() + offset, _value, _size);
+			changed = true;
+		}
+		offset += _size;
+	}
+public:
+	Std140Writer() : offset(0), changed(true) {}
+
+	//Starts new write of block from its beginning
+	void reset() { offset = 0; }
+
+	//Float value
+	void number(GLfloat _value) { put(&_value, sizeof(GLfloat), 4); }
+
+	//Integer value
+	void integer(GLint _value) { put(&_value, sizeof(GLint), 4); }
+
+	//Vector of three floats: next scalar is placed in its padding
+	template < class TVector3 >
+	void vec3(const TVector3& _value) {
+		GLfloat _buffer[3] = { _value.x, _value.y, _value.z };
+		put(_buffer, sizeof(_buffer), 16);
+	}
+
+	//Vector of four floats
+	template < class TVector4 >
+	void vec4(const TVector4& _value) {
+		GLfloat _buffer[4] = { _value.x, _value.y, _value.z, _value.w };
+		put(_buffer, sizeof(_buffer), 16);
+	}
+
+	//Column-major matrix 4x4 from 16 floats
+	void mat4(const GLfloat* _columns) { put(_columns, sizeof(GLfloat) * 16, 16); }
+
+	//Starts struct or element of array of structs
+	void beginStruct() { align(16); }
+
+	//Ends struct or element of array of structs: size is rounded up to 16 bytes
+	void endStruct() { align(16); }
+
+	//Written bytes
+	const unsigned char* getData() const { return data.data(); }
+
+	//Size of block written since reset
+	size_t size() const { return offset; }
+
+	//Checks that data is changed since last call of clearChanged
+	bool isChanged() const { return changed; }
+
+	void clearChanged() { changed = false; }
+};
+
+/* Uniform buffer object of one uniform block, shared by all programs.
+*  Frame usage: writer().reset(), write all members in declaration order, upload().
+*  Class definition: UniformBlock
+*/
+class UniformBlock {
+	//NO COPYCONSTRUCT
+	UniformBlock(const UniformBlock&) = delete;
+	UniformBlock& operator=(const UniformBlock&) = delete;
+
+	std::string name;
+	GLuint binding;
+	GLuint buffer;
+	//Size of buffer storage
+	size_t capacity;
+	Std140Writer data;
+	//Count of glBufferSubData/glBufferData calls
+	unsigned int uploads;
+public:
+	UniformBlock(std::string _name, GLuint _binding) :	name(std::move(_name)), binding(_binding),
+														buffer(0), capacity(0), uploads(0) {}
+
+	~UniformBlock() {
+		if (buffer)
+			GLStateCache::global().deleteBuffer(buffer);
+	}
+
+	//Writer of block data
+	Std140Writer& writer() { return data; }
+
+	/* Uploads written data if it is changed: buffer storage is made by first upload
+	*  and remade only if block grows.
+	*/
+	void upload() {
+		if (!data.size() || (!data.isChanged() && data.size() <= capacity))
+			return;
+		if (!buffer)
+			glGenBuffers(1, &buffer);
+		GLStateCache& _state = GLStateCache::global();
+		_state.bindBuffer(GL_UNIFORM_BUFFER, buffer);
+		if (data.size() > capacity) {
+			glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)data.size(), data.getData(), GL_DYNAMIC_DRAW);
+			capacity = data.size();
+			_state.bindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+		} else {
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)data.size(), data.getData());
+		}
+		data.clearChanged();
+		uploads++;
+	}
+
+	//Connects block of same name in '_shader' to binding point of this block
+	void attach(Shader* _shader) {
+		if (_shader) {
+			_shader->bindBlock(name, binding);
+		} else {
+			#ifdef DEBUG_UNIFORMBLOCK
+				DEBUG_OUT << "WARNING::UNIFORM_BLOCK::attach::SHADER_NOT_PROVIDED" << DEBUG_NEXT_LINE;
+			#endif
+		}
+	}
+
+	//Rebinds buffer to binding point: needed only if binding point is used by other buffer
+	void bind() {
+		if (buffer)
+			GLStateCache::global().bindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+	}
+
+	const std::string& getName() const { return name; }
+
+	GLuint getBinding() const { return binding; }
+
+	GLuint getBufferId() const { return buffer; }
+
+	//Count of uploads made
+	unsigned int getUploads() const { return uploads; }
+};
+
+#ifdef EXAMPLE_SHADERS
+	const std::string UniformBlockShaderExample(R"**(
+		#version 330 core
+		struct PointLight {
+			vec4 position;
+			vec3 ambient;
+			vec3 diffuse;
+			vec3 specular;
+			float constant;
+			float linear;
+			float quadratic;
+		};
+
+		//UNIFORM_BLOCK_CAMERA_BINDING: SimpleCamera::writeStd140
+		layout(std140) uniform Camera {
+			mat4 projection;
+			mat4 view;
+			vec4 viewPos;
+		};
+
+		//UNIFORM_BLOCK_LIGHTS_BINDING: PointLightPOD::writeStd140 of each light
+		layout(std140) uniform Lights {
+			PointLight pointLights[4];
+		};
+	)**");
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef UNIFORMNAME_H
+#define UNIFORMNAME_H "[0.0.5@CUniformName.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of uniform name identities: name is
+*		represented by 64-bit FNV-1a hash of its characters. Hash of literal is
+*		computed at compile time by uniformNameId("name") where compiler supports
+*		constexpr (UNIFORM_NAME_ID also remembers its name). Hash is continued by
+*		appended characters, so identity of "light[2].position" is made from
+*		identity of "light" without new string (UniformNames::element, append).
+*		Global table keeps name of every identity for messages and checks collisions:
+*		joined name is built once, when its identity is met first time.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+//OUR
+#include "general\vs2013tweaks.h"
+//DEBUG
+#ifdef DEBUG_UNIFORMNAME
+	#include <iostream>
+	#include <cassert>
+	#ifndef DEBUG_OUT
+		#define DEBUG_OUT std::cout
+	#endif
+	#ifndef DEBUG_NEXT_LINE
+		#define DEBUG_NEXT_LINE std::endl
+	#endif
+#endif
+
+//Identity of uniform name: FNV-1a hash of its characters
+typedef uint64_t UniformNameId;
+
+#define UNIFORM_NAME_ID_BASIS 14695981039346656037ull
+#define UNIFORM_NAME_ID_PRIME 1099511628211ull
+
+//Identity of '_name' (hash continued from '_id'): same value as UniformNames::hash, constant expression for literals
+inline CONST_OR_CONSTEXPR UniformNameId uniformNameId(const char* _name, UniformNameId _id = UNIFORM_NAME_ID_BASIS) {
+	return *_name ? uniformNameId(_name + 1, (_id ^ (unsigned char)*_name) * UNIFORM_NAME_ID_PRIME) : _id;
+}
+
+//Identity of literal '_name' computed at compile time, name is remembered by table for messages
+#ifdef HAS_CONSTEXPR
+	static_assert(uniformNameId("a") == 0xaf63dc4c8601ec8cull, "uniformNameId must be 64-bit FNV-1a");
+	#define UNIFORM_NAME_ID(_name) UniformNames::intern(std::integral_constant<UniformNameId, uniformNameId(_name)>::value, _name)
+#else
+	#define UNIFORM_NAME_ID(_name) UniformNames::intern(uniformNameId(_name), _name)
+#endif
+
+/* Global table of uniform names by their identities.
+*  Used from thread that owns OpenGL context.
+*  Class definition: UniformNames
+*/
+class UniformNames {
+	std::unordered_map<UniformNameId, std::string> names;
+
+	static UniformNames& global() {
+		static UniformNames _table;
+		return _table;
+	}
+public:
+	//Identity of '_size' characters of '_data' continued from '_id'
+	static UniformNameId hash(const char* _data, size_t _size, UniformNameId _id = UNIFORM_NAME_ID_BASIS) {
+		for (size_t _index = 0; _index < _size; _index++) {
+			_id ^= (unsigned char)_data[_index];
+			_id *= UNIFORM_NAME_ID_PRIME;
+		}
+		return _id;
+	}
+
+	static UniformNameId hash(const std::string& _name) { return hash(_name.data(), _name.size()); }
+
+	//Identity of '_name' that is remembered by table: known name isn't copied
+	static UniformNameId intern(const std::string& _name) {
+		UniformNameId _id = hash(_name);
+		auto& _names = global().names;
+		auto _found = _names.find(_id);
+		if (_found == _names.end()) {
+			_names.emplace(_id, _name);
+		} else if (_found->second != _name) {
+			#ifdef DEBUG_UNIFORMNAME
+				DEBUG_OUT << "ERROR::UNIFORM_NAMES::intern::HASH_COLLISION" << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tName: " << _name << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tInterned: " << _found->second << DEBUG_NEXT_LINE;
+				assert(!"UniformNames::intern: hash collision");
+			#endif
+		}
+		return _id;
+	}
+
+	static UniformNameId intern(const char* _name) { return intern(std::string(_name)); }
+
+	//Remembers '_name' of precomputed identity '_id' (see UNIFORM_NAME_ID): known name isn't hashed or copied
+	static UniformNameId intern(UniformNameId _id, const char* _name) {
+		auto& _names = global().names;
+		auto _found = _names.find(_id);
+		if (_found == _names.end()) {
+			_names.emplace(_id, std::string(_name));
+		}
+		#ifdef DEBUG_UNIFORMNAME
+			else if (_found->second != _name) {
+				DEBUG_OUT << "ERROR::UNIFORM_NAMES::intern::HASH_COLLISION" << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tName: " << _name << DEBUG_NEXT_LINE;
+				DEBUG_OUT << "\tInterned: " << _found->second << DEBUG_NEXT_LINE;
+				assert(!"UniformNames::intern: hash collision");
+			}
+			assert(_id == hash(_name, std::strlen(_name)));
+		#endif
+		return _id;
+	}
+
+	/* Identity of name of '_id' followed by '_size' characters of '_suffix'.
+	*  Joined name is remembered if name of '_id' is interned: string is built only for new identity.
+	*/
+	static UniformNameId append(UniformNameId _id, const char* _suffix, size_t _size) {
+		UniformNameId _result = hash(_suffix, _size, _id);
+		auto& _names = global().names;
+		auto _found = _names.find(_result);
+		if (_found == _names.end()) {
+			auto _base = _names.find(_id);
+			if (_base != _names.end()) {
+				std::string _name(_base->second);
+				_name.append(_suffix, _size);
+				_names.emplace(_result, std::move(_name));
+			}
+		}
+		#ifdef DEBUG_UNIFORMNAME
+			else {
+				//Joined name is built only to check collision
+				auto _base = _names.find(_id);
+				if (_base != _names.end() && _found->second != _base->second + std::string(_suffix, _size)) {
+					DEBUG_OUT << "ERROR::UNIFORM_NAMES::append::HASH_COLLISION" << DEBUG_NEXT_LINE;
+					DEBUG_OUT << "\tName: " << _base->second << std::string(_suffix, _size) << DEBUG_NEXT_LINE;
+					DEBUG_OUT << "\tInterned: " << _found->second << DEBUG_NEXT_LINE;
+					assert(!"UniformNames::append: hash collision");
+				}
+			}
+		#endif
+		return _result;
+	}
+
+	static UniformNameId append(UniformNameId _id, const char* _suffix) { return append(_id, _suffix, std::strlen(_suffix)); }
+
+	//Identity of element '_index' of array named by '_id': "name[_index]"
+	static UniformNameId element(UniformNameId _id, int _index) {
+		char _suffix[16];
+		int _size = std::snprintf(_suffix, sizeof(_suffix), "[%d]", _index);
+		return append(_id, _suffix, (size_t)_size);
+	}
+
+	//Name of '_id' or empty string if it isn't interned
+	static const std::string& name(UniformNameId _id) {
+		static const std::string _unknown;
+		auto _found = global().names.find(_id);
+		return _found != global().names.end() ? _found->second : _unknown;
+	}
+
+	//Count of interned names
+	static size_t size() { return global().names.size(); }
+};
+#endif
\ No newline at end of file
@@ -102,10 +102,13 @@ struct StructContainerBase {
 
 	virtual void operator() (std::string _structName) { return; }
 
+	//Names members as members of struct identified by '_structId': member names aren't built
+	virtual void setMemberNames(UniformNameId _structId) { return; }
+
 	//Sets current struct as separate value
 	void asValue() {
 		index = -1;
-		this->operator()(structName);
+		setMemberNames(UniformNames::intern(structName));
 	}
 
 	//Sets current struct as member of in-shader array of struct at position "_index"
@@ -114,9 +117,7 @@ struct StructContainerBase {
 			asValue();
 		} else {
 			index = _index;
-			std::string _buff(structName);
-			this->operator()(structName + "[" + std::to_string(_index) + "]");
-			structName = std::move(_buff);
+			setMemberNames(UniformNames::element(UniformNames::intern(structName), _index));
 		}
 	}
 
@@ -13,6 +13,8 @@
 #include <type_traits>
 //GLEW
 #include <GL/glew.h>
+//OUR
+#include "CUniformName.h"
 //DEBUG
 #ifdef DEBUG_UNIFORMS
 	#ifndef DEBUG_OUT
@@ -39,25 +41,29 @@ class UniformBase {
 protected:
 	TShader *shader;
 	std::string uniformName;
+	//Interned identity of uniformName: used by shader instead of string
+	UniformNameId uniformId;
 public:
 	//Type of handeled shader
 	typedef TShader ShaderType;
 
-	UniformBase() : shader(nullptr), uniformName(UNIFORM_STD_SHADER_VARIABLE_NAME) {}
+	UniformBase() : shader(nullptr), uniformName(UNIFORM_STD_SHADER_VARIABLE_NAME), uniformId(UniformNames::intern(uniformName)) {}
 
 	UniformBase(TShader *_shader,
 				std::string _uniformName = std::string(UNIFORM_STD_SHADER_VARIABLE_NAME)) :
-				shader(_shader), uniformName(std::move(_uniformName)) {}
+				shader(_shader), uniformName(std::move(_uniformName)), uniformId(UniformNames::intern(uniformName)) {}
 
 	UniformBase(TShader *_shader,
 				const char* _uniformName = UNIFORM_STD_SHADER_VARIABLE_NAME) : 
-				shader(_shader), uniformName(_uniformName) {}
+				shader(_shader), uniformName(_uniformName), uniformId(UniformNames::intern(uniformName)) {}
 
 	UniformBase(const UniformBase &other) : shader(other.shader),
-											uniformName(other.uniformName) {}
+											uniformName(other.uniformName),
+											uniformId(other.uniformId) {}
 
 	UniformBase(UniformBase &&other) : 	shader(std::move(other.shader)),
-										uniformName(std::move(other.uniformName)) { other.shader = nullptr; }
+										uniformName(std::move(other.uniformName)),
+										uniformId(other.uniformId) { other.shader = nullptr; }
 
 	~UniformBase() { /*Protect shader from destructor call*/ shader = nullptr; }
 
@@ -67,6 +73,7 @@ public:
 			return *this;
 		std::swap(shader, other.shader);
 		std::swap(uniformName, other.uniformName);
+		std::swap(uniformId, other.uniformId);
 		return *this;
 	}
 
@@ -74,6 +81,7 @@ public:
 		shader = nullptr;
 		shader = std::move(other.shader);
 		uniformName = std::move(other.uniformName);
+		uniformId = other.uniformId;
 		return *this;
 	}
 
@@ -81,13 +89,28 @@ public:
 	virtual void setShader(TShader *_shader) { shader = _shader; }
 
 	//Set new in-shader name of variable
-	virtual void setName(const char* newName) { uniformName = std::move(std::string(newName)); }
+	virtual void setName(const char* newName) {
+		uniformName = std::move(std::string(newName));
+		uniformId = UniformNames::intern(uniformName);
+	}
 
 	//Set new in-shader name of variable
-	virtual void setName(std::string newName) { uniformName = std::move(newName); }
+	virtual void setName(std::string newName) {
+		uniformName = std::move(newName);
+		uniformId = UniformNames::intern(uniformName);
+	}
+
+	//Set new in-shader name of variable by its identity (UniformNames::append, element)
+	virtual void setName(UniformNameId newId) {
+		uniformId = newId;
+		uniformName = UniformNames::name(newId);
+	}
 
 	//Get in-shader name of variable
 	virtual std::string getName() { return uniformName.substr(); }
+
+	//Get identity of in-shader name of variable
+	UniformNameId getNameId() const { return uniformId; }
 };
 
 /* Common storage class for future UniformAutomaticStorage and UniformManualStorage
@@ -103,25 +126,29 @@ protected:
 	static_assert(	std::is_copy_constructible<T>::value,
 					"ASSERTION_ERROR::UniformStorage::Provided class 'T' must be copy-constuctible.");
 	T value;
+	//Changed on every change of value
+	unsigned int version;
 public:
 	//Type of handled value
 	typedef T ValueType;
 	//Type of pointer to handled value
 	typedef T* ValueTypePtr;
+	//Value is owned: version is changed by setValue only
+	static const bool OBSERVER = false;
 
-	UniformStorage() : UniformBase(), value() {}
+	UniformStorage() : UniformBase(), value(), version(0) {}
 
 	UniformStorage(	T *_value, TShader *_shader = nullptr,
 					std::string _uniformName = std::string(UNIFORM_STD_SHADER_VARIABLE_NAME)) :
-					UniformBase(_shader, _uniformName), value(std::move(*_value)) {}
+					UniformBase(_shader, _uniformName), value(std::move(*_value)), version(0) {}
 
 	UniformStorage(	T *_value, TShader *_shader = nullptr,
 					const char* _uniformName = UNIFORM_STD_SHADER_VARIABLE_NAME) : 
-					UniformBase(_shader, _uniformName), value(std::move(*_value)) {}
+					UniformBase(_shader, _uniformName), value(std::move(*_value)), version(0) {}
 
-	UniformStorage(const UniformStorage &other) : UniformBase(other), value(other.value) {}
+	UniformStorage(const UniformStorage &other) : UniformBase(other), value(other.value), version(0) {}
 
-	UniformStorage(UniformStorage &&other) : UniformBase(std::move(other)), value(std::move(other.value)) {}
+	UniformStorage(UniformStorage &&other) : UniformBase(std::move(other)), value(std::move(other.value)), version(0) {}
 
 	~UniformStorage() {}
 
@@ -132,6 +159,7 @@ public:
 		UniformBase::operator=(other);
 		//Trigger copy-assign of value type
 		value = other.value;
+		version++;
 		return *this;
 	}
 
@@ -139,6 +167,7 @@ public:
 		UniformBase::operator=(std::move(other));
 		//Trigger move-assign of value type
 		value = std::move(other.value);
+		version++;
 		return *this;
 	}
 
@@ -146,7 +175,16 @@ public:
 	virtual T getValue() { return value; }
 
 	//Set new value to handle
-	virtual void setValue(T _value) { value = std::move(_value); }
+	virtual void setValue(T _value) {
+		value = std::move(_value);
+		version++;
+	}
+
+	//Counter of value changes
+	const unsigned int* getVersionPtr() const { return &version; }
+
+	//Value can't be changed unnoticed: nothing to check
+	void refresh() {}
 };
 
 /* Common observer class for future UniformAutomaticObserver and UniformManualObserver
@@ -156,25 +194,31 @@ template < class T, class TShader = Shader >
 class UniformObserver : public UniformBase<TShader> {
 protected:
 	const T* valueptr;
+	//Copy of observed value made by last refresh
+	T snapshot;
+	//Changed on every noticed change of observed value
+	unsigned int version;
 public:
 	//Type of handled value
 	typedef T ValueType;
 	//Type of pointer to handled value
 	typedef T* ValueTypePtr;
+	//Value is changed outside: refresh must be called before version is read
+	static const bool OBSERVER = true;
 
-	UniformObserver() : UniformBase(), valueptr(nullptr) {}
+	UniformObserver() : UniformBase(), valueptr(nullptr), snapshot(), version(0) {}
 
 	UniformObserver(T* _valueptr, TShader *_shader = nullptr,
 					std::string _uniformName = std::string(UNIFORM_STD_SHADER_VARIABLE_NAME)) :
-					UniformBase(_shader, _uniformName), valueptr(_valueptr) {}
+					UniformBase(_shader, _uniformName), valueptr(_valueptr), snapshot(), version(0) {}
 
 	UniformObserver(T* _valueptr, TShader *_shader = nullptr,
 					const char* _uniformName = UNIFORM_STD_SHADER_VARIABLE_NAME) :
-					UniformBase(_shader, _uniformName), valueptr(_valueptr) {}
+					UniformBase(_shader, _uniformName), valueptr(_valueptr), snapshot(), version(0) {}
 
-	UniformObserver(const UniformObserver &other) : UniformBase(other), valueptr(other.valueptr) {}
+	UniformObserver(const UniformObserver &other) : UniformBase(other), valueptr(other.valueptr), snapshot(), version(0) {}
 
-	UniformObserver(UniformObserver &&other) : UniformBase(std::move(other)), valueptr(std::move(other.valueptr)) {}
+	UniformObserver(UniformObserver &&other) : UniformBase(std::move(other)), valueptr(std::move(other.valueptr)), snapshot(), version(0) {}
 
 	~UniformObserver() { /*Protect value from destructor call*/ valueptr = nullptr; }
 
@@ -184,6 +228,7 @@ public:
 			return *this;
 		UniformBase::operator=(other);
 		std::swap(valueptr, other.valueptr);
+		version++;
 		return *this;
 	}
 
@@ -191,6 +236,7 @@ public:
 		UniformBase::operator=(std::move(other));
 		valueptr = nullptr;
 		valueptr = std::move(other.valueptr);
+		version++;
 		return *this;
 	}
 
@@ -198,7 +244,21 @@ public:
 	virtual const T* getValue() { return valueptr; }
 
 	//Set new value to observe
-	virtual void setValue(T* _valueptr) { valueptr = std::move(_valueptr); }
+	virtual void setValue(T* _valueptr) {
+		valueptr = std::move(_valueptr);
+		version++;
+	}
+
+	//Counter of noticed value changes
+	const unsigned int* getVersionPtr() const { return &version; }
+
+	//Compares observed value with copy made by last call: one comparison, no OpenGL calls
+	void refresh() {
+		if (valueptr && !(snapshot == *valueptr)) {
+			snapshot = *valueptr;
+			version++;
+		}
+	}
 };
 
 /* Common interface for all automatic Uniform handlers.
@@ -212,6 +272,14 @@ public:
 	virtual void push() = 0;
 	//Pull uniform from shader queue
 	virtual void pull() = 0;
+	/* Counter that is changed with value: while it is the same bindUniform may be skipped.
+	*  nullptr if uniform must be bound on every use.
+	*/
+	virtual const unsigned int* getVersion() { return nullptr; }
+	//Checks that value is changed outside of handler: refresh must be called before version is compared
+	virtual bool isObserver() { return false; }
+	//Updates version of value changed outside of handler
+	virtual void refresh() {}
 
 	virtual ~UniformAutomaticInteface() {};
 };
@@ -220,15 +288,15 @@ public:
 *  Class template definition: UniformAutomatic
 */
 template <	template<class, class> class TBase, class T, class TShader = Shader,
-			void (TShader::* NewUniform)(std::string&, UniformAutomaticInteface*) = &TShader::newUniform,
-			void (TShader::* DeleteUniform)(std::string&) = &TShader::deleteUniform >
+			void (TShader::* NewUniform)(UniformNameId, UniformAutomaticInteface*) = &TShader::newUniform,
+			void (TShader::* DeleteUniform)(UniformNameId) = &TShader::deleteUniform >
 class UniformAutomatic : public UniformAutomaticInteface, public TBase<T, TShader> {
 	typedef TBase<T, TShader> Base;
 public:
 	//Push to shader uniform handle queue of current saved shader
 	virtual void push() {
 		if (shader) {
-			(shader->*NewUniform)(uniformName, this);
+			(shader->*NewUniform)(uniformId, this);
 		} else {
 			#ifdef DEBUG_UNIFORMS
 				#ifdef WARNINGS_UNIFORMS
@@ -241,7 +309,7 @@ public:
 	//Push to uniform handle queue of shader defined by pointer
 	virtual void push(TShader *_shader) {
 		if (_shader) {
-			(_shader->*NewUniform)(uniformName, this);
+			(_shader->*NewUniform)(uniformId, this);
 		} else {
 			#ifdef DEBUG_UNIFORMS
 				#ifdef WARNINGS_UNIFORMS
@@ -251,10 +319,16 @@ public:
 		}
 	}
 
+	virtual const unsigned int* getVersion() { return Base::getVersionPtr(); }
+
+	virtual bool isObserver() { return Base::OBSERVER; }
+
+	virtual void refresh() { Base::refresh(); }
+
 	//Pull from shader uniform handle queue of current saved shader
 	virtual void pull() {
 		if (shader) {
-			(shader->*DeleteUniform)(uniformName);
+			(shader->*DeleteUniform)(uniformId);
 		} else {
 			#ifdef DEBUG_UNIFORMS
 				#ifdef WARNINGS_UNIFORMS
@@ -308,6 +382,14 @@ public:
 		Base::setName(std::move(_newName));
 		push();
 	}
+
+	//Set new in-shader name of variable by its identity
+	virtual void setName(UniformNameId _newId) {
+		if (shader)
+			pull();
+		Base::setName(_newId);
+		push();
+	}
 };
 
 /* The automatic storage for uniform in-shader value.
@@ -11,10 +11,17 @@
 //STD
 #include <string>
 #include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
 //GLEW
 #include <GL/glew.h>
 //SOIL
 #include <SOIL/SOIL.h>
+//OUR
+#include "general\cVirtualFileSystem.hpp"
+#include "general\cTextureFile.hpp"
+#include "ogl\CGLStateCache.h"
 //DEBUG
 #ifdef DEBUG_TEXTURE
 	#ifndef DEBUG_OUT
@@ -72,7 +79,35 @@ struct TextureDataStructure {
 class Texture : public TextureDataStructure {
 	std::string path;
 	unsigned char* image_data;
+	//Count of mipmap levels in image_data: more than 0 for baked texture, 0 for image decoded by SOIL
+	int image_levels = 0;
+	//Bytes per pixel of baked texture
+	int pixel_size = 0;
 	int load_status;
+
+	/**
+	*	\brief Copies levels of baked texture file to image_data.
+	*	Storage format of texture is replaced by one of file.
+	*	\return False if '_data' isn't baked texture file.
+	**/
+	bool LoadBaked(const char* _data, size_t _size) {
+		const TextureFile::Header* _header = TextureFile::parse(_data, _size);
+		if (!_header)
+			return false;
+		//Allocated by malloc: released by SOIL_free_image_data as decoded images
+		image_data = (unsigned char*)std::malloc((size_t)_header->dataSize);
+		if (!image_data)
+			return false;
+		std::memcpy(image_data, _data + _header->dataOffset, (size_t)_header->dataSize);
+		width = (int)_header->width;
+		height = (int)_header->height;
+		image_levels = (int)_header->levels;
+		GLStoreFormat = _header->glInternalFormat;
+		PixelDataFormat = _header->glFormat;
+		PixelDataType = _header->glType;
+		pixel_size = (int)_header->channels;
+		return true;
+	}
 public:
 	enum Load_Status : int {
 		EMPTY		= 0x0,
@@ -125,6 +160,8 @@ public:
 	Texture(Texture&& other) :	TextureDataStructure(std::move(other)),
 								path(std::move(other.path)), 
 								image_data(std::move(other.image_data)),
+								image_levels(other.image_levels),
+								pixel_size(other.pixel_size),
 								load_status(std::move(other.load_status))
 	{
 		if (load_status & IN_MEMORY)
@@ -138,7 +175,7 @@ public:
 		if (load_status & IN_MEMORY)
 			SOIL_free_image_data(image_data);
 		if (GLId)
-			glDeleteTextures(1, &GLId);
+			GLStateCache::global().deleteTexture(GLId);
 	}
 
 	Texture& operator=(Texture other) {
@@ -151,8 +188,8 @@ public:
 		return *this;
 	}
 
-	//Load image data from disk to memory
-	void LoadToMemory() {
+	//Load image data from '_fileSystem' to memory
+	void LoadToMemory(const VirtualFileSystem& _fileSystem) {
 		if (load_status & IN_MEMORY) {
 			SOIL_free_image_data(image_data);
 		} else if (load_status & UNSTABLE) {
@@ -167,7 +204,18 @@ public:
 			//IN_OPENGL to IN_BOTH, EMPTY to IN_MEMORY
 			load_status++;
 		}
-		image_data = SOIL_load_image(path.c_str(), &width, &height, 0, SOILLoadType);
+		//Stored pack entries are decoded in place, other files are read to buffer
+		size_t _size = 0;
+		const char* _data = _fileSystem.view(path, _size);
+		std::vector<char> _buffer;
+		if (!_data && _fileSystem.read(path, _buffer)) {
+			_data = _buffer.data();
+			_size = _buffer.size();
+		}
+		image_levels = 0;
+		//Baked texture is copied as is, other images are decoded
+		if (!_data || !LoadBaked(_data, _size))
+			image_data = _data ? SOIL_load_image_from_memory((const unsigned char*)_data, (int)_size, &width, &height, 0, SOILLoadType) : nullptr;
 		if (!image_data) {
 			#ifdef DEBUG_TEXTURE
 				DEBUG_OUT << "ERROR::TEXTURE::SOIL\n\tCan't load image by path: \n" << path << DEBUG_NEXT_LINE;
@@ -182,6 +230,9 @@ public:
 			#endif
 		}
 	}
+
+	//Load image data from global file system to memory
+	void LoadToMemory() { LoadToMemory(VirtualFileSystem::global()); }
 	
 	//Load image data from memory to OpenGL
 	void LoadFromMemoryToGL() {
@@ -196,18 +247,33 @@ public:
 				break;
 			case IN_BOTH:
 				if (GLId)
-					glDeleteTextures(1, &GLId);
+					GLStateCache::global().deleteTexture(GLId);
 			case IN_MEMORY:
 				glGenTextures(1, &GLId);
 				Warping();
-				SamplingFilter();
-				glBindTexture(GLTarget, GLId);
+				//Baked levels are sampled only by mipmap filter
+				SamplingFilter(image_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+				GLStateCache::global().bindTexture(GLTarget, GLId);
 				switch (GLTarget) {
 					case GL_TEXTURE_1D:
 						glTexImage1D(GLTarget, 0, GLStoreFormat, width, 0, PixelDataFormat, PixelDataType, image_data);
 						break;
 					case GL_TEXTURE_2D:
-						glTexImage2D(GLTarget, 0, GLStoreFormat, width, height, 0, PixelDataFormat, PixelDataType, image_data);
+						if (image_levels) {
+							//Rows of baked levels are tightly packed
+							glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+							unsigned char* _level = image_data;
+							for (int _index = 0; _index < image_levels; _index++) {
+								int _width = (int)TextureFile::levelSize((uint32_t)width, (uint32_t)_index);
+								int _height = (int)TextureFile::levelSize((uint32_t)height, (uint32_t)_index);
+								glTexImage2D(GLTarget, _index, GLStoreFormat, _width, _height, 0, PixelDataFormat, PixelDataType, _level);
+								_level += (size_t)_width * _height * pixel_size;
+							}
+							glTexParameteri(GLTarget, GL_TEXTURE_MAX_LEVEL, image_levels - 1);
+							glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+						} else {
+							glTexImage2D(GLTarget, 0, GLStoreFormat, width, height, 0, PixelDataFormat, PixelDataType, image_data);
+						}
 						break;
 					case GL_TEXTURE_3D:
 						glTexImage3D(GLTarget, 0, GLStoreFormat, width, height, depth, 0, PixelDataFormat, PixelDataType, image_data);
@@ -215,9 +281,9 @@ public:
 					default:
 						break;
 				}
-				if (HaveMimpmap == GL_TRUE)
+				if (HaveMimpmap == GL_TRUE && !image_levels)
 					glGenerateMipmap(GLTarget);
-				glBindTexture(GLTarget, 0);
+				GLStateCache::global().bindTexture(GLTarget, 0);
 				load_status = IN_BOTH;
 				#ifdef DEBUG_TEXTURE
 					#ifdef EVENTS_TEXTURE
@@ -229,19 +295,22 @@ public:
 		}
 	}
 
-	//Load image data from disk to OpenGL
-	void LoadToGL() {
-		LoadToMemory();
+	//Load image data from '_fileSystem' to OpenGL
+	void LoadToGL(const VirtualFileSystem& _fileSystem) {
+		LoadToMemory(_fileSystem);
 		LoadFromMemoryToGL();
 		SOIL_free_image_data(image_data);
 		if (load_status & IN_OPENGL)
 			load_status = IN_OPENGL;
 	}
 
+	//Load image data from global file system to OpenGL
+	void LoadToGL() { LoadToGL(VirtualFileSystem::global()); }
+
 	//Bind texture to OpenGL
 	void Use() { 
 		if ((load_status & IN_OPENGL) || (!GLId)) {
-			glBindTexture(GLTarget, GLId);
+			GLStateCache::global().bindTexture(GLTarget, GLId);
 		} else {
 			#ifdef DEBUG_TEXTURE
 				#ifdef WARNINGS_TEXTURE
@@ -256,20 +325,20 @@ public:
 	void Warping(GLuint s_warp = GL_REPEAT, GLuint t_warp = GL_REPEAT) {
 		if (!GLId)
 			return;
-		glBindTexture(GLTarget, GLId);
+		GLStateCache::global().bindTexture(GLTarget, GLId);
 		glTexParameteri(GLTarget, GL_TEXTURE_WRAP_S, s_warp);
 		glTexParameteri(GLTarget, GL_TEXTURE_WRAP_T, t_warp);
-		glBindTexture(GLTarget, 0);
+		GLStateCache::global().bindTexture(GLTarget, 0);
 	}
 
 	//Setup sampling filter parameters
 	void SamplingFilter(GLuint min = GL_LINEAR, GLuint mag = GL_LINEAR) {
 		if (!GLId)
 			return;
-		glBindTexture(GLTarget, GLId);
+		GLStateCache::global().bindTexture(GLTarget, GLId);
 		glTexParameteri(GLTarget, GL_TEXTURE_MIN_FILTER, min);
 		glTexParameteri(GLTarget, GL_TEXTURE_MAG_FILTER, mag);
-		glBindTexture(GLTarget, 0);
+		GLStateCache::global().bindTexture(GLTarget, 0);
 	}
 
 	//Setup new texture path
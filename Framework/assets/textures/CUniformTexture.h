@@ -62,7 +62,7 @@ public:
 						textureSlot(GL_TEXTURE0), 
 						textureUnit(0) 
 	{
-		TBase::setName(TEXTURE_STD_SHADER_VARIABLE_NAME);
+		TBase::setName(UNIFORM_NAME_ID(TEXTURE_STD_SHADER_VARIABLE_NAME));
 	}
 
 	TextureStorage(	TTexture *_texture, TShader *_shader,
@@ -171,8 +171,11 @@ public:
 		return *this;
 	}
 
+	//Texture unit binding is shared by all programs: texture is bound on every use
+	const unsigned int* getVersion() { return nullptr; }
+
 	void bindUniform(GLint location) {
-		glActiveTexture(textureSlot);
+		GLStateCache::global().activeTexture(textureSlot);
 		(value.*BindTexture)();
 		glUniform1i(location, textureUnit);
 	}
@@ -184,7 +187,7 @@ public:
 template <	class TTexture = Texture, class TShader = Shader,
 			void (TTexture::* TextureLoader)(void) = &TTexture::LoadToGL,
 			void (TTexture::* BindTexture)(void) = &TTexture::Use,
-			GLint(TShader::* _getUniformLocation)(const char*) = &TShader::getUniformLocation >
+			GLint(TShader::* _getUniformLocation)(UniformNameId) = &TShader::getUniformLocation >
 class TextureManualStorage : public TextureStorage<UniformManualStorage<TTexture, TShader>, TTexture, TShader, TextureLoader> {
 	typedef TextureStorage<UniformManualStorage<TTexture, TShader>, TTexture, TShader, TextureLoader> Base;
 public:
@@ -218,7 +221,7 @@ public:
 
 	//Bind sampler to shader
 	void bindData() {
-		GLint _location = (shader->*_getUniformLocation)(uniformName.c_str());
+		GLint _location = (shader->*_getUniformLocation)(uniformId);
 		if (_location == -1) { //Check if uniform not found
 			#ifdef DEBUG_UNIFORMMATRIX
 				DEBUG_OUT << "ERROR::VEC3_MANUAL_STORAGE::bindData::UNIFORM_NAME_MISSING" << DEBUG_NEXT_LINE;
@@ -226,7 +229,7 @@ public:
 			#endif
 			return;
 		}
-		glActiveTexture(textureSlot);
+		GLStateCache::global().activeTexture(textureSlot);
 		(value.*BindTexture)();
 		glUniform1i(_location, textureUnit);
 	}
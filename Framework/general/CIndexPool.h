@@ -10,87 +10,118 @@
 */
 //STD
 #include <vector>
-#include <algorithm>
+#include <cmath>
+#include <limits.h>
+#include <stdexcept>
 #include <type_traits>
 //OUR
-#include "general\vs2013tweaks.h"
-#include "general\mConcepts.hpp"
+#include "general/vs2013tweaks.h"
+#include "general/mConcepts.hpp"
 //DEBUG
 #if defined(DEBUG_INDEXPOOL) && !defined(OTHER_DEBUG)
-	#include "general\mDebug.h"		
+	#include "general/mDebug.h"
 #elif defined(DEBUG_INDEXPOOL) && defined(OTHER_DEBUG)
 	#include OTHER_DEBUG
 #endif
 
 /* The automatic index manager.
+*  Indexes are placed on grid: minIndex + slot * increment.
+*  Allocation and ignore states are stored as bitsets over slots so all membership checks are O(1).
 *  Class template definition: IndexPool
 */
 template < typename TIndex = int >
 class IndexPool {
 	typedef std::vector<TIndex> Container;
-	//Sorted list of allocated indexes
-	Container allocated;
-	//Sorted list of ignored indexes
-	Container ignored;
-	//Sorted list of indexes ready to use
+	//Bitset type of slot states
+	typedef std::vector<bool> SlotSet;
+	//Allocation state of every slot
+	SlotSet allocated;
+	//Ignore state of every slot
+	SlotSet ignored;
+	//Stack of deleted or allowed slots ready to use (may contain stale entries)
 	Container pool;
 	TIndex increment;
+	//Count of slots on grid
+	TIndex slotCount;
+	//First slot that was never given out
 	TIndex poolTop;
+	//Count of currently allocated indexes
+	TIndex allocatedCount;
+
+	//Slot of valid index '_index'
+	inline TIndex slotOf(TIndex _index) { return (_index - minIndex) / increment; }
+
+	//Index of slot '_slot'
+	inline TIndex indexOf(TIndex _slot) { return minIndex + _slot * increment; }
+
+	//Nearest slots of interval [_start, _end]. Interval is clamped to [minIndex, maxIndex)
+	//before rounding, so no negative offset is cast to TIndex. False if it misses the pool.
+	bool slotRange(TIndex _start, TIndex _end, TIndex& _low, TIndex& _high) {
+		if (_start > _end || _end < minIndex || _start >= maxIndex)
+			return false;
+		if (_start < minIndex)
+			_start = minIndex;
+		if (_end >= maxIndex)
+			_end = maxIndex - 1;
+		_low = (TIndex)std::round((_start - minIndex) / (double)increment);
+		_high = (TIndex)std::round((_end - minIndex) / (double)increment);
+		if (_high >= slotCount)
+			_high = slotCount - 1;
+		return _low <= _high;
+	}
+
+	//Checks that slot can be given out
+	inline bool isFree(TIndex _slot) { return !allocated[_slot] && !ignored[_slot]; }
 public:
 	typedef TIndex IndexType;
 	const TIndex minIndex;
 	const TIndex maxIndex;
 	const unsigned int size;
 
-	IndexPool(	TIndex _min, TIndex _max, unsigned int _size) : 
-				minIndex(_min), maxIndex(_max), size(_size) 
-	
+	IndexPool(	TIndex _min, TIndex _max, unsigned int _size) :
+				minIndex(_min), maxIndex(_max), size(_size)
+
 	{
-		if (_min > _max) 
+		if (_min > _max)
 			throw std::invalid_argument("ERROR::INDEX_POOL::MININDEX_IS_GRATER_THAN_MAXINDEX");
 		if (minIndex < (TIndex)0)
 			throw std::invalid_argument("ERROR::INDEX_POOL::MININDEX_TO_LOW");
-		poolTop = minIndex;
-		increment = (maxIndex - minIndex) / size; 
+		if (!_size)
+			throw std::invalid_argument("ERROR::INDEX_POOL::INVALID_SIZE");
+		poolTop = 0;
+		allocatedCount = 0;
+		increment = (maxIndex - minIndex) / size;
+		if (increment == (TIndex)0)
+			throw std::invalid_argument("ERROR::INDEX_POOL::SIZE_IS_GRATER_THAN_INTERVAL");
+		//Indexes must be lower than maxIndex
+		slotCount = (maxIndex - minIndex + increment - 1) / increment;
+		allocated.assign((size_t)slotCount, false);
+		ignored.assign((size_t)slotCount, false);
 	}
 
 	TIndex newIndex() {
-		auto _ignend = ignored.end();
-		auto _ignbeg = ignored.begin();
-
+		TIndex _slot;
 		//Try to allocate from index pool
-		if (pool.size() > 0) {
-			TIndex _lastUsed = pool.back();
-			bool _success = true;
-			while (_ignend != std::find(_ignbeg, _ignend, _lastUsed)) {
-				pool.pop_back();
-				if (pool.size() > 0) {
-					_lastUsed = pool.back();
-				} else {
-					_success = false;
-					break;
-				}
-			}
-			if (_success) {
-				allocated.push_back(_lastUsed);
-				pool.pop_back();
-				return _lastUsed;
+		while (pool.size() > 0) {
+			_slot = pool.back();
+			pool.pop_back();
+			if (isFree(_slot)) {
+				allocated[_slot] = true;
+				allocatedCount++;
+				return indexOf(_slot);
 			}
-		} 
+		}
 
 		//Try to allocate new index
-		TIndex _buff = poolTop;
-		if (allocated.size() != 0)
-			_buff += increment;
-		while (_ignend != std::find(_ignbeg, _ignend, _buff) && _buff < maxIndex)
-			_buff += increment;
-		if (_buff >= maxIndex) {
+		while (poolTop < slotCount && !isFree(poolTop))
+			poolTop++;
+		if (poolTop >= slotCount) {
 			throw std::out_of_range("ERROR::INDEX_POOL::CAN'T_ALLOCATE_NEW_INDEX");
 			return (TIndex)-1;
 		} else {
-			poolTop = _buff;
-			allocated.push_back(_buff);
-			return _buff;
+			allocated[poolTop] = true;
+			allocatedCount++;
+			return indexOf(poolTop++);
 		}
 	}
 
@@ -113,8 +144,7 @@ public:
 	}
 
 	void deleteIndex(TIndex _index) {
-		auto _toDelete = std::find(allocated.begin(), allocated.end(), _index);
-		if (_toDelete == allocated.end()) {
+		if (!isAllocated(_index)) {
 			#ifdef DEBUG_INDEXPOOL
 				#ifdef WARNINGS_INDEXPOOL
 					DEBUG_OUT << "WARNING::INDEX_POOL::CAN'T_FIND_INDEX_TO_DELETE" << DEBUG_NEXT_LINE;
@@ -122,50 +152,62 @@ public:
 				#endif
 			#endif
 		} else {
-			auto _isIgnored = std::find(ignored.begin(), ignored.end(), *_toDelete);
-			if (_isIgnored != ignored.end())
-				pool.push_back(*_toDelete);
-			allocated.erase(_toDelete);
+			TIndex _slot = slotOf(_index);
+			allocated[_slot] = false;
+			allocatedCount--;
+			if (!ignored[_slot])
+				pool.push_back(_slot);
 		}
 	}
 
 	inline bool isValid(TIndex _index) {
-		return  _index >= minindex && std::fmod(_index - minIndex, increment) == (TIndex)0 && _index < maxIndex;
+		return  _index >= minIndex && _index < maxIndex && (_index - minIndex) % increment == (TIndex)0;
 	}
 
+	inline bool isAllocated(TIndex _index) { return isValid(_index) && allocated[slotOf(_index)]; }
+
+	inline TIndex getAllocatedCount() { return allocatedCount; }
+
+	//Computes memory used by this pool
+	size_t usedMemory() { return (allocated.capacity() + ignored.capacity()) / CHAR_BIT + pool.capacity() * sizeof(TIndex) + sizeof(IndexPool); }
+
 	inline void ignore(TIndex _index) {
 		if (isValid(_index))
-			ignored.push_back(_index);
+			ignored[slotOf(_index)] = true;
 	}
 
 	void ignore(TIndex _start, TIndex _end) {
-		TIndex _low = std::round((_start - minIndex) / (double)increment) * increment + minIndex;
-		TIndex _high = std::round((_end - minIndex) / (double)increment) * increment + minIndex;
-		for (TIndex _index = _low; _index <= _high; _index += increment)
-			ignored.push_back(_index);
+		TIndex _low, _high;
+		if (!slotRange(_start, _end, _low, _high))
+			return;
+		for (TIndex _slot = _low; _slot <= _high; _slot++)
+			ignored[_slot] = true;
 	}
 
 	inline bool isIgnored(TIndex _index) {
-		return std::find(ignored.begin(), ignored.end(), _index) != ignored.end() || !isValid(_index);
+		return !isValid(_index) || ignored[slotOf(_index)];
 	}
 
 	void allow(TIndex _index) {
-		auto _toAllow = std::find(ignored.begin(), ignored.end(), _index);
-		if (_toAllow != ignored.end()) {
-			pool.push_back(*_toAllow);
-			ignored.erase(_toAllow);
+		if (!isValid(_index))
+			return;
+		TIndex _slot = slotOf(_index);
+		if (ignored[_slot]) {
+			ignored[_slot] = false;
+			if (_slot < poolTop && !allocated[_slot])
+				pool.push_back(_slot);
 		}
 	}
 
 	void allow(TIndex _start, TIndex _end) {
-		TIndex _low = std::round((_start - minIndex) / (double)increment) * increment + minIndex;
-		TIndex _high = std::round((_end - minIndex) / (double)increment) * increment + minIndex;
-		Container::iterator _toAllow;
-		for (TIndex _index = _low; _index <= _high; _index += increment) {
-			_toAllow = std::find(ignored.begin(), ignored.end(), _index);
-			if (_toAllow != ignored.end()) {
-				pool.push_back(*_toAllow);
-				ignored.erase(_toAllow);
+		TIndex _low, _high;
+		if (!slotRange(_start, _end, _low, _high))
+			return;
+		for (TIndex _slot = _low; _slot <= _high; _slot++) {
+			if (ignored[_slot]) {
+				ignored[_slot] = false;
+				if (_slot < poolTop && !allocated[_slot])
+					pool.push_back(_slot);
 			}
 		}
 	}
@@ -67,7 +67,7 @@ public:
 */
 template <	class TMatrix = our::mat4, class TShader = Shader,
 			GLfloat* (TMatrix::* _getValuePtr)(void) = &TMatrix::getValuePtr,
-			GLint (TShader::* _getUniformLocation)(const char*) = &TShader::getUniformLocation>
+			GLint (TShader::* _getUniformLocation)(UniformNameId) = &TShader::getUniformLocation>
 class MatrixManualStorage : public UniformManualStorage<TMatrix, TShader> {
 	typedef UniformManualStorage<TMatrix, TShader> Base;
 public:
@@ -91,7 +91,7 @@ public:
 	
 	//Bind matrix to shader
 	void bindData() {
-		GLint _location = (shader->*_getUniformLocation)(uniformName.c_str());
+		GLint _location = (shader->*_getUniformLocation)(uniformId);
 		if (_location == -1) { //Check if uniform not found
 			#ifdef DEBUG_UNIFORMMATRIX
 				DEBUG_OUT << "ERROR::MATRIX_MANUAL_STORAGE::bindData::UNIFORM_NAME_MISSING" << DEBUG_NEXT_LINE;
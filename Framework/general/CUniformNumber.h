@@ -67,7 +67,7 @@ public:
 *  Class template definition: NumberManualStorage
 */
 template <	class T = float, class TShader = Shader, 
-			GLint(TShader::* _getUniformLocation)(const char*) = &TShader::getUniformLocation >
+			GLint(TShader::* _getUniformLocation)(UniformNameId) = &TShader::getUniformLocation >
 class NumberManualStorage : public UniformManualStorage<T, TShader> {
 	typedef UniformManualStorage<T, TShader> Base;
 public:
@@ -86,7 +86,7 @@ public:
 	NumberManualStorage(NumberManualStorage&& other) : Base(std::move(other)) {}
 
 	void bindData() {
-		GLint _location = (shader->*_getUniformLocation)(uniformName.c_str());
+		GLint _location = (shader->*_getUniformLocation)(uniformId);
 		if (_location == -1) { //Check if uniform not found
 			#ifdef DEBUG_UNIFORMNUMBER
 				DEBUG_OUT << "ERROR::NUMBER_MANUAL_STORAGE::bindData::UNIFORM_NAME_MISSING" << DEBUG_NEXT_LINE;
@@ -90,7 +90,7 @@ public:
 *  Class template definition: Vec3ManualStorage
 */
 template <	class TVector = glm::vec3, class TShader = Shader,
-			GLint(TShader::* _getUniformLocation)(const char*) = &TShader::getUniformLocation >
+			GLint(TShader::* _getUniformLocation)(UniformNameId) = &TShader::getUniformLocation >
 class Vec3ManualStorage : public UniformManualStorage<TVector, TShader> {
 	typedef UniformManualStorage<TVector, TShader> Base;
 public:
@@ -110,7 +110,7 @@ public:
 	
 	//Bind vec3 to shader
 	void bindData() {
-		GLint _location = (shader->*_getUniformLocation)(uniformName.c_str());
+		GLint _location = (shader->*_getUniformLocation)(uniformId);
 		if (_location == -1) { //Check if uniform not found
 			#ifdef DEBUG_UNIFORMVEC3
 				DEBUG_OUT << "ERROR::VEC3_MANUAL_STORAGE::bindData::UNIFORM_NAME_MISSING" << DEBUG_NEXT_LINE;
@@ -126,7 +126,7 @@ public:
 *  Class template definition: Vec3AutomaticObserver
 */
 template <	class TVector = glm::vec3, class TShader = Shader,
-			GLint(TShader::* _getUniformLocation)(const char*) = &TShader::getUniformLocation >
+			GLint(TShader::* _getUniformLocation)(UniformNameId) = &TShader::getUniformLocation >
 class Vec3ManualObserver : public UniformManualObserver<TVector, TShader> {
 	typedef UniformManualObserver<TVector, TShader> Base;
 public:
@@ -146,7 +146,7 @@ public:
 
 	//Bind vec3 to shader
 	void bindData() {
-		GLint _location = (shader->*_getUniformLocation)(uniformName.c_str());
+		GLint _location = (shader->*_getUniformLocation)(uniformId);
 		if (_location == -1) { //Check if uniform not found
 			#ifdef DEBUG_UNIFORMVEC3
 				DEBUG_OUT << "ERROR::VEC3_MANUAL_OBSERVER::bindData::UNIFORM_NAME_MISSING" << DEBUG_NEXT_LINE;
@@ -90,7 +90,7 @@ public:
 *  Class template definition: Vec4ManualStorage
 */
 template <	class TVector = glm::vec4, class TShader = Shader,
-			GLint(TShader::* _getUniformLocation)(const char*) = &TShader::getUniformLocation >
+			GLint(TShader::* _getUniformLocation)(UniformNameId) = &TShader::getUniformLocation >
 class Vec4ManualStorage : public UniformManualStorage<TVector, TShader> {
 	typedef UniformManualStorage<TVector, TShader> Base;
 public:
@@ -108,7 +108,7 @@ public:
 	
 	//Bind vec3 to shader
 	void bindData() {
-		GLint _location = (shader->*_getUniformLocation)(uniformName.c_str());
+		GLint _location = (shader->*_getUniformLocation)(uniformId);
 		if (_location == -1) { //Check if uniform not found
 			#ifdef DEBUG_UNIFORMVEC4
 				DEBUG_OUT << "ERROR::VEC4_MANUAL_STORAGE::bindData::UNIFORM_NAME_MISSING" << DEBUG_NEXT_LINE;
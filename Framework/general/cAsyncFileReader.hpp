@@ -0,0 +1,608 @@
+#ifndef ASYNCFILEREADER_H
+#define ASYNCFILEREADER_H "[multi@cAsyncFileReader.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of asynchronous whole file reader.
+*		Reads are queued by read and sent by submit in one batch.
+*		Linux: open, read and close of every file are io_uring operations, batch costs
+*		few io_uring_enter calls instead of four system calls per file. Files are first
+*		read into registered buffers: small ones need no size query. Completions are
+*		reaped by one thread that calls callbacks.
+*		Other systems or kernels without io_uring: reads are done by threads of pool with pread.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/stat.h>
+#endif
+#ifdef __linux__
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <sys/uio.h>
+	#include <linux/io_uring.h>
+#endif
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/cThreadPool.hpp"
+#include "general/cAsyncTask.hpp"
+
+#ifndef ASYNCFILEREADER_QUEUE_DEPTH
+	//Count of io_uring submission entries: maximal count of files in flight
+	#define ASYNCFILEREADER_QUEUE_DEPTH 256
+#endif
+
+#ifndef ASYNCFILEREADER_BUFFER_SIZE
+	//Size of one registered buffer: files that are smaller don't need size query
+	#define ASYNCFILEREADER_BUFFER_SIZE 0x10000
+#endif
+
+#ifndef ASYNCFILEREADER_BUFFER_COUNT
+	//Count of registered buffers
+	#define ASYNCFILEREADER_BUFFER_COUNT 64
+#endif
+
+#ifndef ASYNCFILEREADER_FALLBACK_THREADS
+	//Count of reading threads when io_uring isn't available: reads block, so it doesn't depend on core count
+	#define ASYNCFILEREADER_FALLBACK_THREADS 4
+#endif
+
+//Define to always use pool of reading threads
+//#define ASYNCFILEREADER_NO_IO_URING
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && !defined(ASYNCFILEREADER_NO_IO_URING)
+	#define ASYNCFILEREADER_IO_URING
+#endif
+
+/**
+*	\brief Reader of whole files with batched asynchronous submission.
+*	Callbacks are called on reaping (or pool) thread: they must be short and must not throw,
+*	heavy work must be passed to JobSystem (see readFileAsync).
+*	Class definition: AsyncFileReader
+**/
+class AsyncFileReader {
+public:
+	//Content of read file
+	typedef std::shared_ptr< std::vector<char> > Content;
+	/**
+	*	Completion callback: path, content and error.
+	*	Error is 0 on success or errno value, content is nullptr on error.
+	**/
+	typedef std::function<void(const std::string&, Content, int)> Callback;
+private:
+	//One queued or running read
+	struct Request {
+		std::string path;
+		Callback callback;
+		Content content;
+		int fd;
+		int error;
+		//Count of bytes already read
+		size_t done;
+		//Registered buffer index, -1 if read goes to content directly
+		int buffer;
+
+		Request(const std::string& _path, Callback&& _callback) :
+			path(_path), callback(std::move(_callback)), fd(-1), error(0), done(0), buffer(-1) {}
+	};
+
+	/**
+	*	\brief Opens and reads file of '_request' on calling thread.
+	*	\throw nothrow
+	**/
+	static void readBlocking(Request& _request) NOEXCEPT {
+		try {
+		#if defined(__unix__) || defined(__APPLE__)
+			_request.fd = ::open(_request.path.c_str(), O_RDONLY | O_CLOEXEC);
+			struct stat _stat;
+			if (_request.fd < 0 || fstat(_request.fd, &_stat) < 0) {
+				_request.error = errno;
+			} else {
+				_request.content = std::make_shared< std::vector<char> >((size_t)_stat.st_size);
+				std::vector<char>& _content = *_request.content;
+				while (!_request.error && _request.done < _content.size()) {
+					ssize_t _result = pread(_request.fd, _content.data() + _request.done, _content.size() - _request.done, (off_t)_request.done);
+					if (_result < 0 && errno != EINTR)
+						_request.error = errno;
+					else if (!_result)
+						//File became shorter
+						_content.resize(_request.done);
+					else if (_result > 0)
+						_request.done += (size_t)_result;
+				}
+			}
+			if (_request.fd >= 0)
+				::close(_request.fd);
+		#else
+			std::ifstream _file(_request.path, std::ios::binary | std::ios::ate);
+			if (!_file) {
+				_request.error = ENOENT;
+			} else {
+				_request.content = std::make_shared< std::vector<char> >((size_t)_file.tellg());
+				_file.seekg(0);
+				if (!_request.content->empty() && !_file.read(_request.content->data(), (std::streamsize)_request.content->size()))
+					_request.error = EIO;
+			}
+		#endif
+		}
+		catch (...) { _request.error = ENOMEM; }
+		if (_request.error)
+			_request.content = nullptr;
+	}
+
+	//Calls callback of '_request' and deletes it
+	static void complete(Request* _request) NOEXCEPT {
+		try { _request->callback(_request->path, std::move(_request->content), _request->error); }
+		catch (...) {}
+		delete _request;
+	}
+
+#ifdef ASYNCFILEREADER_IO_URING
+	/**
+	*	\brief Mapped io_uring instance: submission and completion rings.
+	*	Struct definition: Ring
+	**/
+	struct Ring {
+		int fd;
+		unsigned int entries;
+		//Count of pushed entries not yet passed to kernel
+		unsigned int unsubmitted;
+		void* sqMap;
+		size_t sqMapSize;
+		void* cqMap;
+		size_t cqMapSize;
+		io_uring_sqe* sqes;
+		size_t sqesSize;
+		unsigned int *sqTail, *sqMask, *sqArray;
+		unsigned int *cqHead, *cqTail, *cqMask;
+		io_uring_cqe* cqes;
+
+		Ring() : fd(-1), entries(0), unsubmitted(0), sqMap(MAP_FAILED), sqMapSize(0), cqMap(MAP_FAILED), cqMapSize(0), sqes((io_uring_sqe*)MAP_FAILED), sqesSize(0) {}
+
+		~Ring() NOEXCEPT {
+			if (sqes != MAP_FAILED)
+				munmap(sqes, sqesSize);
+			if (cqMap != MAP_FAILED && cqMap != sqMap)
+				munmap(cqMap, cqMapSize);
+			if (sqMap != MAP_FAILED)
+				munmap(sqMap, sqMapSize);
+			if (fd >= 0)
+				::close(fd);
+		}
+
+		//Checks that kernel supports all operations used by reader
+		bool probe() NOEXCEPT {
+			const unsigned int _count = 64;
+			std::vector<char> _place(sizeof(io_uring_probe) + _count * sizeof(io_uring_probe_op), 0);
+			io_uring_probe* _probe = (io_uring_probe*)_place.data();
+			if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, _probe, _count) < 0)
+				return false;
+			for (unsigned int _op : { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_CLOSE, IORING_OP_NOP })
+				if (_op > _probe->last_op || !(_probe->ops[_op].flags & IO_URING_OP_SUPPORTED))
+					return false;
+			return true;
+		}
+
+		/**
+		*	\brief Creates ring with '_entries' submission entries and maps it.
+		*	\throw nothrow
+		*	\return False if io_uring or any used operation isn't available.
+		**/
+		bool init(unsigned int _entries) NOEXCEPT {
+			io_uring_params _params;
+			std::memset(&_params, 0, sizeof(_params));
+			fd = (int)syscall(__NR_io_uring_setup, _entries, &_params);
+			if (fd < 0 || !probe())
+				return false;
+			entries = _params.sq_entries;
+			sqMapSize = _params.sq_off.array + _params.sq_entries * sizeof(unsigned int);
+			cqMapSize = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+			bool _single = (_params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (_single)
+				sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+			sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+			if (sqMap == MAP_FAILED)
+				return false;
+			cqMap = _single ? sqMap : mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+			if (cqMap == MAP_FAILED)
+				return false;
+			sqesSize = _params.sq_entries * sizeof(io_uring_sqe);
+			sqes = (io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+			if (sqes == MAP_FAILED)
+				return false;
+			char* _sq = (char*)sqMap;
+			sqTail = (unsigned int*)(_sq + _params.sq_off.tail);
+			sqMask = (unsigned int*)(_sq + _params.sq_off.ring_mask);
+			sqArray = (unsigned int*)(_sq + _params.sq_off.array);
+			char* _cq = (char*)cqMap;
+			cqHead = (unsigned int*)(_cq + _params.cq_off.head);
+			cqTail = (unsigned int*)(_cq + _params.cq_off.tail);
+			cqMask = (unsigned int*)(_cq + _params.cq_off.ring_mask);
+			cqes = (io_uring_cqe*)(_cq + _params.cq_off.cqes);
+			return true;
+		}
+
+		/**
+		*	\brief Returns cleared entry at submission tail, passes pushed entries to kernel if ring is full.
+		*	Kernel reads entries only in enter call, so entry may be filled after tail is moved.
+		**/
+		io_uring_sqe* push(unsigned char _opcode, Request* _request, unsigned int _tag) NOEXCEPT {
+			if (unsubmitted == entries)
+				enter();
+			unsigned int _tail = *sqTail;
+			unsigned int _index = _tail & *sqMask;
+			io_uring_sqe* _sqe = &sqes[_index];
+			std::memset(_sqe, 0, sizeof(io_uring_sqe));
+			_sqe->opcode = _opcode;
+			_sqe->user_data = (unsigned long long)_request | _tag;
+			sqArray[_index] = _index;
+			__atomic_store_n(sqTail, _tail + 1, __ATOMIC_RELEASE);
+			unsubmitted++;
+			return _sqe;
+		}
+
+		//Passes pushed entries to kernel
+		void enter() NOEXCEPT {
+			while (unsubmitted) {
+				int _result = (int)syscall(__NR_io_uring_enter, fd, unsubmitted, 0, 0, nullptr, 0);
+				if (_result > 0)
+					unsubmitted -= std::min<unsigned int>(unsubmitted, (unsigned int)_result);
+				else if (_result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+					return;
+			}
+		}
+
+		//Waits for at least one completion
+		void wait() NOEXCEPT {
+			while (syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno == EINTR);
+		}
+	};
+
+	//Operation tags in low bits of completion user data
+	enum Tag : unsigned int {
+		TAG_OPEN	= 1,
+		TAG_READ	= 2,
+		TAG_CLOSE	= 3,
+		TAG_MASK	= 7
+	};
+
+	Ring ring;
+	std::unique_ptr<char[]> buffers;
+	std::vector<int> freeBuffers;
+	//Count of requests in ring, each has at most two completions pending
+	unsigned int inFlight;
+	std::thread reaper;
+
+	//Pushes read of not yet read part of '_request' to its content or whole registered buffer
+	void pushRead(Request& _request) NOEXCEPT {
+		io_uring_sqe* _sqe;
+		if (_request.buffer >= 0) {
+			_sqe = ring.push(IORING_OP_READ_FIXED, &_request, TAG_READ);
+			_sqe->addr = (unsigned long long)(buffers.get() + (size_t)_request.buffer * ASYNCFILEREADER_BUFFER_SIZE);
+			_sqe->buf_index = (unsigned short)_request.buffer;
+			_sqe->len = ASYNCFILEREADER_BUFFER_SIZE;
+		} else {
+			_sqe = ring.push(IORING_OP_READ, &_request, TAG_READ);
+			_sqe->addr = (unsigned long long)(_request.content->data() + _request.done);
+			_sqe->len = (unsigned int)std::min<size_t>(_request.content->size() - _request.done, 1u << 30);
+		}
+		_sqe->fd = _request.fd;
+		_sqe->off = _request.done;
+	}
+
+	//Moves '_request' that left ring to '_finished'
+	void finish(Request& _request, std::vector<Request*>& _finished) {
+		inFlight--;
+		if (_request.error)
+			_request.content = nullptr;
+		_finished.push_back(&_request);
+	}
+
+	//Pushes close of descriptor of '_request' or finishes it if file isn't open
+	void pushClose(Request& _request, std::vector<Request*>& _finished) {
+		if (_request.fd < 0) {
+			finish(_request, _finished);
+			return;
+		}
+		ring.push(IORING_OP_CLOSE, &_request, TAG_CLOSE)->fd = _request.fd;
+		_request.fd = -1;
+	}
+
+	/**
+	*	\brief Allocates content of '_request' for whole file and copies '_copy' bytes of its registered buffer.
+	*	File size is queried only here: for files that don't fit registered buffer or if no buffer is free.
+	*	\throw nothrow
+	*	\return False on error.
+	**/
+	bool allocate(Request& _request, size_t _copy) NOEXCEPT {
+		size_t _size = _copy;
+		if (_copy == ASYNCFILEREADER_BUFFER_SIZE || _request.buffer < 0) {
+			struct stat _stat;
+			if (fstat(_request.fd, &_stat) < 0) {
+				_request.error = errno;
+				return false;
+			}
+			_size = std::max(_size, (size_t)_stat.st_size);
+		}
+		try { _request.content = std::make_shared< std::vector<char> >(_size); }
+		catch (...) {
+			_request.error = ENOMEM;
+			return false;
+		}
+		if (_request.buffer >= 0) {
+			std::memcpy(_request.content->data(), buffers.get() + (size_t)_request.buffer * ASYNCFILEREADER_BUFFER_SIZE, _copy);
+			freeBuffers.push_back(_request.buffer);
+			_request.buffer = -1;
+		}
+		_request.done = _copy;
+		return true;
+	}
+
+	/**
+	*	\brief Pushes open of pending requests while ring has room. Must be called under lock.
+	*	Every request has one operation in ring at a time and count of requests in flight
+	*	is bounded by entries, so completion ring (twice larger) never overflows.
+	**/
+	void fill() NOEXCEPT {
+		while (!pending.empty() && inFlight < ring.entries) {
+			Request* _request = pending.front();
+			pending.pop_front();
+			io_uring_sqe* _sqe = ring.push(IORING_OP_OPENAT, _request, TAG_OPEN);
+			_sqe->fd = AT_FDCWD;
+			_sqe->addr = (unsigned long long)_request->path.c_str();
+			_sqe->open_flags = O_RDONLY | O_CLOEXEC;
+			inFlight++;
+		}
+	}
+
+	//Processes completion '_cqe', requests that are done go to '_finished'. Must be called under lock.
+	void process(const io_uring_cqe& _cqe, std::vector<Request*>& _finished) {
+		Request& _request = *(Request*)(_cqe.user_data & ~(unsigned long long)TAG_MASK);
+		switch (_cqe.user_data & TAG_MASK) {
+		case TAG_OPEN:
+			if (_cqe.res < 0) {
+				_request.error = -_cqe.res;
+				finish(_request, _finished);
+				return;
+			}
+			_request.fd = _cqe.res;
+			if (!freeBuffers.empty()) {
+				_request.buffer = freeBuffers.back();
+				freeBuffers.pop_back();
+			} else if (!allocate(_request, 0) || _request.content->empty()) {
+				pushClose(_request, _finished);
+				return;
+			}
+			break;
+		case TAG_READ:
+			if (_cqe.res == -EINTR || _cqe.res == -EAGAIN)
+				break;
+			if (_cqe.res < 0) {
+				_request.error = -_cqe.res;
+				if (_request.buffer >= 0) {
+					freeBuffers.push_back(_request.buffer);
+					_request.buffer = -1;
+				}
+				pushClose(_request, _finished);
+				return;
+			}
+			if (_request.buffer >= 0) {
+				//Short read of registered buffer is end of file
+				if (!allocate(_request, (size_t)_cqe.res)) {
+					pushClose(_request, _finished);
+					return;
+				}
+			} else if (!_cqe.res) {
+				//File became shorter
+				_request.content->resize(_request.done);
+			} else {
+				_request.done += (size_t)_cqe.res;
+			}
+			if (_request.done >= _request.content->size()) {
+				pushClose(_request, _finished);
+				return;
+			}
+			break;
+		case TAG_CLOSE:
+			finish(_request, _finished);
+			return;
+		}
+		pushRead(_request);
+	}
+
+	//Completion thread loop
+	void reap() {
+		std::vector<Request*> _finished;
+		for (;;) {
+			bool _stop;
+			{
+				std::lock_guard<std::mutex> _lock(lock);
+				unsigned int _head = *ring.cqHead;
+				unsigned int _tail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+				for (; _head != _tail; _head++) {
+					const io_uring_cqe& _cqe = ring.cqes[_head & *ring.cqMask];
+					//Stop signal has no request
+					if (_cqe.user_data)
+						process(_cqe, _finished);
+				}
+				__atomic_store_n(ring.cqHead, _head, __ATOMIC_RELEASE);
+				fill();
+				ring.enter();
+				_stop = stopping && !inFlight && pending.empty();
+			}
+			for (auto _request : _finished)
+				complete(_request);
+			_finished.clear();
+			if (_stop)
+				return;
+			//Only reaper consumes completions, so it waits outside of lock
+			ring.wait();
+		}
+	}
+#endif // ASYNCFILEREADER_IO_URING
+
+	//Guards queues and ring
+	std::mutex lock;
+	//Requests waiting for submit
+	std::deque<Request*> queued;
+	//Requests submitted but not yet placed to ring
+	std::deque<Request*> pending;
+	bool stopping;
+	//Reading threads when io_uring isn't used
+	std::unique_ptr<ThreadPool> fallback;
+public:
+	/**
+	*	\brief Creates reader, io_uring with '_depth' entries if it is available, pool of threads otherwise.
+	*	Buffers are registered if locked memory limit allows it.
+	*	\param[in]	_depth		Count of io_uring entries.
+	*	\param[in]	_ioUring	False to use pool of threads even if io_uring is available.
+	*	\throw std::system_error If thread can't be started, std::bad_alloc.
+	**/
+	explicit AsyncFileReader(unsigned int _depth = ASYNCFILEREADER_QUEUE_DEPTH, bool _ioUring = true) : stopping(false) {
+	#ifdef ASYNCFILEREADER_IO_URING
+		inFlight = 0;
+		if (_ioUring && ring.init(_depth)) {
+			buffers.reset(new char[(size_t)ASYNCFILEREADER_BUFFER_COUNT * ASYNCFILEREADER_BUFFER_SIZE]);
+			std::vector<iovec> _iovecs(ASYNCFILEREADER_BUFFER_COUNT);
+			for (unsigned int _index = 0; _index < ASYNCFILEREADER_BUFFER_COUNT; _index++) {
+				_iovecs[_index].iov_base = buffers.get() + (size_t)_index * ASYNCFILEREADER_BUFFER_SIZE;
+				_iovecs[_index].iov_len = ASYNCFILEREADER_BUFFER_SIZE;
+			}
+			if (syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS, _iovecs.data(), (unsigned int)_iovecs.size()) >= 0) {
+				for (int _index = ASYNCFILEREADER_BUFFER_COUNT - 1; _index >= 0; _index--)
+					freeBuffers.push_back(_index);
+			} else {
+				buffers.reset();
+			}
+			reaper = std::thread([this]() { reap(); });
+			return;
+		}
+	#endif
+		fallback.reset(new ThreadPool(ASYNCFILEREADER_FALLBACK_THREADS));
+	}
+
+	//Finishes submitted reads; queued but not submitted reads are submitted too
+	~AsyncFileReader() NOEXCEPT {
+		submit();
+	#ifdef ASYNCFILEREADER_IO_URING
+		if (!fallback) {
+			{
+				std::lock_guard<std::mutex> _lock(lock);
+				stopping = true;
+				//Wakes reaper if nothing is in flight
+				ring.push(IORING_OP_NOP, nullptr, 0);
+				ring.enter();
+			}
+			reaper.join();
+		}
+	#endif
+		//Pool finishes its reads in destructor
+	}
+
+	AsyncFileReader(const AsyncFileReader&) = delete;
+
+	AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+	//Checks that reads go through io_uring
+	inline bool usesIoUring() const NOEXCEPT { return !fallback; }
+
+	/**
+	*	\brief Queues read of whole file '_path', it starts on next submit.
+	*	\param[in]	_path		Path to file.
+	*	\param[in]	_callback	Completion callback, see Callback.
+	*	\throw std::bad_alloc
+	**/
+	void read(const std::string& _path, Callback _callback) {
+		std::unique_ptr<Request> _request(new Request(_path, std::move(_callback)));
+		std::lock_guard<std::mutex> _lock(lock);
+		queued.push_back(_request.get());
+		_request.release();
+	}
+
+	/**
+	*	\brief Starts all queued reads.
+	*	io_uring: one system call for whole batch up to queue depth, rest starts as files are finished.
+	*	\throw nothrow
+	**/
+	void submit() NOEXCEPT {
+		std::vector<Request*> _requests;
+		{
+			std::lock_guard<std::mutex> _lock(lock);
+			if (queued.empty())
+				return;
+			if (fallback) {
+				_requests.assign(queued.begin(), queued.end());
+			} else {
+				pending.insert(pending.end(), queued.begin(), queued.end());
+			#ifdef ASYNCFILEREADER_IO_URING
+				fill();
+				ring.enter();
+			#endif
+			}
+			queued.clear();
+		}
+		for (auto _request : _requests) {
+			try { fallback->submit([_request]() { readBlocking(*_request); complete(_request); }); }
+			catch (...) { readBlocking(*_request); complete(_request); }
+		}
+	}
+
+	/**
+	*	\brief Reader shared by framework subsystems.
+	**/
+	static AsyncFileReader& global() {
+		static AsyncFileReader _reader;
+		return _reader;
+	}
+};
+
+/**
+*	\brief Queues read of whole file '_path' without submitting it.
+*	Completion resolves task, its stages run on '_jobs'. Reads become one batch on '_reader.submit()'.
+*	\param[in]	_jobs	Job system that runs next stages.
+*	\param[in]	_path	Path to file.
+*	\param[in]	_reader	Reader of file.
+*	\throw std::bad_alloc
+*	\return Task of file content, it fails with std::system_error if file can't be read.
+**/
+inline AsyncTask<AsyncFileReader::Content> queueFileAsync(JobSystem& _jobs, const std::string& _path, AsyncFileReader& _reader = AsyncFileReader::global()) {
+	auto _task = AsyncTask<AsyncFileReader::Content>::deferred(_jobs);
+	_reader.read(_path, [_task](const std::string& _file, AsyncFileReader::Content _content, int _error) mutable {
+		if (_error)
+			_task.reject(std::make_exception_ptr(std::system_error(_error, std::generic_category(), "ERROR::ASYNC_FILE_READER::queueFileAsync::Can't read file: " + _file)));
+		else
+			_task.resolve(std::move(_content));
+	});
+	return _task;
+}
+
+/**
+*	\brief Reads whole file '_path' asynchronously, see queueFileAsync.
+*	To read many files in one batch use queueFileAsync for each of them and submit once.
+*	\throw std::bad_alloc
+*	\return Task of file content, it fails with std::system_error if file can't be read.
+**/
+inline AsyncTask<AsyncFileReader::Content> readFileAsync(JobSystem& _jobs, const std::string& _path, AsyncFileReader& _reader = AsyncFileReader::global()) {
+	auto _task = queueFileAsync(_jobs, _path, _reader);
+	_reader.submit();
+	return _task;
+}
+#endif
\ No newline at end of file
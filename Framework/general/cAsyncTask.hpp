@@ -0,0 +1,217 @@
+#ifndef ASYNCTASK_H
+#define ASYNCTASK_H "[multi@cAsyncTask.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of asynchronous task with continuations
+*		run by JobSystem on worker threads or on main (GL) thread.
+*		Pipelines are written as chain of stages:
+*			AsyncTask<Data>::run(jobs, AsyncThread::WORKER, read)
+*				.then(AsyncThread::WORKER, decode)
+*				.then(AsyncThread::MAIN, upload);
+*		Chains of different assets overlap: every stage is a separate job.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/cJobSystem.hpp"
+
+/**
+*	Thread that runs stage of asynchronous task.
+**/
+enum class AsyncThread : int {
+	//Any worker of job system
+	WORKER,
+	//Main thread of job system: owner of GL context
+	MAIN
+};
+
+template < class T >
+/**
+*	\brief Result of asynchronous stage and source of next stages.
+*	Copies refer to the same result. "T" must be default and copy constructible.
+*	Exception thrown by stage is passed through next stages and rethrown by get.
+*	Class template definition: AsyncTask
+**/
+class AsyncTask {
+	template < class U > friend class AsyncTask;
+
+	struct State {
+		std::mutex lock;
+		bool ready;
+		T value;
+		std::exception_ptr error;
+		//Stages waiting for this result
+		std::vector< std::function<void()> > continuations;
+		JobSystem* jobs;
+
+		State(JobSystem* _jobs) : ready(false), value(), jobs(_jobs) {}
+	};
+
+	std::shared_ptr<State> state;
+
+	AsyncTask(const std::shared_ptr<State>& _state) : state(_state) {}
+
+	//Stores result and starts waiting stages
+	void finish(T* _value, std::exception_ptr _error) {
+		std::vector< std::function<void()> > _continuations;
+		{
+			std::lock_guard<std::mutex> _lock(state->lock);
+			if (_value)
+				state->value = std::move(*_value);
+			state->error = _error;
+			state->ready = true;
+			_continuations.swap(state->continuations);
+		}
+		for (auto& _continuation : _continuations)
+			_continuation();
+	}
+
+	//Calls '_func' when result is ready, immediately if it is ready now
+	void onReady(std::function<void()> _func) {
+		{
+			std::lock_guard<std::mutex> _lock(state->lock);
+			if (!state->ready) {
+				state->continuations.push_back(std::move(_func));
+				return;
+			}
+		}
+		_func();
+	}
+
+	//Schedules '_func' on '_thread'
+	static void dispatch(JobSystem& _jobs, AsyncThread _thread, std::function<void()> _func) {
+		if (_thread == AsyncThread::MAIN)
+			_jobs.runOnMain(std::move(_func));
+		else
+			_jobs.run(std::move(_func));
+	}
+
+	template < class TFunc >
+	//Runs '_func' and stores its result or exception
+	void complete(TFunc& _func) {
+		try {
+			T _value = _func();
+			finish(&_value, nullptr);
+		}
+		catch (...) { finish(nullptr, std::current_exception()); }
+	}
+public:
+	//Result type of task
+	typedef T ValueType;
+
+	//Constructs invalid task
+	AsyncTask() : state(nullptr) {}
+
+	template < class TFunc >
+	/**
+	*	\brief Schedules '_func' on '_thread' as first stage of pipeline.
+	*	\param[in]	_jobs	Job system that runs stages.
+	*	\param[in]	_thread	Thread of stage.
+	*	\param[in]	_func	Functor with signature T().
+	*	\throw std::bad_alloc
+	*	\return Task of '_func' result.
+	**/
+	static AsyncTask run(JobSystem& _jobs, AsyncThread _thread, TFunc _func) {
+		AsyncTask _task(std::make_shared<State>(&_jobs));
+		dispatch(_jobs, _thread, [_task, _func]() mutable { _task.complete(_func); });
+		return _task;
+	}
+
+	/**
+	*	\brief Constructs task that is ready with '_value'.
+	*	\throw std::bad_alloc
+	**/
+	static AsyncTask ready(JobSystem& _jobs, T _value) {
+		AsyncTask _task(std::make_shared<State>(&_jobs));
+		_task.finish(&_value, nullptr);
+		return _task;
+	}
+
+	template < class TFunc >
+	/**
+	*	\brief Schedules '_func' on '_thread' after this task is ready.
+	*	'_func' receives result of this task. If this task failed '_func' isn't called
+	*	and returned task fails with the same exception.
+	*	\param[in]	_thread	Thread of stage.
+	*	\param[in]	_func	Functor with signature U(T&).
+	*	\throw std::bad_alloc, std::logic_error If task is invalid.
+	*	\return Task of '_func' result.
+	**/
+	auto then(AsyncThread _thread, TFunc _func) -> AsyncTask<decltype(_func(std::declval<T&>()))> {
+		typedef decltype(_func(std::declval<T&>())) U;
+		if (!state)
+			throw std::logic_error("ERROR::ASYNC_TASK::then::Invalid task.");
+		AsyncTask<U> _next(std::make_shared<typename AsyncTask<U>::State>(state->jobs));
+		std::shared_ptr<State> _state = state;
+		onReady([_state, _next, _thread, _func]() {
+			dispatch(*_state->jobs, _thread, [_state, _next, _func]() mutable {
+				if (_state->error) {
+					_next.finish(nullptr, _state->error);
+					return;
+				}
+				auto _stage = [&_state, &_func]() { return _func(_state->value); };
+				_next.complete(_stage);
+			});
+		});
+		return _next;
+	}
+
+	/**
+	*	\brief Constructs task that is made ready later by resolve or reject.
+	*	Connects callback based sources (I/O completions) to pipelines.
+	*	\throw std::bad_alloc
+	**/
+	static AsyncTask deferred(JobSystem& _jobs) { return AsyncTask(std::make_shared<State>(&_jobs)); }
+
+	//Stores '_value' as result of deferred task and starts waiting stages, must be called once
+	void resolve(T _value) { finish(&_value, nullptr); }
+
+	//Stores '_error' as failure of deferred task and starts waiting stages, must be called once
+	void reject(std::exception_ptr _error) { finish(nullptr, _error); }
+
+	//Checks that task refers to result
+	inline bool valid() const NOEXCEPT { return state != nullptr; }
+
+	//Checks that result or exception is stored
+	bool isReady() const {
+		std::lock_guard<std::mutex> _lock(state->lock);
+		return state->ready;
+	}
+
+	/**
+	*	\brief Returns when task is ready, runs other jobs meanwhile.
+	*	Task with MAIN stages must be waited on main thread or main thread must pump them.
+	*	\throw nothrow
+	**/
+	void wait() const {
+		while (!isReady())
+			if (!state->jobs->help())
+				std::this_thread::yield();
+	}
+
+	/**
+	*	\brief Waits for task and returns its result.
+	*	\throw Exception of failed stage.
+	*	\return Copy of result.
+	**/
+	T get() const {
+		wait();
+		if (state->error)
+			std::rethrow_exception(state->error);
+		return state->value;
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#ifndef COWPAYLOAD_H
+#define COWPAYLOAD_H "[multi@cCowPayload.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of copy-on-write payload holder.
+*		Objects that keep big payload (vertex data, pixels) in CowPayload member
+*		are copied without payload copy: copies share one payload block until
+*		first mutation of one of them.
+*		Polymorphic maps copy objects by their copy-constructor (newCopy, copyObject),
+*		so such map copies share payload too.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <atomic>
+#include <utility>
+//OUR
+#include "general/vs2013tweaks.h"
+
+template < class T >
+/**
+*	\brief Holder of payload shared by copies until first mutation.
+*	Read access never copies. Write access copies payload if it is shared with other holders.
+*	Holders of one block are counted by atomic counter: write reads it with acquire order,
+*	so reads made by holder released on other thread happen before mutation.
+*	Different holders may be used from different threads, one holder must not be
+*	written and copied simultaneously.
+*	Class template definition: CowPayload
+**/
+class CowPayload {
+	/**
+	*	Payload with count of its holders.
+	**/
+	struct Block {
+		std::atomic<unsigned int> holders;
+		T value;
+
+		template < class... TArgs >
+		explicit Block(TArgs&&... _args) : holders(1), value(std::forward<TArgs>(_args)...) {}
+	};
+	//Payload block, never nullptr except moved-from state
+	Block* payload;
+
+	//Adds this holder to block
+	void acquire() NOEXCEPT {
+		if (payload)
+			payload->holders.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//Removes this holder from block: last holder deletes it
+	void release() NOEXCEPT {
+		if (payload && payload->holders.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete payload;
+		payload = nullptr;
+	}
+public:
+	CowPayload() : payload(new Block()) {}
+
+	explicit CowPayload(const T& _value) : payload(new Block(_value)) {}
+
+	explicit CowPayload(T&& _value) : payload(new Block(std::move(_value))) {}
+
+	~CowPayload() NOEXCEPT { release(); }
+
+	//Copy shares payload block
+	CowPayload(const CowPayload& other) NOEXCEPT : payload(other.payload) { acquire(); }
+
+	CowPayload& operator=(const CowPayload& other) NOEXCEPT {
+		if (other.payload == payload)
+			return *this;
+		release();
+		payload = other.payload;
+		acquire();
+		return *this;
+	}
+
+	CowPayload(CowPayload&& other) NOEXCEPT : payload(other.payload) { other.payload = nullptr; }
+
+	CowPayload& operator=(CowPayload&& other) NOEXCEPT {
+		if (&other == this)
+			return *this;
+		release();
+		payload = other.payload;
+		other.payload = nullptr;
+		return *this;
+	}
+
+	/**
+	*	Read-only access to payload.
+	**/
+	inline const T& read() const NOEXCEPT { return payload->value; }
+
+	inline const T& operator*() const NOEXCEPT { return payload->value; }
+
+	inline const T* operator->() const NOEXCEPT { return &payload->value; }
+
+	/**
+	*	\brief Mutable access to payload.
+	*	Payload is copied to new block first if it is shared with other holders.
+	*	Returned reference is valid until holder is copied or assigned.
+	*	\throw std::bad_alloc, exceptions of T copy constructor.
+	*	\return Reference to payload owned by this holder only.
+	**/
+	T& write() {
+		if (payload->holders.load(std::memory_order_acquire) > 1) {
+			Block* _copy = new Block(payload->value);
+			release();
+			payload = _copy;
+		}
+		return payload->value;
+	}
+
+	/**
+	*	Replaces payload, no copy of old payload is made.
+	**/
+	void reset(T&& _value) {
+		Block* _block = new Block(std::move(_value));
+		release();
+		payload = _block;
+	}
+
+	//Checks that payload block is shared with other holders
+	inline bool isShared() const NOEXCEPT { return payload->holders.load(std::memory_order_acquire) > 1; }
+
+	//Address of payload: equal for holders that share payload
+	inline const void* block() const NOEXCEPT { return &payload->value; }
+};
+#endif
\ No newline at end of file
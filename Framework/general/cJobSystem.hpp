@@ -0,0 +1,531 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H "[multi@cJobSystem.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of work-stealing job scheduler.
+*		Every worker owns Chase-Lev deque: owner pushes and pops at bottom,
+*		idle workers steal from top. Jobs submitted from other threads go to
+*		shared queue, jobs that must run on main (GL context) thread go to main queue.
+*		Completion is tracked by counters: thread waiting for counter runs other jobs.
+*		Reference:
+*			N.M. Le, A. Pop, A. Cohen, F. Zappa Nardelli
+*			"Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+//OUR
+#include "general/vs2013tweaks.h"
+
+#ifndef JOBSYSTEM_DEQUE_CAPACITY
+	//Initial capacity of worker deque, must be power of 2
+	#define JOBSYSTEM_DEQUE_CAPACITY 1024
+#endif
+
+#ifndef JOBSYSTEM_SPIN_COUNT
+	//Count of failed searches for work before idle worker sleeps
+	#define JOBSYSTEM_SPIN_COUNT 64
+#endif
+
+/**
+*	\brief Work-stealing scheduler of small jobs.
+*	Jobs must not throw: exception leaving job terminates program.
+*	Class definition: JobSystem
+**/
+class JobSystem {
+	struct Job;
+public:
+	/**
+	*	\brief Count of unfinished jobs attached to it.
+	*	Jobs may be scheduled to start after counter reaches zero (see runAfter).
+	*	Counter must outlive its jobs: wait for it before destruction.
+	*	Class definition: Counter
+	**/
+	class Counter {
+		friend class JobSystem;
+		std::atomic<int> pending;
+		//Guards 'continuations' and transition to zero
+		std::mutex lock;
+		//Jobs to be scheduled when counter reaches zero
+		std::vector<Job*> continuations;
+	public:
+		Counter() : pending(0) {}
+
+		Counter(const Counter&) = delete;
+
+		Counter& operator=(const Counter&) = delete;
+
+		//Checks that all attached jobs are finished
+		inline bool done() const NOEXCEPT { return pending.load() == 0; }
+	};
+private:
+	/**
+	*	Scheduled function and counter to be decremented after it.
+	**/
+	struct Job {
+		std::function<void()> func;
+		Counter* counter;
+
+		Job(std::function<void()>&& _func, Counter* _counter) : func(std::move(_func)), counter(_counter) {}
+	};
+
+	/**
+	*	\brief Chase-Lev deque of jobs.
+	*	push and pop are called by owner only, steal by any thread.
+	*	Rings replaced on growth are kept until destruction: thieves may still read them.
+	*	Class definition: WorkDeque
+	**/
+	class WorkDeque {
+		struct Ring {
+			std::int64_t mask;
+			std::unique_ptr< std::atomic<Job*>[] > slots;
+
+			explicit Ring(std::int64_t _capacity) : mask(_capacity - 1), slots(new std::atomic<Job*>[(size_t)_capacity]) {}
+
+			inline Job* get(std::int64_t _index) const NOEXCEPT { return slots[(size_t)(_index & mask)].load(std::memory_order_relaxed); }
+
+			inline void put(std::int64_t _index, Job* _job) NOEXCEPT { slots[(size_t)(_index & mask)].store(_job, std::memory_order_relaxed); }
+		};
+
+		std::atomic<std::int64_t> top;
+		std::atomic<std::int64_t> bottom;
+		std::atomic<Ring*> ring;
+		//All rings ever used, current is last
+		std::vector< std::unique_ptr<Ring> > rings;
+
+		//Doubles ring capacity, called by owner
+		Ring* grow(Ring* _old, std::int64_t _top, std::int64_t _bottom) {
+			rings.emplace_back(new Ring((_old->mask + 1) * 2));
+			Ring* _new = rings.back().get();
+			for (std::int64_t _index = _top; _index < _bottom; _index++)
+				_new->put(_index, _old->get(_index));
+			ring.store(_new, std::memory_order_release);
+			return _new;
+		}
+	public:
+		WorkDeque() : top(0), bottom(0) {
+			rings.emplace_back(new Ring(JOBSYSTEM_DEQUE_CAPACITY));
+			ring.store(rings.back().get());
+		}
+
+		void push(Job* _job) {
+			std::int64_t _bottom = bottom.load(std::memory_order_relaxed);
+			std::int64_t _top = top.load(std::memory_order_acquire);
+			Ring* _ring = ring.load(std::memory_order_relaxed);
+			if (_bottom - _top > _ring->mask)
+				_ring = grow(_ring, _top, _bottom);
+			_ring->put(_bottom, _job);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom.store(_bottom + 1, std::memory_order_relaxed);
+		}
+
+		Job* pop() NOEXCEPT {
+			std::int64_t _bottom = bottom.load(std::memory_order_relaxed) - 1;
+			Ring* _ring = ring.load(std::memory_order_relaxed);
+			bottom.store(_bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t _top = top.load(std::memory_order_relaxed);
+			if (_top > _bottom) {
+				bottom.store(_bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			Job* _job = _ring->get(_bottom);
+			if (_top == _bottom) {
+				//Last job: race with thieves
+				if (!top.compare_exchange_strong(_top, _top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					_job = nullptr;
+				bottom.store(_bottom + 1, std::memory_order_relaxed);
+			}
+			return _job;
+		}
+
+		Job* steal() NOEXCEPT {
+			std::int64_t _top = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t _bottom = bottom.load(std::memory_order_acquire);
+			if (_top >= _bottom)
+				return nullptr;
+			Job* _job = ring.load(std::memory_order_acquire)->get(_top);
+			if (!top.compare_exchange_strong(_top, _top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return _job;
+		}
+	};
+
+	struct Worker {
+		WorkDeque deque;
+		std::thread thread;
+		std::thread::id id;
+	};
+
+	std::vector< std::unique_ptr<Worker> > workers;
+	//Jobs submitted by non-worker threads
+	std::deque<Job*> shared;
+	std::mutex sharedLock;
+	//Jobs that must run on main thread
+	std::deque<Job*> mainQueue;
+	std::mutex mainLock;
+	std::thread::id mainThread;
+	//Idle workers sleep here
+	std::mutex sleepLock;
+	std::condition_variable sleep;
+	std::atomic<int> sleepers;
+	std::atomic<bool> stopping;
+	//Workers start after all worker ids are known
+	std::atomic<bool> started;
+
+	//Index of worker running on current thread, -1 for other threads
+	int currentWorker() const NOEXCEPT {
+		std::thread::id _id = std::this_thread::get_id();
+		for (size_t _index = 0; _index < workers.size(); _index++)
+			if (workers[_index]->id == _id)
+				return (int)_index;
+		return -1;
+	}
+
+	//Wakes one sleeping worker
+	inline void notify() {
+		if (sleepers.load()) {
+			std::lock_guard<std::mutex> _lock(sleepLock);
+			sleep.notify_one();
+		}
+	}
+
+	//Places ready job to deque of current worker or to shared queue
+	void schedule(Job* _job) {
+		int _worker = currentWorker();
+		if (_worker >= 0) {
+			workers[(size_t)_worker]->deque.push(_job);
+		} else {
+			std::lock_guard<std::mutex> _lock(sharedLock);
+			shared.push_back(_job);
+		}
+		notify();
+	}
+
+	Job* popShared() {
+		std::lock_guard<std::mutex> _lock(sharedLock);
+		if (shared.empty())
+			return nullptr;
+		Job* _job = shared.front();
+		shared.pop_front();
+		return _job;
+	}
+
+	Job* popMain() {
+		std::lock_guard<std::mutex> _lock(mainLock);
+		if (mainQueue.empty())
+			return nullptr;
+		Job* _job = mainQueue.front();
+		mainQueue.pop_front();
+		return _job;
+	}
+
+	/**
+	*	\brief Finds job for thread with worker index '_worker'.
+	*	Order: own deque, shared queue, deques of other workers starting from '_victim'.
+	**/
+	Job* findWork(int _worker, size_t _victim) {
+		Job* _job = nullptr;
+		if (_worker >= 0 && (_job = workers[(size_t)_worker]->deque.pop()))
+			return _job;
+		if ((_job = popShared()))
+			return _job;
+		for (size_t _index = 0; _index < workers.size(); _index++) {
+			size_t _other = (_victim + _index) % workers.size();
+			if ((int)_other == _worker)
+				continue;
+			if ((_job = workers[_other]->deque.steal()))
+				return _job;
+		}
+		return nullptr;
+	}
+
+	//Runs job, finishes its counter and schedules continuations
+	void execute(Job* _job) NOEXCEPT {
+		_job->func();
+		Counter* _counter = _job->counter;
+		delete _job;
+		if (!_counter)
+			return;
+		std::vector<Job*> _ready;
+		{
+			std::lock_guard<std::mutex> _lock(_counter->lock);
+			if (_counter->pending.fetch_sub(1) == 1)
+				_ready.swap(_counter->continuations);
+		}
+		for (Job* _next : _ready)
+			schedule(_next);
+	}
+
+	//Worker thread loop
+	void work(size_t _worker) {
+		while (!started.load())
+			std::this_thread::yield();
+		size_t _victim = _worker + 1;
+		unsigned int _spins = 0;
+		for (;;) {
+			Job* _job = findWork((int)_worker, _victim++);
+			if (_job) {
+				execute(_job);
+				_spins = 0;
+				continue;
+			}
+			if (stopping.load())
+				return;
+			if (++_spins < JOBSYSTEM_SPIN_COUNT) {
+				std::this_thread::yield();
+				continue;
+			}
+			//Timeout bounds wake up lost between search and sleep
+			std::unique_lock<std::mutex> _lock(sleepLock);
+			sleepers.fetch_add(1);
+			sleep.wait_for(_lock, std::chrono::milliseconds(1));
+			sleepers.fetch_sub(1);
+			_spins = 0;
+		}
+	}
+public:
+	/**
+	*	\brief Starts '_workers' worker threads.
+	*	Thread that constructs job system becomes main thread.
+	*	\throw std::system_error If thread can't be started.
+	**/
+	explicit JobSystem(unsigned int _workers) : mainThread(std::this_thread::get_id()), sleepers(0), stopping(false), started(false) {
+		for (unsigned int _index = 0; _index < _workers; _index++)
+			workers.emplace_back(new Worker());
+		for (unsigned int _index = 0; _index < _workers; _index++) {
+			workers[_index]->thread = std::thread([this, _index]() { work(_index); });
+			workers[_index]->id = workers[_index]->thread.get_id();
+		}
+		//Ids are never changed after start: currentWorker reads them without lock
+		started.store(true);
+	}
+
+	/**
+	*	\brief Joins workers after they run out of jobs.
+	*	Jobs left in main and shared queues are run on destroying thread.
+	**/
+	~JobSystem() NOEXCEPT {
+		stopping.store(true);
+		{
+			std::lock_guard<std::mutex> _lock(sleepLock);
+			sleep.notify_all();
+		}
+		for (auto& _worker : workers)
+			_worker->thread.join();
+		for (;;) {
+			Job* _job = popMain();
+			if (!_job)
+				_job = popShared();
+			if (!_job)
+				break;
+			execute(_job);
+		}
+	}
+
+	JobSystem(const JobSystem&) = delete;
+
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	//Count of worker threads
+	inline unsigned int size() const NOEXCEPT { return (unsigned int)workers.size(); }
+
+	//Checks that current thread is main thread
+	inline bool isMainThread() const NOEXCEPT { return std::this_thread::get_id() == mainThread; }
+
+	/**
+	*	\brief Makes current thread main thread: thread that runs main queue (owner of GL context).
+	**/
+	inline void bindMainThread() NOEXCEPT { mainThread = std::this_thread::get_id(); }
+
+	/**
+	*	\brief Schedules '_func' to be run by any thread.
+	*	\param[in]	_func		Job function.
+	*	\param[in]	_counter	[Optional] Counter incremented now and decremented after job.
+	*	\throw std::bad_alloc
+	**/
+	void run(std::function<void()> _func, Counter* _counter = nullptr) {
+		if (_counter)
+			_counter->pending.fetch_add(1);
+		schedule(new Job(std::move(_func), _counter));
+	}
+
+	/**
+	*	\brief Schedules '_func' to be run after all jobs of '_dependency' are finished.
+	*	'_counter' is incremented now, so chains of dependent jobs may be built before any of them runs.
+	*	'_counter' must differ from '_dependency': job would wait for itself.
+	*	\param[in]	_dependency	Counter to wait for.
+	*	\param[in]	_func		Job function.
+	*	\param[in]	_counter	[Optional] Counter incremented now and decremented after job.
+	*	\throw std::bad_alloc
+	**/
+	void runAfter(Counter& _dependency, std::function<void()> _func, Counter* _counter = nullptr) {
+		if (_counter)
+			_counter->pending.fetch_add(1);
+		Job* _job = new Job(std::move(_func), _counter);
+		{
+			std::lock_guard<std::mutex> _lock(_dependency.lock);
+			if (_dependency.pending.load()) {
+				_dependency.continuations.push_back(_job);
+				return;
+			}
+		}
+		schedule(_job);
+	}
+
+	/**
+	*	\brief Schedules '_func' to be run on main thread (jobs that touch GL context).
+	*	Main queue is run by wait and pumpMain called on main thread.
+	*	\param[in]	_func		Job function.
+	*	\param[in]	_counter	[Optional] Counter incremented now and decremented after job.
+	*	\throw std::bad_alloc
+	**/
+	void runOnMain(std::function<void()> _func, Counter* _counter = nullptr) {
+		if (_counter)
+			_counter->pending.fetch_add(1);
+		std::lock_guard<std::mutex> _lock(mainLock);
+		mainQueue.push_back(new Job(std::move(_func), _counter));
+	}
+
+	/**
+	*	\brief Runs jobs of main queue, call once per frame on main thread.
+	*	Without workers jobs of shared queue are run too: nothing else runs them between waits.
+	*	\param[in]	_limit	Max count of jobs to run, 0 for all queued.
+	*	\return Count of run jobs.
+	**/
+	unsigned int pumpMain(unsigned int _limit = 0) {
+		if (!isMainThread())
+			return 0;
+		unsigned int _count = 0;
+		Job* _job = nullptr;
+		while ((!_limit || _count < _limit) && (_job = popMain())) {
+			execute(_job);
+			_count++;
+		}
+		while (workers.empty() && (!_limit || _count < _limit) && (_job = findWork(-1, 0))) {
+			execute(_job);
+			_count++;
+			//Continuations of shared jobs are run in same pump
+			while ((!_limit || _count < _limit) && (_job = popMain())) {
+				execute(_job);
+				_count++;
+			}
+		}
+		return _count;
+	}
+
+	/**
+	*	\brief Returns when all jobs of '_counter' are finished.
+	*	Waiting thread runs other jobs meanwhile: own and stolen ones, and main queue if it is main thread.
+	*	Waiting for main queue job on other thread blocks until main thread pumps it.
+	*	\throw nothrow
+	**/
+	void wait(Counter& _counter) {
+		int _worker = currentWorker();
+		bool _main = isMainThread();
+		size_t _victim = _worker >= 0 ? (size_t)_worker + 1 : 0;
+		while (!_counter.done()) {
+			Job* _job = _main ? popMain() : nullptr;
+			if (!_job)
+				_job = findWork(_worker, _victim++);
+			if (_job)
+				execute(_job);
+			else
+				std::this_thread::yield();
+		}
+		//Last finisher may still hold counter lock
+		std::lock_guard<std::mutex> _lock(_counter.lock);
+	}
+
+	/**
+	*	\brief Runs one available job on calling thread: main queue job if it is main thread, then own, shared or stolen one.
+	*	Lets threads wait for conditions other than counters without blocking workers.
+	*	\throw nothrow
+	*	\return True if job was run.
+	**/
+	bool help() {
+		Job* _job = isMainThread() ? popMain() : nullptr;
+		if (!_job) {
+			int _worker = currentWorker();
+			_job = findWork(_worker, _worker >= 0 ? (size_t)_worker + 1 : 0);
+		}
+		if (!_job)
+			return false;
+		execute(_job);
+		return true;
+	}
+
+	template < class TFunc >
+	/**
+	*	\brief Calls '_func(begin, end)' for chunks of range [0, _count) in parallel and waits for them.
+	*	Chunks are '_grain' long (last may be shorter). One job per worker is scheduled, jobs and
+	*	calling thread take chunks from shared position, so job count doesn't grow with '_count'.
+	*	\param[in]	_count	Length of index range.
+	*	\param[in]	_grain	Count of indexes in one chunk, 0 is treated as 1.
+	*	Chunks that throw don't stop the loop: first exception is rethrown after all chunks are processed.
+	*	\param[in]	_func	Functor with signature void(size_t begin, size_t end).
+	*	\throw First exception thrown by '_func', std::bad_alloc.
+	**/
+	void parallelFor(size_t _count, size_t _grain, TFunc _func) {
+		if (!_count)
+			return;
+		if (!_grain)
+			_grain = 1;
+		size_t _chunks = (_count + _grain - 1) / _grain;
+		std::atomic<size_t> _next(0);
+		std::exception_ptr _error;
+		std::mutex _errorLock;
+		auto _chunk = [&_next, &_func, &_error, &_errorLock, _chunks, _count, _grain]() {
+			for (size_t _index = _next.fetch_add(1); _index < _chunks; _index = _next.fetch_add(1)) {
+				try { _func(_index * _grain, std::min(_index * _grain + _grain, _count)); }
+				catch (...) {
+					std::lock_guard<std::mutex> _lock(_errorLock);
+					if (!_error)
+						_error = std::current_exception();
+				}
+			}
+		};
+		Counter _counter;
+		{
+			//Helpers reference this frame: wait for them even if scheduling throws
+			struct WaitGuard {
+				JobSystem& system;
+				Counter& counter;
+				~WaitGuard() { system.wait(counter); }
+			} _guard{ *this, _counter };
+			size_t _helpers = std::min<size_t>(_chunks - 1, workers.size());
+			for (size_t _index = 0; _index < _helpers; _index++)
+				run(_chunk, &_counter);
+			_chunk();
+		}
+		if (_error)
+			std::rethrow_exception(_error);
+	}
+
+	/**
+	*	\brief Job system shared by framework subsystems.
+	*	Has one worker less than hardware threads: main thread is the last one.
+	*	At least one worker is started, so jobs run without help of waiting threads on single core.
+	*	Main thread is the thread of first call.
+	**/
+	static JobSystem& global() {
+		static JobSystem _system(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+		return _system;
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,194 @@
+#ifndef LZ4_H
+#define LZ4_H "[multi@cLz4.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains self-contained implementation of LZ4 block format codec.
+*		Output of compress is readable by reference LZ4_decompress_safe and
+*		decompress reads blocks made by reference LZ4_compress_default.
+*		Compressor is greedy single-pass one: it is used offline by pack baking,
+*		decompressor is the fast part used at load time.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+//OUR
+#include "general/vs2013tweaks.h"
+
+namespace lz4 {
+
+	//Count of hash table entries of compressor, power of two
+	CONST_OR_CONSTEXPR unsigned int HASH_LOG = 12;
+	//Minimal match length of format
+	CONST_OR_CONSTEXPR size_t MIN_MATCH = 4;
+	//Last bytes of block that are always literals
+	CONST_OR_CONSTEXPR size_t LAST_LITERALS = 5;
+	//Match can't start in last bytes of block
+	CONST_OR_CONSTEXPR size_t MATCH_LIMIT = 12;
+	//Maximal distance to match
+	CONST_OR_CONSTEXPR size_t MAX_OFFSET = 0xFFFF;
+
+	/**
+	*	\brief Maximal size of compressed block of '_size' bytes.
+	*	\throw nothrow
+	**/
+	inline size_t compressBound(size_t _size) NOEXCEPT { return _size + _size / 255 + 16; }
+
+	/**
+	*	\brief Writes length extension bytes of '_length' to '_out'.
+	*	\throw nothrow
+	*	\return Position after written bytes, nullptr if '_end' is reached.
+	**/
+	inline unsigned char* writeLength(unsigned char* _out, unsigned char* _end, size_t _length) NOEXCEPT {
+		for (; _length >= 255; _length -= 255) {
+			if (_out >= _end)
+				return nullptr;
+			*_out++ = 255;
+		}
+		if (_out >= _end)
+			return nullptr;
+		*_out++ = (unsigned char)_length;
+		return _out;
+	}
+
+	/**
+	*	\brief Writes one sequence: literals [_literals, _literals + _count) and match of '_match' bytes '_offset' back.
+	*	Sequence without match ('_match' is 0) must be the last one.
+	*	\throw nothrow
+	*	\return Position after sequence, nullptr if '_end' is reached.
+	**/
+	inline unsigned char* writeSequence(unsigned char* _out, unsigned char* _end, const unsigned char* _literals, size_t _count, size_t _offset, size_t _match) NOEXCEPT {
+		if (_out >= _end)
+			return nullptr;
+		unsigned char* _token = _out++;
+		*_token = (unsigned char)((_count >= 15 ? 15 : _count) << 4);
+		if (_count >= 15 && !(_out = writeLength(_out, _end, _count - 15)))
+			return nullptr;
+		if ((size_t)(_end - _out) < _count)
+			return nullptr;
+		std::memcpy(_out, _literals, _count);
+		_out += _count;
+		if (!_match)
+			return _out;
+		if (_end - _out < 2)
+			return nullptr;
+		*_out++ = (unsigned char)(_offset & 0xFF);
+		*_out++ = (unsigned char)(_offset >> 8);
+		size_t _length = _match - MIN_MATCH;
+		*_token |= (unsigned char)(_length >= 15 ? 15 : _length);
+		if (_length >= 15 && !(_out = writeLength(_out, _end, _length - 15)))
+			return nullptr;
+		return _out;
+	}
+
+	/**
+	*	\brief Compresses '_size' bytes of '_source' to LZ4 block in '_destination'.
+	*	\param[in]	_source			Data to be compressed.
+	*	\param[in]	_size			Size of data.
+	*	\param[out]	_destination	Buffer of compressed block.
+	*	\param[in]	_capacity		Size of '_destination', compressBound(_size) is always enough.
+	*	\throw nothrow
+	*	\return Size of compressed block, 0 if '_capacity' isn't enough.
+	**/
+	inline size_t compress(const char* _source, size_t _size, char* _destination, size_t _capacity) NOEXCEPT {
+		const unsigned char* _in = (const unsigned char*)_source;
+		unsigned char* _out = (unsigned char*)_destination;
+		unsigned char* _end = _out + _capacity;
+		size_t _anchor = 0;
+		if (_size > MATCH_LIMIT) {
+			//Positions are stored plus one: zero is empty entry
+			std::vector<uint32_t> _table((size_t)1 << HASH_LOG, 0);
+			size_t _position = 0;
+			while (_position < _size - MATCH_LIMIT) {
+				uint32_t _sequence;
+				std::memcpy(&_sequence, _in + _position, sizeof(_sequence));
+				uint32_t _hash = (_sequence * 2654435761u) >> (32 - HASH_LOG);
+				size_t _candidate = _table[_hash];
+				_table[_hash] = (uint32_t)(_position + 1);
+				uint32_t _other;
+				if (!_candidate || _position + 1 - _candidate > MAX_OFFSET ||
+					(std::memcpy(&_other, _in + _candidate - 1, sizeof(_other)), _other != _sequence))
+				{
+					_position++;
+					continue;
+				}
+				_candidate--;
+				size_t _match = MIN_MATCH;
+				while (_position + _match < _size - LAST_LITERALS && _in[_candidate + _match] == _in[_position + _match])
+					_match++;
+				_out = writeSequence(_out, _end, _in + _anchor, _position - _anchor, _position - _candidate, _match);
+				if (!_out)
+					return 0;
+				_position += _match;
+				_anchor = _position;
+			}
+		}
+		_out = writeSequence(_out, _end, _in + _anchor, _size - _anchor, 0, 0);
+		return _out ? (size_t)(_out - (unsigned char*)_destination) : 0;
+	}
+
+	/**
+	*	\brief Decompresses LZ4 block '_source' of '_size' bytes to exactly '_length' bytes of '_destination'.
+	*	Malformed block never makes read or write out of buffers.
+	*	\throw nothrow
+	*	\return False if block is malformed or its content isn't '_length' bytes long.
+	**/
+	inline bool decompress(const char* _source, size_t _size, char* _destination, size_t _length) NOEXCEPT {
+		const unsigned char* _in = (const unsigned char*)_source;
+		const unsigned char* _inEnd = _in + _size;
+		unsigned char* _out = (unsigned char*)_destination;
+		unsigned char* _outEnd = _out + _length;
+		while (_in < _inEnd) {
+			unsigned int _token = *_in++;
+			size_t _count = _token >> 4;
+			if (_count == 15) {
+				unsigned char _byte;
+				do {
+					if (_in >= _inEnd)
+						return false;
+					_byte = *_in++;
+					_count += _byte;
+				} while (_byte == 255);
+			}
+			if ((size_t)(_inEnd - _in) < _count || (size_t)(_outEnd - _out) < _count)
+				return false;
+			std::memcpy(_out, _in, _count);
+			_in += _count;
+			_out += _count;
+			//Last sequence has no match
+			if (_in == _inEnd)
+				break;
+			if (_inEnd - _in < 2)
+				return false;
+			size_t _offset = (size_t)_in[0] | ((size_t)_in[1] << 8);
+			_in += 2;
+			if (!_offset || _offset > (size_t)(_out - (unsigned char*)_destination))
+				return false;
+			size_t _match = _token & 15;
+			if (_match == 15) {
+				unsigned char _byte;
+				do {
+					if (_in >= _inEnd)
+						return false;
+					_byte = *_in++;
+					_match += _byte;
+				} while (_byte == 255);
+			}
+			_match += MIN_MATCH;
+			if ((size_t)(_outEnd - _out) < _match)
+				return false;
+			//Match may overlap output: copy byte by byte
+			const unsigned char* _from = _out - _offset;
+			for (size_t _index = 0; _index < _match; _index++)
+				_out[_index] = _from[_index];
+			_out += _match;
+		}
+		return _out == _outEnd;
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,278 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H "[multi@cMappedFile.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of read-write and read-only memory mapped file.
+*		POSIX mmap and Win32 file mapping are supported.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <cstddef>
+//PLATFORM
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+//OUR
+#include "general/vs2013tweaks.h"
+
+/**
+*	\brief Read-write shared mapping of whole file to memory.
+*	Changes of mapped memory are written to file by system.
+*	Class is movable but not copyable.
+*	Class definition: MappedFile
+**/
+class MappedFile {
+	//Address of mapped memory
+	void* address;
+	//Length of mapping
+	size_t length;
+	#if defined(_WIN32)
+		HANDLE file;
+		HANDLE mapping;
+	#else
+		int file;
+	#endif
+
+	//Closes system handles without unmapping
+	void closeHandles() NOEXCEPT {
+		#if defined(_WIN32)
+			if (mapping)
+				CloseHandle(mapping);
+			if (file != INVALID_HANDLE_VALUE)
+				CloseHandle(file);
+			mapping = NULL;
+			file = INVALID_HANDLE_VALUE;
+		#else
+			if (file != -1)
+				::close(file);
+			file = -1;
+		#endif
+	}
+public:
+	#if defined(_WIN32)
+		MappedFile() NOEXCEPT : address(nullptr), length(0), file(INVALID_HANDLE_VALUE), mapping(NULL) {}
+	#else
+		MappedFile() NOEXCEPT : address(nullptr), length(0), file(-1) {}
+	#endif
+
+	~MappedFile() NOEXCEPT { close(); }
+
+	MappedFile(const MappedFile&) = delete;
+
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) NOEXCEPT : address(other.address), length(other.length), file(other.file)
+	{
+		#if defined(_WIN32)
+			mapping = other.mapping;
+			other.mapping = NULL;
+			other.file = INVALID_HANDLE_VALUE;
+		#else
+			other.file = -1;
+		#endif
+		other.address = nullptr;
+		other.length = 0;
+	}
+
+	MappedFile& operator=(MappedFile&& other) NOEXCEPT {
+		if (&other == this)
+			return *this;
+		close();
+		address = other.address;
+		length = other.length;
+		file = other.file;
+		#if defined(_WIN32)
+			mapping = other.mapping;
+			other.mapping = NULL;
+			other.file = INVALID_HANDLE_VALUE;
+		#else
+			other.file = -1;
+		#endif
+		other.address = nullptr;
+		other.length = 0;
+		return *this;
+	}
+
+	/**
+	*	\brief Maps file '_path' to memory.
+	*	If file is shorter than '_minLength' it is created or extended with zero bytes up to '_minLength'.
+	*	\param[in]	_path		Path to file.
+	*	\param[in]	_minLength	Minimal length of file, 0 to map file as is.
+	*	\throw nothrow
+	*	\return Success of mapping.
+	**/
+	bool open(const char* _path, size_t _minLength = 0) NOEXCEPT {
+		close();
+		#if defined(_WIN32)
+			file = CreateFileA(_path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (file == INVALID_HANDLE_VALUE)
+				return false;
+			LARGE_INTEGER _size;
+			if (!GetFileSizeEx(file, &_size)) {
+				closeHandles();
+				return false;
+			}
+			length = (size_t)_size.QuadPart;
+			if (length < _minLength)
+				length = _minLength;
+			if (!length) {
+				closeHandles();
+				return false;
+			}
+			//Mapping of bigger size extends file
+			mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)length >> 32), (DWORD)(length & 0xFFFFFFFF), NULL);
+			if (!mapping) {
+				closeHandles();
+				return false;
+			}
+			address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, length);
+		#else
+			file = ::open(_path, O_RDWR | O_CREAT, 0644);
+			if (file == -1)
+				return false;
+			struct stat _stat;
+			if (fstat(file, &_stat) == -1) {
+				closeHandles();
+				return false;
+			}
+			length = (size_t)_stat.st_size;
+			if (length < _minLength) {
+				if (ftruncate(file, (off_t)_minLength) == -1) {
+					closeHandles();
+					return false;
+				}
+				length = _minLength;
+			}
+			if (!length) {
+				closeHandles();
+				return false;
+			}
+			address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+			if (address == MAP_FAILED)
+				address = nullptr;
+		#endif
+		if (!address) {
+			closeHandles();
+			length = 0;
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	*	\brief Maps existing file '_path' to memory for reading only.
+	*	Writing to mapped memory is an access violation. Empty file can't be mapped.
+	*	\param[in]	_path	Path to file.
+	*	\throw nothrow
+	*	\return Success of mapping.
+	**/
+	bool openReadOnly(const char* _path) NOEXCEPT {
+		close();
+		#if defined(_WIN32)
+			file = CreateFileA(_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (file == INVALID_HANDLE_VALUE)
+				return false;
+			LARGE_INTEGER _size;
+			if (!GetFileSizeEx(file, &_size) || !_size.QuadPart) {
+				closeHandles();
+				return false;
+			}
+			length = (size_t)_size.QuadPart;
+			mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (!mapping) {
+				closeHandles();
+				length = 0;
+				return false;
+			}
+			address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, length);
+		#else
+			file = ::open(_path, O_RDONLY);
+			if (file == -1)
+				return false;
+			struct stat _stat;
+			if (fstat(file, &_stat) == -1 || !_stat.st_size) {
+				closeHandles();
+				return false;
+			}
+			length = (size_t)_stat.st_size;
+			address = mmap(nullptr, length, PROT_READ, MAP_SHARED, file, 0);
+			if (address == MAP_FAILED)
+				address = nullptr;
+		#endif
+		if (!address) {
+			closeHandles();
+			length = 0;
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	*	\brief Requests system to write changed pages to file.
+	*	\throw nothrow
+	*	\return Success of request.
+	**/
+	bool sync() NOEXCEPT {
+		if (!address)
+			return false;
+		#if defined(_WIN32)
+			return FlushViewOfFile(address, length) != 0;
+		#else
+			return msync(address, length, MS_SYNC) == 0;
+		#endif
+	}
+
+	/**
+	*	\brief Advises system that whole mapping will be read soon: read ahead is started.
+	*	\throw nothrow
+	**/
+	void willNeed() NOEXCEPT {
+		#if !defined(_WIN32)
+			if (address)
+				madvise(address, length, MADV_WILLNEED);
+		#endif
+	}
+
+	/**
+	*	Unmaps file and closes it.
+	**/
+	void close() NOEXCEPT {
+		if (address) {
+			#if defined(_WIN32)
+				UnmapViewOfFile(address);
+			#else
+				munmap(address, length);
+			#endif
+		}
+		address = nullptr;
+		length = 0;
+		closeHandles();
+	}
+
+	//Checks that file is mapped
+	bool isOpen() const NOEXCEPT { return address != nullptr; }
+
+	//Address of mapped memory
+	void* data() NOEXCEPT { return address; }
+
+	//Address of mapped memory
+	const void* data() const NOEXCEPT { return address; }
+
+	//Length of mapped memory
+	size_t size() const NOEXCEPT { return length; }
+};
+#endif
\ No newline at end of file
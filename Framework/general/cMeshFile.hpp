@@ -0,0 +1,204 @@
+#ifndef MESHFILE_H
+#define MESHFILE_H "[multi@cMeshFile.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains definition of baked mesh file: buffers ready for glBufferData.
+*		Layout:
+*			Header (112 bytes) | vertex blob | index blob
+*		Vertex blob is interleaved GLfloat array, index blob is GLuint array of triangles.
+*		Blobs start at 16 byte boundary.
+*		Attributes are described as offset/length pairs in floats in order of
+*		CombinedMesh::Layout: position, color, texture coordinates, normal; -1 offset is absent one.
+*		Numbers are stored in little-endian byte order.
+*		MeshFileMapping maps file to memory: blobs are given to glBufferData
+*		without being copied by loader. Index blob is read once to check that
+*		indices are below count of vertices.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/cMappedFile.hpp"
+#include "general/cVirtualFileSystem.hpp"
+
+/**
+*	\brief Baked mesh file format.
+*	Struct definition: MeshFile
+**/
+struct MeshFile {
+	//Attributes in order of attribute locations
+	enum Attribute : uint32_t {
+		POSITION	= 0,
+		COLOR		= 1,
+		TEXCOORD	= 2,
+		NORMAL		= 3,
+		ATTRIBUTE_COUNT
+	};
+
+	//File header
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t vertexCount;
+		//Count of indices: three per triangle
+		uint32_t indexCount;
+		//Floats per vertex
+		uint32_t stride;
+		//Offset and length in floats of each attribute
+		int32_t attributes[ATTRIBUTE_COUNT][2];
+		float boundsMin[3];
+		float boundsMax[3];
+		uint32_t reserved;
+		uint64_t vertexOffset;
+		uint64_t vertexSize;
+		uint64_t indexOffset;
+		uint64_t indexSize;
+	};
+
+	static_assert(sizeof(Header) == 112, "MeshFile: unexpected padding of header");
+
+	//Magic bytes of mesh file
+	static const char* magic() NOEXCEPT { return "GMSH"; }
+
+	//Version of format
+	CONST_OR_CONSTEXPR static uint32_t VERSION = 1;
+
+	//Alignment of blobs
+	CONST_OR_CONSTEXPR static uint64_t ALIGNMENT = 16;
+
+	/**
+	*	\brief Checks that '_size' bytes of '_data' are valid mesh file.
+	*	Every index is checked to be below count of vertices: file may come from any mounted source.
+	*	\throw nothrow
+	*	\return Header of file or nullptr.
+	**/
+	static const Header* parse(const char* _data, size_t _size) NOEXCEPT {
+		if (!_data || _size < sizeof(Header))
+			return nullptr;
+		const Header* _header = (const Header*)_data;
+		if (std::memcmp(_header->magic, magic(), 4) || _header->version != VERSION || !_header->stride || _header->indexCount % 3)
+			return nullptr;
+		for (auto& _attribute : _header->attributes)
+			if (_attribute[0] >= 0 && (_attribute[1] <= 0 || (uint64_t)_attribute[0] + _attribute[1] > _header->stride))
+				return nullptr;
+		if (_header->attributes[POSITION][0] < 0)
+			return nullptr;
+		if (_header->vertexSize != (uint64_t)_header->vertexCount * _header->stride * sizeof(float) ||
+			_header->indexSize != (uint64_t)_header->indexCount * sizeof(uint32_t))
+			return nullptr;
+		if (_header->vertexOffset % ALIGNMENT || _header->indexOffset % ALIGNMENT ||
+			_header->vertexOffset > _size || _header->vertexSize > _size - _header->vertexOffset ||
+			_header->indexOffset > _size || _header->indexSize > _size - _header->indexOffset)
+			return nullptr;
+		const uint32_t* _indices = indices(_data);
+		for (uint32_t _index = 0; _index < _header->indexCount; _index++)
+			if (_indices[_index] >= _header->vertexCount)
+				return nullptr;
+		return _header;
+	}
+
+	//Vertex blob of valid file '_data'
+	static const float* vertices(const char* _data) NOEXCEPT { return (const float*)(_data + ((const Header*)_data)->vertexOffset); }
+
+	//Index blob of valid file '_data'
+	static const uint32_t* indices(const char* _data) NOEXCEPT { return (const uint32_t*)(_data + ((const Header*)_data)->indexOffset); }
+
+	/**
+	*	\brief Writes mesh file with header '_header', '_vertices' and '_indices' to '_out'.
+	*	Header fields of counts, offsets and sizes are set by this function.
+	*	\throw std::bad_alloc
+	**/
+	static void write(Header _header, const std::vector<float>& _vertices, const std::vector<uint32_t>& _indices, std::vector<char>& _out) {
+		std::memcpy(_header.magic, magic(), 4);
+		_header.version = VERSION;
+		_header.reserved = 0;
+		_header.vertexCount = (uint32_t)(_vertices.size() / _header.stride);
+		_header.indexCount = (uint32_t)_indices.size();
+		_header.vertexOffset = (sizeof(Header) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+		_header.vertexSize = _vertices.size() * sizeof(float);
+		_header.indexOffset = (_header.vertexOffset + _header.vertexSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+		_header.indexSize = _indices.size() * sizeof(uint32_t);
+		_out.assign((size_t)(_header.indexOffset + _header.indexSize), 0);
+		std::memcpy(_out.data(), &_header, sizeof(Header));
+		if (!_vertices.empty())
+			std::memcpy(_out.data() + _header.vertexOffset, _vertices.data(), (size_t)_header.vertexSize);
+		if (!_indices.empty())
+			std::memcpy(_out.data() + _header.indexOffset, _indices.data(), (size_t)_header.indexSize);
+	}
+};
+
+/**
+*	\brief Valid mesh file in memory.
+*	Stored entry of mounted pack is used in place, file on disk is mapped,
+*	other files (compressed pack entries) are read to buffer.
+*	Mapping must be kept until buffers are built from it.
+*	Class definition: MeshFileMapping
+**/
+class MeshFileMapping {
+	MappedFile file;
+	std::vector<char> buffer;
+	const char* data;
+	const MeshFile::Header* mesh;
+public:
+	MeshFileMapping() NOEXCEPT : data(nullptr), mesh(nullptr) {}
+
+	MeshFileMapping(const MeshFileMapping&) = delete;
+
+	MeshFileMapping& operator=(const MeshFileMapping&) = delete;
+
+	/**
+	*	\brief Opens mesh file '_path' found by '_fileSystem'.
+	*	Mapped file is the one '_fileSystem' would read: mounts take precedence over disk.
+	*	\throw std::bad_alloc
+	*	\return False if file isn't found or isn't valid mesh file.
+	**/
+	bool open(const std::string& _path, const VirtualFileSystem& _fileSystem = VirtualFileSystem::global()) {
+		close();
+		size_t _size = 0;
+		data = _fileSystem.view(_path, _size);
+		std::string _diskPath;
+		if (!data && _fileSystem.resolve(_path, _diskPath) && file.openReadOnly(_diskPath.c_str())) {
+			//Pages are read ahead while buffers are allocated
+			file.willNeed();
+			data = (const char*)file.data();
+			_size = file.size();
+		}
+		if (!data && _fileSystem.read(_path, buffer)) {
+			data = buffer.data();
+			_size = buffer.size();
+		}
+		mesh = MeshFile::parse(data, _size);
+		if (!mesh)
+			close();
+		return mesh != nullptr;
+	}
+
+	//Releases mapping or buffer
+	void close() NOEXCEPT {
+		file.close();
+		std::vector<char>().swap(buffer);
+		data = nullptr;
+		mesh = nullptr;
+	}
+
+	//Checks that mesh is open
+	inline bool isOpen() const NOEXCEPT { return mesh != nullptr; }
+
+	//Header of open mesh
+	inline const MeshFile::Header& header() const NOEXCEPT { return *mesh; }
+
+	//Vertex blob of open mesh
+	inline const float* vertices() const NOEXCEPT { return MeshFile::vertices(data); }
+
+	//Index blob of open mesh
+	inline const uint32_t* indices() const NOEXCEPT { return MeshFile::indices(data); }
+};
+#endif
\ No newline at end of file
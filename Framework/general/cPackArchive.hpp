@@ -0,0 +1,411 @@
+#ifndef PACKARCHIVE_H
+#define PACKARCHIVE_H "[multi@cPackArchive.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of pack archive: many asset files in one file.
+*		Layout:
+*			Header (32 bytes) | entry data ... | table of contents
+*			Table of contents: Entry[count] | uint32 slots[slotCount] | names
+*		Slots are open addressing hash table of FNV-1a hashes of entry names,
+*		slot value is entry index plus one, 0 is empty slot.
+*		Stored entries start at 4KiB boundary: they are used in place from mapped file.
+*		Compressed entries are LZ4 blocks, they are decompressed on read.
+*		Archive is opened by one mapping of whole file, no reads are made.
+*		Numbers are stored in little-endian byte order.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/cMappedFile.hpp"
+#include "general/cLz4.hpp"
+
+#ifndef PACKARCHIVE_ALIGNMENT
+	//Alignment of stored (not compressed) entries: page size
+	#define PACKARCHIVE_ALIGNMENT 0x1000
+#endif
+
+/**
+*	\brief Read-only pack archive.
+*	Lookups and reads may be done from many threads simultaneously.
+*	Class definition: PackArchive
+**/
+class PackArchive {
+public:
+	//Entry data encoding
+	enum Compression : uint8_t {
+		//Stored as is at aligned offset
+		STORED	= 0,
+		//LZ4 block
+		LZ4		= 1,
+		//Reserved for zstd frames, not supported by this build
+		ZSTD	= 2
+	};
+
+	//File header
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t count;
+		uint32_t slotCount;
+		uint64_t tocOffset;
+		uint64_t tocSize;
+	};
+
+	//Table of contents entry
+	struct Entry {
+		uint64_t hash;
+		uint64_t offset;
+		//Size of data in archive
+		uint64_t size;
+		//Size of data after decompression
+		uint64_t originalSize;
+		uint32_t nameOffset;
+		uint16_t nameLength;
+		uint8_t compression;
+		uint8_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 32 && sizeof(Entry) == 40, "PackArchive: unexpected padding of file structures");
+
+	//Magic bytes of pack file
+	static const char* magic() NOEXCEPT { return "GPAK"; }
+
+	//Version of format
+	CONST_OR_CONSTEXPR static uint32_t VERSION = 1;
+
+	/**
+	*	\brief FNV-1a hash of entry name.
+	*	\throw nothrow
+	**/
+	static uint64_t hash(const char* _name, size_t _length) NOEXCEPT {
+		uint64_t _hash = 14695981039346656037ull;
+		for (size_t _index = 0; _index < _length; _index++) {
+			_hash ^= (unsigned char)_name[_index];
+			_hash *= 1099511628211ull;
+		}
+		return _hash;
+	}
+private:
+	MappedFile file;
+	const Header* header;
+	const Entry* entries;
+	const uint32_t* slots;
+	const char* names;
+
+	//Checks that all table of contents is inside of mapped file
+	bool validate() const NOEXCEPT {
+		size_t _size = file.size();
+		if (_size < sizeof(Header) || std::memcmp(header->magic, magic(), 4) || header->version != VERSION)
+			return false;
+		if (header->slotCount & (header->slotCount - 1) || header->slotCount < header->count)
+			return false;
+		uint64_t _tables = (uint64_t)header->count * sizeof(Entry) + (uint64_t)header->slotCount * sizeof(uint32_t);
+		if (header->tocOffset % 8 || header->tocOffset > _size || header->tocSize > _size - header->tocOffset || _tables > header->tocSize)
+			return false;
+		uint64_t _namesSize = header->tocSize - _tables;
+		for (uint32_t _index = 0; _index < header->count; _index++) {
+			const Entry& _entry = entries[_index];
+			if (_entry.offset > _size || _entry.size > _size - _entry.offset || (uint64_t)_entry.nameOffset + _entry.nameLength > _namesSize)
+				return false;
+			if (_entry.compression == STORED && _entry.size != _entry.originalSize)
+				return false;
+		}
+		return true;
+	}
+public:
+	PackArchive() NOEXCEPT : header(nullptr), entries(nullptr), slots(nullptr), names(nullptr) {}
+
+	PackArchive(const PackArchive&) = delete;
+
+	PackArchive& operator=(const PackArchive&) = delete;
+
+	/**
+	*	\brief Maps archive '_path' and checks its table of contents.
+	*	\throw nothrow
+	*	\return False if file can't be mapped or isn't valid archive.
+	**/
+	bool open(const std::string& _path) NOEXCEPT {
+		close();
+		if (!file.openReadOnly(_path.c_str()))
+			return false;
+		const char* _base = (const char*)file.data();
+		header = (const Header*)_base;
+		if (file.size() >= sizeof(Header)) {
+			entries = (const Entry*)(_base + header->tocOffset);
+			slots = (const uint32_t*)(entries + header->count);
+			names = (const char*)(slots + header->slotCount);
+		}
+		if (!validate()) {
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	//Unmaps archive
+	void close() NOEXCEPT {
+		file.close();
+		header = nullptr;
+		entries = nullptr;
+		slots = nullptr;
+		names = nullptr;
+	}
+
+	//Checks that archive is open
+	inline bool isOpen() const NOEXCEPT { return header != nullptr; }
+
+	//Count of entries
+	inline size_t size() const NOEXCEPT { return header ? header->count : 0; }
+
+	/**
+	*	\brief Finds entry with name '_name'.
+	*	\throw nothrow
+	*	\return Entry or nullptr if it isn't found.
+	**/
+	const Entry* find(const std::string& _name) const NOEXCEPT {
+		if (!header || !header->slotCount)
+			return nullptr;
+		uint64_t _hash = hash(_name.data(), _name.size());
+		uint32_t _mask = header->slotCount - 1;
+		for (uint32_t _probe = 0, _slot = (uint32_t)_hash & _mask; _probe <= _mask; _probe++, _slot = (_slot + 1) & _mask) {
+			uint32_t _index = slots[_slot];
+			if (!_index || _index > header->count)
+				return nullptr;
+			const Entry& _entry = entries[_index - 1];
+			if (_entry.hash == _hash && _entry.nameLength == _name.size() && !std::memcmp(names + _entry.nameOffset, _name.data(), _name.size()))
+				return &_entry;
+		}
+		return nullptr;
+	}
+
+	//Name of entry '_entry'
+	std::string name(const Entry& _entry) const { return std::string(names + _entry.nameOffset, _entry.nameLength); }
+
+	//Entry with index '_index' in [0, size())
+	inline const Entry& entry(size_t _index) const NOEXCEPT { return entries[_index]; }
+
+	/**
+	*	\brief Returns data of stored entry in mapped archive without copying.
+	*	\throw nothrow
+	*	\return Pointer to data, nullptr if entry is compressed.
+	**/
+	const char* view(const Entry& _entry) const NOEXCEPT {
+		if (_entry.compression != STORED)
+			return nullptr;
+		return (const char*)file.data() + _entry.offset;
+	}
+
+	/**
+	*	\brief Copies or decompresses data of entry '_entry' to '_out'.
+	*	\throw std::bad_alloc
+	*	\return False if entry is malformed or its compression isn't supported.
+	**/
+	bool read(const Entry& _entry, std::vector<char>& _out) const {
+		const char* _data = (const char*)file.data() + _entry.offset;
+		switch (_entry.compression) {
+		case STORED:
+			_out.assign(_data, _data + _entry.size);
+			return true;
+		case LZ4:
+			_out.resize((size_t)_entry.originalSize);
+			return lz4::decompress(_data, (size_t)_entry.size, _out.data(), _out.size());
+		default:
+			return false;
+		}
+	}
+};
+
+/**
+*	\brief Builder of pack archive: collects entries in memory and writes archive file.
+*	Class definition: PackWriter
+**/
+class PackWriter {
+	struct Item {
+		std::string name;
+		std::vector<char> data;
+		uint64_t originalSize;
+		uint8_t compression;
+	};
+
+	std::vector<Item> items;
+
+	//Appends '_size' low bytes of '_value' to '_out' in little-endian order
+	static void put(std::string& _out, uint64_t _value, size_t _size) {
+		for (size_t _byte = 0; _byte < _size; _byte++)
+			_out += (char)(unsigned char)(_value >> (_byte * 8));
+	}
+
+	//Appends '_header' to '_out' in file layout
+	static void put(std::string& _out, const PackArchive::Header& _header) {
+		_out.append(_header.magic, 4);
+		put(_out, _header.version, 4);
+		put(_out, _header.count, 4);
+		put(_out, _header.slotCount, 4);
+		put(_out, _header.tocOffset, 8);
+		put(_out, _header.tocSize, 8);
+	}
+
+	//Appends '_entry' to '_out' in file layout
+	static void put(std::string& _out, const PackArchive::Entry& _entry) {
+		put(_out, _entry.hash, 8);
+		put(_out, _entry.offset, 8);
+		put(_out, _entry.size, 8);
+		put(_out, _entry.originalSize, 8);
+		put(_out, _entry.nameOffset, 4);
+		put(_out, _entry.nameLength, 2);
+		put(_out, _entry.compression, 1);
+		put(_out, _entry.reserved, 1);
+	}
+
+	//Writes header '_header' at current position of '_stream'
+	static void writeHeader(std::ofstream& _stream, const PackArchive::Header& _header) {
+		std::string _bytes;
+		put(_bytes, _header);
+		_stream.write(_bytes.data(), (std::streamsize)_bytes.size());
+	}
+
+	//Writes zero bytes up to offset multiple of '_alignment'
+	static void pad(std::ofstream& _stream, uint64_t& _offset, uint64_t _alignment) {
+		static const char _zeros[PACKARCHIVE_ALIGNMENT] = {};
+		uint64_t _padding = (_alignment - _offset % _alignment) % _alignment;
+		_stream.write(_zeros, (std::streamsize)_padding);
+		_offset += _padding;
+	}
+public:
+	/**
+	*	\brief Adds entry '_name' with '_size' bytes of '_data'.
+	*	LZ4 compressed entry is stored as is if compression doesn't make it smaller.
+	*	\param[in]	_name			Name of entry: normalized path inside archive.
+	*	\param[in]	_data			Content of entry.
+	*	\param[in]	_size			Size of content.
+	*	\param[in]	_compression	STORED for entries used in place (mapped meshes, images), LZ4 for others.
+	*	\throw std::bad_alloc, std::invalid_argument If compression isn't supported or name is too long.
+	**/
+	void add(const std::string& _name, const char* _data, size_t _size, PackArchive::Compression _compression) {
+		if (_compression != PackArchive::STORED && _compression != PackArchive::LZ4)
+			throw std::invalid_argument("ERROR::PACK_WRITER::add::Compression isn't supported by this build.");
+		if (_name.size() > 0xFFFF)
+			throw std::invalid_argument("ERROR::PACK_WRITER::add::Name is too long.");
+		Item _item;
+		_item.name = _name;
+		_item.originalSize = _size;
+		_item.compression = PackArchive::STORED;
+		if (_compression == PackArchive::LZ4 && _size) {
+			_item.data.resize(lz4::compressBound(_size));
+			size_t _compressed = lz4::compress(_data, _size, _item.data.data(), _item.data.size());
+			if (_compressed && _compressed < _size) {
+				_item.data.resize(_compressed);
+				_item.compression = PackArchive::LZ4;
+			}
+		}
+		if (_item.compression == PackArchive::STORED)
+			_item.data.assign(_data, _data + _size);
+		items.push_back(std::move(_item));
+	}
+
+	//Count of added entries
+	inline size_t size() const NOEXCEPT { return items.size(); }
+
+	/**
+	*	\brief Writes archive to '_path'. Entries with equal names are replaced by the last added one.
+	*	Entries with equal content share one copy of data. Fields are written in little-endian order.
+	*	\throw std::bad_alloc
+	*	\return False if file can't be written.
+	**/
+	bool write(const std::string& _path) const {
+		std::vector<size_t> _unique;
+		{
+			//Position in '_unique' by name
+			std::unordered_map<std::string, size_t> _positions;
+			for (size_t _index = 0; _index < items.size(); _index++) {
+				auto _result = _positions.emplace(items[_index].name, _unique.size());
+				if (_result.second)
+					_unique.push_back(_index);
+				else
+					_unique[_result.first->second] = _index;
+			}
+		}
+		std::ofstream _stream(_path, std::ios::binary | std::ios::trunc);
+		if (!_stream)
+			return false;
+		PackArchive::Header _header;
+		std::memcpy(_header.magic, PackArchive::magic(), 4);
+		_header.version = PackArchive::VERSION;
+		_header.count = (uint32_t)_unique.size();
+		_header.slotCount = 1;
+		while (_header.slotCount < _header.count * 2)
+			_header.slotCount <<= 1;
+		writeHeader(_stream, _header);
+		uint64_t _offset = sizeof(PackArchive::Header);
+		std::vector<PackArchive::Entry> _entries;
+		std::string _names;
+		//Entries with written data by content hash
+		std::unordered_multimap<uint64_t, size_t> _contents;
+		for (size_t _index : _unique) {
+			const Item& _item = items[_index];
+			PackArchive::Entry _entry;
+			std::memset(&_entry, 0, sizeof(_entry));
+			_entry.hash = PackArchive::hash(_item.name.data(), _item.name.size());
+			_entry.size = _item.data.size();
+			_entry.originalSize = _item.originalSize;
+			_entry.nameOffset = (uint32_t)_names.size();
+			_entry.nameLength = (uint16_t)_item.name.size();
+			_entry.compression = _item.compression;
+			uint64_t _content = PackArchive::hash(_item.data.data(), _item.data.size());
+			bool _shared = false;
+			for (auto _same = _contents.equal_range(_content); _same.first != _same.second && !_shared; ++_same.first) {
+				const PackArchive::Entry& _other = _entries[_same.first->second];
+				const Item& _written = items[_unique[_same.first->second]];
+				if (_other.compression == _entry.compression && _written.data == _item.data) {
+					_entry.offset = _other.offset;
+					_shared = true;
+				}
+			}
+			if (!_shared) {
+				if (_item.compression == PackArchive::STORED)
+					pad(_stream, _offset, PACKARCHIVE_ALIGNMENT);
+				_entry.offset = _offset;
+				_stream.write(_item.data.data(), (std::streamsize)_item.data.size());
+				_offset += _item.data.size();
+				_contents.emplace(_content, _entries.size());
+			}
+			_entries.push_back(_entry);
+			_names += _item.name;
+		}
+		pad(_stream, _offset, 8);
+		std::vector<uint32_t> _slots(_header.slotCount, 0);
+		uint32_t _mask = _header.slotCount - 1;
+		for (uint32_t _index = 0; _index < (uint32_t)_entries.size(); _index++) {
+			uint32_t _slot = (uint32_t)_entries[_index].hash & _mask;
+			while (_slots[_slot])
+				_slot = (_slot + 1) & _mask;
+			_slots[_slot] = _index + 1;
+		}
+		std::string _toc;
+		_toc.reserve(_entries.size() * sizeof(PackArchive::Entry) + _slots.size() * sizeof(uint32_t) + _names.size());
+		for (auto& _entry : _entries)
+			put(_toc, _entry);
+		for (uint32_t _slot : _slots)
+			put(_toc, _slot, 4);
+		_toc += _names;
+		_header.tocOffset = _offset;
+		_header.tocSize = _toc.size();
+		_stream.write(_toc.data(), (std::streamsize)_toc.size());
+		_stream.seekp(0);
+		writeHeader(_stream, _header);
+		return (bool)_stream;
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,636 @@
+#ifndef PAGEDINDEXPOOL_H
+#define PAGEDINDEXPOOL_H "[multi@cPagedIndexPool.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of sparse index pool for large index intervals.
+*		Logic: lazily allocated bitset pages
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <set>
+#include <limits>
+#include <limits.h>
+#include <cstring>
+#include <string.h>
+#include <stdexcept>
+#include <fstream>
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/mConcepts.hpp"
+//DEBUG
+#if defined(DEBUG_PAGEDINDEXPOOL) && !defined(OTHER_DEBUG)
+	#include "general/mDebug.h"
+#elif defined(DEBUG_PAGEDINDEXPOOL) && defined(OTHER_DEBUG)
+	#include OTHER_DEBUG
+#endif
+
+#ifndef PAGEDINDEXPOOL_PAGE_BUCKETS
+	/**
+	*	Count of buckets in one bitset page.
+	*	Default: 128 buckets of 32 bits -> 4096 indexes in 512 bytes per page.
+	**/
+	#define PAGEDINDEXPOOL_PAGE_BUCKETS 128
+#endif
+
+#ifndef PAGEDINDEXPOOL_IMAGE_MAGIC
+	//Magic number of pool image file: "PIPI"
+	#define PAGEDINDEXPOOL_IMAGE_MAGIC 0x49504950
+#endif
+
+#ifndef PAGEDINDEXPOOL_IMAGE_VERSION
+	//Version of pool image file layout
+	#define PAGEDINDEXPOOL_IMAGE_VERSION 1
+#endif
+
+template < class TIndex = int >
+/**
+*	\brief Performs index handling over huge (up to full 64-bit) index intervals.
+*	Index interval is split into pages of PAGEDINDEXPOOL_PAGE_BUCKETS buckets.
+*	Page memory is allocated only on first index allocation in it and released when last index of page is deleted,
+*	so memory usage is proportional to count of used indexes, not to interval size.
+*	Has the same public interface as SmartSimpleIndexPool so it can be used as drop-in replacement.
+*	Only integral index types are accepted with constant increment step (operaor++).
+*	Heavily depends on CHAR_BIT macro from <limits.h>
+*	!!!ATTENTION!!! This class directly operates on memory so all construct, copy and move operations may throw exceptions.
+*	Class template definition: PagedIndexPool
+**/
+class PagedIndexPool {
+	CONCEPT_INTEGRAL(TIndex, "ASSERTION_ERROR::PAGED_INDEX_POOL::Provided type \"TIndex\" must be integral.")
+	//Bitset storage of state of index allocation
+	typedef unsigned int Bucket;
+	//Unsigned type for index offsets from 'minIndex' and page numbers
+	typedef unsigned long long Offset;
+
+	/**
+	*	One lazily allocated page of bitset.
+	**/
+	struct Page {
+		//Bitset of page
+		Bucket* buckets;
+		//Count of allocated indexes in page
+		unsigned int usedCount;
+		//Lowest bucket that may contain free index
+		unsigned int firstFree;
+	};
+
+	/**
+	*	Header of raw pool image. Every allocated page follows header as its number and its buckets.
+	*	Image layout is platform dependent (endianness, sizeof(Bucket)), header fields are checked on load.
+	**/
+	struct ImageHeader {
+		//Must be PAGEDINDEXPOOL_IMAGE_MAGIC
+		unsigned int magic;
+		//Must be PAGEDINDEXPOOL_IMAGE_VERSION
+		unsigned int version;
+		//sizeof(TIndex) of pool that made image
+		unsigned int indexSize;
+		//sizeof(Bucket) * PAGEDINDEXPOOL_PAGE_BUCKETS of pool that made image
+		unsigned int pageSize;
+		//Interval of pool
+		unsigned long long minIndex;
+		unsigned long long maxIndex;
+		//Count of stored pages
+		unsigned long long pageCount;
+	};
+
+	typedef std::map<Offset, Page> PageTable;
+	//Table of allocated pages: page number -> page
+	PageTable pages;
+	//Numbers of allocated pages that are not full
+	std::set<Offset> partialPages;
+	//Some not full page is missing from 'partialPages': insertion failed on allocation
+	bool lostPartial;
+	//Lowest page number that may be not allocated yet
+	Offset freshPage;
+	//Offset of 'maxIndex' from 'minIndex'
+	Offset lastOffset;
+	//Count of pages covering whole interval
+	Offset pageCount;
+	//Computed bucket size in bits
+	unsigned int bucketBitSize;
+	//Count of indexes in one page
+	unsigned int pageBitSize;
+	//Count of used bits in last page
+	unsigned int tail;
+	//Maximal and minimal possible indexes
+	TIndex minIndex;
+	TIndex maxIndex;
+
+	/**
+	*	Computes offset of '_index' from 'minIndex' without signed overflow.
+	**/
+	inline Offset offsetOf(TIndex _index) NOEXCEPT { return (Offset)_index - (Offset)minIndex; }
+
+	/**
+	*	Computes index by its offset from 'minIndex' without signed overflow.
+	**/
+	inline TIndex indexOf(Offset _offset) NOEXCEPT { return (TIndex)((Offset)minIndex + _offset); }
+
+	/**
+	*	Count of indexes in page '_number'.
+	**/
+	inline unsigned int pageCapacity(Offset _number) NOEXCEPT { return (tail && _number == pageCount - 1) ? tail : pageBitSize; }
+
+	/**
+	*	\brief Allocates a new zeroed page with number '_number'.
+	*	\param[in]	_number	Number of page to be allocated.
+	*	\throw std::bad_alloc If system don't have enougth memory for new page.
+	*	\return Reference to new page.
+	**/
+	Page& allocatePage(Offset _number) {
+		Page _page;
+		//std::bad_alloc may be thrown here
+		_page.buckets = new Bucket[PAGEDINDEXPOOL_PAGE_BUCKETS];
+		std::memset(_page.buckets, 0, PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket));
+		_page.usedCount = 0;
+		_page.firstFree = 0;
+		try { return pages.insert(std::make_pair(_number, _page)).first->second; }
+		catch (...) {
+			delete[] _page.buckets;
+			throw;
+		}
+	}
+
+	/**
+	*	\brief Releases memory of page pointed by '_page' iterator.
+	*	\param[in]	_page	Iterator of page to be released.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void releasePage(typename PageTable::iterator _page) NOEXCEPT {
+		if (_page->first < freshPage)
+			freshPage = _page->first;
+		partialPages.erase(_page->first);
+		delete[] _page->second.buckets;
+		pages.erase(_page);
+	}
+
+	/**
+	*	\brief Returns not full pages that were dropped by failed insertion back to 'partialPages'.
+	*	Page table is scanned fully: it is done only after such failure.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void recoverPartialPages() NOEXCEPT {
+		try {
+			for (const auto& _value : pages)
+				if (_value.second.usedCount != pageCapacity(_value.first))
+					partialPages.insert(_value.first);
+			lostPartial = false;
+		}
+		catch (...) {}
+	}
+
+	/**
+	*	\brief Allocates the first free index in page '_page' with number '_number'.
+	*	Page must contain at least one free index.
+	*	\param[in]	_number	Number of page.
+	*	\param[in]	_page	Page to search in.
+	*	\throw nothrow
+	*	\return Newly allocated index.
+	**/
+	TIndex allocateInPage(Offset _number, Page& _page) NOEXCEPT {
+		Bucket* ptr(_page.buckets + _page.firstFree);
+		Bucket* _end(_page.buckets + PAGEDINDEXPOOL_PAGE_BUCKETS);
+		while (ptr != _end) {
+			//Enable bit-check only if 0 bits presented in current bucket
+			if (~(*ptr)) {
+				for (unsigned int _index = 0; _index < bucketBitSize; _index++) {
+					if (!(*ptr & (((Bucket)1) << _index))) {
+						*ptr |= ((Bucket)1) << _index;
+						_page.usedCount++;
+						_page.firstFree = (unsigned int)(ptr - _page.buckets);
+						return indexOf(_number * pageBitSize + (ptr - _page.buckets) * bucketBitSize + _index);
+					}
+				}
+			}
+			ptr++;
+		}
+		return notFoundIndex;
+	}
+
+	/**
+	*	Deep copy of pages of 'other' to this pool that has no pages.
+	**/
+	void copyPages(const PagedIndexPool& other) {
+		for (const auto& _value : other.pages) {
+			//std::bad_alloc may be thrown here
+			Page& _page = allocatePage(_value.first);
+			std::memcpy(_page.buckets, _value.second.buckets, PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket));
+			_page.usedCount = _value.second.usedCount;
+			_page.firstFree = _value.second.firstFree;
+		}
+		partialPages = other.partialPages;
+		lostPartial = other.lostPartial;
+	}
+
+	/**
+	*	Release of all pages.
+	**/
+	void clearPages() NOEXCEPT {
+		for (auto& _value : pages)
+			delete[] _value.second.buckets;
+		pages.clear();
+		partialPages.clear();
+		lostPartial = false;
+	}
+protected:
+	//Special index that indicates that no indexes was found.
+	TIndex notFoundIndex;
+public:
+	//Type of handeled index
+	typedef TIndex IndexType;
+
+	PagedIndexPool() = delete;
+
+	PagedIndexPool(TIndex _min, TIndex _max) : lostPartial(false), freshPage(0), minIndex(_min), maxIndex(_max)
+	{
+		if (_min > _max) {
+			maxIndex = _min;
+			minIndex = _max;
+		}
+
+		if (maxIndex == minIndex)
+			throw std::invalid_argument("ERROR::PAGED_INDEX_POOL::Constructor::Invalid pool size.");
+
+		if (maxIndex != std::numeric_limits<TIndex>::max()) {
+			notFoundIndex = maxIndex + 1;
+		} else if (minIndex != std::numeric_limits<TIndex>::min()) {
+			notFoundIndex = minIndex - 1;
+		} else {
+			throw std::invalid_argument("ERROR::PAGED_INDEX_POOL::Constructor::Interval must leave place for notFoundIndex.");
+		}
+
+		lastOffset = offsetOf(maxIndex);
+		bucketBitSize = sizeof(Bucket) * CHAR_BIT;
+		pageBitSize = bucketBitSize * PAGEDINDEXPOOL_PAGE_BUCKETS;
+
+		pageCount = lastOffset / pageBitSize + 1;
+		tail = (unsigned int)((lastOffset % pageBitSize + 1) % pageBitSize);
+	}
+
+	~PagedIndexPool() NOEXCEPT { clearPages(); }
+
+	PagedIndexPool(const PagedIndexPool& other) :	lostPartial(false),
+													freshPage(other.freshPage),
+													lastOffset(other.lastOffset),
+													pageCount(other.pageCount),
+													bucketBitSize(other.bucketBitSize),
+													pageBitSize(other.pageBitSize),
+													tail(other.tail),
+													minIndex(other.minIndex),
+													maxIndex(other.maxIndex),
+													notFoundIndex(other.notFoundIndex)
+	{
+		//ERROR::PAGED_INDEX_POOL::CopyConstructor::System can't allocate memory for pages.
+		//std::bad_alloc may be thrown here
+		try { copyPages(other); }
+		catch (...) {
+			clearPages();
+			throw;
+		}
+	}
+
+	PagedIndexPool& operator= (const PagedIndexPool& other) {
+		if (&other == this)
+			return *this;
+		clearPages();
+		freshPage = other.freshPage;
+		lastOffset = other.lastOffset;
+		pageCount = other.pageCount;
+		bucketBitSize = other.bucketBitSize;
+		pageBitSize = other.pageBitSize;
+		tail = other.tail;
+		minIndex = other.minIndex;
+		maxIndex = other.maxIndex;
+		notFoundIndex = other.notFoundIndex;
+		//ERROR::PAGED_INDEX_POOL::CopyAssignment::System can't allocate memory for pages.
+		//std::bad_alloc may be thrown here
+		try { copyPages(other); }
+		catch (...) {
+			clearPages();
+			throw;
+		}
+		return *this;
+	}
+
+	PagedIndexPool(PagedIndexPool&& other) :	pages(std::move(other.pages)),
+												partialPages(std::move(other.partialPages)),
+												lostPartial(other.lostPartial),
+												freshPage(other.freshPage),
+												lastOffset(other.lastOffset),
+												pageCount(other.pageCount),
+												bucketBitSize(other.bucketBitSize),
+												pageBitSize(other.pageBitSize),
+												tail(other.tail),
+												minIndex(std::move(other.minIndex)),
+												maxIndex(std::move(other.maxIndex)),
+												notFoundIndex(std::move(other.notFoundIndex))
+	{
+		other.pages.clear();
+		other.partialPages.clear();
+	}
+
+	PagedIndexPool& operator= (PagedIndexPool&& other) {
+		if (&other == this)
+			return *this;
+		clearPages();
+		pages = std::move(other.pages);
+		partialPages = std::move(other.partialPages);
+		lostPartial = other.lostPartial;
+		freshPage = other.freshPage;
+		lastOffset = other.lastOffset;
+		pageCount = other.pageCount;
+		bucketBitSize = other.bucketBitSize;
+		pageBitSize = other.pageBitSize;
+		tail = other.tail;
+		minIndex = std::move(other.minIndex);
+		maxIndex = std::move(other.maxIndex);
+		notFoundIndex = std::move(other.notFoundIndex);
+		other.pages.clear();
+		other.partialPages.clear();
+		return *this;
+	}
+
+	/**
+	*	Compares given '_index' with notFound index.
+	**/
+	inline bool isNotFound(const TIndex& _index) { return _index == notFoundIndex; }
+
+	/**
+	*	Provides count of indexes in pool minus one (full 64-bit intervals don't fit in 64 bits).
+	**/
+	Offset getLastOffset() NOEXCEPT { return lastOffset; }
+
+	/**
+	*	Provides read access to 'minIndex' value.
+	**/
+	TIndex getMinIndex() NOEXCEPT { return minIndex; }
+
+	/**
+	*	Provides read access to 'maxIndex' value.
+	**/
+	TIndex getMaxIndex() NOEXCEPT { return maxIndex; }
+
+	/**
+	*	Provides count of currently allocated pages.
+	**/
+	size_t getPageCount() NOEXCEPT { return pages.size(); }
+
+	/**
+	*	Computes memory used by this pool.
+	*	Tree nodes are estimated as value plus three pointers and a color field.
+	**/
+	size_t usedMemory() NOEXCEPT {
+		return	pages.size() * (PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket) + sizeof(typename PageTable::value_type) + 4 * sizeof(void*)) +
+				partialPages.size() * (sizeof(Offset) + 4 * sizeof(void*)) + sizeof(PagedIndexPool);
+	}
+
+	/**
+	*	\brief Performs an allocation of new index.
+	*	Indexes from already allocated pages are preferred to keep memory usage low.
+	*	\throw nothrow
+	*	\return Newly allocated index or 'notFoundIndex'.
+	**/
+	TIndex newIndex() NOEXCEPT {
+		TIndex _result;
+		if (partialPages.empty() && lostPartial)
+			recoverPartialPages();
+		//Try to allocate from not full pages
+		if (!partialPages.empty()) {
+			auto _number = partialPages.begin();
+			Page& _page = pages.find(*_number)->second;
+			_result = allocateInPage(*_number, _page);
+			if (_page.usedCount == pageCapacity(*_number))
+				partialPages.erase(_number);
+			return _result;
+		}
+		//All allocated pages are full: find first not allocated page
+		while (freshPage < pageCount && pages.count(freshPage))
+			freshPage++;
+		if (freshPage >= pageCount)
+			return notFoundIndex;
+		Page* _page;
+		try { _page = &allocatePage(freshPage); }
+		catch (...) {
+			#if defined(DEBUG_PAGEDINDEXPOOL) && defined(WARNINGS_PAGEDINDEXPOOL)
+				DEBUG_NEW_MESSAGE("WARNING::PAGED_INDEX_POOL::newIndex")
+					DEBUG_WRITE2("\tMessage: Can't allocate page: ", freshPage);
+				DEBUG_END_MESSAGE
+			#endif
+			return notFoundIndex;
+		}
+		_result = allocateInPage(freshPage, *_page);
+		if (_page->usedCount != pageCapacity(freshPage)) {
+			try { partialPages.insert(freshPage); }
+			catch (...) { lostPartial = true; }
+		}
+		return _result;
+	}
+
+	/**
+	*	\brief Tries to perform allocation of '_count' indexes one-by-one.
+	*	\param[out]	_array	Array filled with new indexes.
+	*	\param[in]	_count	Count of indexes to be allocated.
+	*	\throw nothrow
+	*	\return Count of successfully allocated indexes.
+	**/
+	unsigned int newIndex(TIndex _array[], unsigned int _count) NOEXCEPT {
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			_array[_index] = newIndex();
+			if (_array[_index] == notFoundIndex)
+				return _index;
+		}
+		return _count;
+	}
+
+	/**
+	*	\brief Deallocate index '_index'.
+	*	Page of index is released if it becomes empty.
+	*	\param[in]	_index	Index to be deallocated.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void deleteIndex(TIndex _index) NOEXCEPT {
+		if (_index < minIndex || _index > maxIndex)
+			return;
+		Offset _offset = offsetOf(_index);
+		auto _page = pages.find(_offset / pageBitSize);
+		if (_page == pages.end())
+			return;
+		_offset %= pageBitSize;
+		//Bucket position
+		Bucket* ptr = _page->second.buckets + _offset / bucketBitSize;
+		//Bit position
+		Bucket _mask = ((Bucket)1) << (_offset % bucketBitSize);
+		if (!(*ptr & _mask))
+			return;
+		//Set bit to zero
+		*ptr &= ~_mask;
+		if (ptr - _page->second.buckets < _page->second.firstFree)
+			_page->second.firstFree = (unsigned int)(ptr - _page->second.buckets);
+		if (!(--_page->second.usedCount)) {
+			releasePage(_page);
+		} else {
+			//std::set::insert may throw only on allocation failure: page is found by recoverPartialPages then
+			try { partialPages.insert(_page->first); }
+			catch (...) { lostPartial = true; }
+		}
+		ptr = nullptr;
+	}
+
+	/**
+	*	\brief Deallocate indexex from '_begin' index to '_end' index.
+	*	Pages fully covered by interval are released without bit-by-bit processing.
+	*	\param[in]	_begin	Begin of indexes to be deallocated.
+	*	\param[in]	_end	End of indexes to be deallocated.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void deleteIndex(TIndex _begin, TIndex _end) NOEXCEPT {
+		if (_begin > _end)
+			std::swap(_begin, _end);
+		if (_end < minIndex || _begin > maxIndex)
+			return;
+		if (_begin < minIndex)
+			_begin = minIndex;
+		if (_end > maxIndex)
+			_end = maxIndex;
+		Offset _first = offsetOf(_begin);
+		Offset _last = offsetOf(_end);
+		auto _page = pages.lower_bound(_first / pageBitSize);
+		while (_page != pages.end() && _page->first <= _last / pageBitSize) {
+			Offset _pageBegin = _page->first * pageBitSize;
+			Offset _pageEnd = _pageBegin + pageCapacity(_page->first) - 1;
+			if (_first <= _pageBegin && _last >= _pageEnd) {
+				releasePage(_page++);
+				continue;
+			}
+			for (Offset _offset = (_first > _pageBegin ? _first : _pageBegin); _offset <= (_last < _pageEnd ? _last : _pageEnd); _offset++) {
+				Bucket* _ptr = _page->second.buckets + (_offset - _pageBegin) / bucketBitSize;
+				Bucket _mask = ((Bucket)1) << ((_offset - _pageBegin) % bucketBitSize);
+				if (*_ptr & _mask) {
+					*_ptr &= ~_mask;
+					_page->second.usedCount--;
+					if (_ptr - _page->second.buckets < _page->second.firstFree)
+						_page->second.firstFree = (unsigned int)(_ptr - _page->second.buckets);
+				}
+			}
+			if (!_page->second.usedCount) {
+				releasePage(_page++);
+			} else {
+				try { partialPages.insert(_page->first); }
+				catch (...) { lostPartial = true; }
+				++_page;
+			}
+		}
+	}
+
+	/**
+	*	\brief Check index allocation status of '_index'.
+	*	\param[in]	_index	Index to be checked.
+	*	\throw nothrow
+	*	\return Index allocation status.
+	**/
+	bool isUsed(TIndex _index) NOEXCEPT {
+		if (_index < minIndex || _index > maxIndex)
+			return false;
+		Offset _offset = offsetOf(_index);
+		auto _page = pages.find(_offset / pageBitSize);
+		if (_page == pages.end())
+			return false;
+		_offset %= pageBitSize;
+		return (_page->second.buckets[_offset / bucketBitSize] & (((Bucket)1) << (_offset % bucketBitSize))) != 0;
+	}
+
+	/**
+	*	\brief Writes current pool state to raw image file '_path'.
+	*	Only allocated pages are stored, so image size is proportional to count of used indexes.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of writing.
+	**/
+	bool saveImage(const char* _path) NOEXCEPT {
+		ImageHeader _header;
+		_header.magic = PAGEDINDEXPOOL_IMAGE_MAGIC;
+		_header.version = PAGEDINDEXPOOL_IMAGE_VERSION;
+		_header.indexSize = sizeof(TIndex);
+		_header.pageSize = PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket);
+		_header.minIndex = (unsigned long long)minIndex;
+		_header.maxIndex = (unsigned long long)maxIndex;
+		_header.pageCount = pages.size();
+		try {
+			std::ofstream _file(_path, std::ios::out | std::ios::binary | std::ios::trunc);
+			_file.write((const char*)&_header, sizeof(ImageHeader));
+			for (const auto& _value : pages) {
+				_file.write((const char*)&_value.first, sizeof(Offset));
+				_file.write((const char*)_value.second.buckets, PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket));
+			}
+			return _file.good();
+		}
+		catch (...) {
+			#if defined(DEBUG_PAGEDINDEXPOOL) && defined(WARNINGS_PAGEDINDEXPOOL)
+				DEBUG_NEW_MESSAGE("WARNING::PAGED_INDEX_POOL::saveImage")
+					DEBUG_WRITE2("\tMessage: Can't write image: ", _path);
+				DEBUG_END_MESSAGE
+			#endif
+			return false;
+		}
+	}
+
+	/**
+	*	\brief Reads pool state from raw image file '_path'.
+	*	Image must be made by pool with same interval, index type and page size.
+	*	Pool state is unchanged on failure.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of reading.
+	**/
+	bool loadImage(const char* _path) NOEXCEPT {
+		PagedIndexPool _loaded(minIndex, maxIndex);
+		ImageHeader _header;
+		try {
+			std::ifstream _file(_path, std::ios::in | std::ios::binary);
+			_file.read((char*)&_header, sizeof(ImageHeader));
+			if (!_file.good() || _header.magic != PAGEDINDEXPOOL_IMAGE_MAGIC || _header.version != PAGEDINDEXPOOL_IMAGE_VERSION ||
+				_header.indexSize != sizeof(TIndex) || _header.pageSize != PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket) ||
+				_header.minIndex != (unsigned long long)minIndex || _header.maxIndex != (unsigned long long)maxIndex ||
+				_header.pageCount > pageCount)
+				return false;
+			for (unsigned long long _stored = 0; _stored < _header.pageCount; _stored++) {
+				Offset _number;
+				_file.read((char*)&_number, sizeof(Offset));
+				if (!_file.good() || _number >= pageCount || _loaded.pages.count(_number))
+					return false;
+				//std::bad_alloc may be thrown here
+				Page& _page = _loaded.allocatePage(_number);
+				_file.read((char*)_page.buckets, PAGEDINDEXPOOL_PAGE_BUCKETS * sizeof(Bucket));
+				if (!_file.good())
+					return false;
+				//Bits past capacity of page must be clear: usedCount counts all set bits
+				unsigned int _capacity = pageCapacity(_number);
+				for (unsigned int _bit = 0; _bit < pageBitSize; _bit++) {
+					if (_page.buckets[_bit / bucketBitSize] & (((Bucket)1) << (_bit % bucketBitSize))) {
+						if (_bit >= _capacity)
+							return false;
+						_page.usedCount++;
+					}
+				}
+				if (!_page.usedCount)
+					return false;
+				if (_page.usedCount != _capacity)
+					_loaded.partialPages.insert(_number);
+			}
+		}
+		catch (...) {
+			return false;
+		}
+		*this = std::move(_loaded);
+		return true;
+	}
+};
+#endif
\ No newline at end of file
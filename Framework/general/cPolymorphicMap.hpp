@@ -10,11 +10,15 @@
 */
 //STD
 #include <map>
+#include <memory>
+#include <iterator>
+#include <type_traits>
+#include <new>
 //OUR
 #include "vPolymorphicContainerGeneral.hpp"
 //DEBUG
 #if defined(DEBUG_POLYMORPHICMAP) && !defined(OTHER_DEBUG)
-	#include "general\mDebug.h"
+	#include "general/mDebug.h"
 #elif  defined(DEBUG_POLYMORPHICMAP) && defined(OTHER_DEBUG)
 	#include OTHER_DEBUG
 #endif
@@ -41,6 +45,94 @@ protected:
 	*	Accessible from derived classes.
 	**/
 	Storage storage;
+
+	template < class T >
+	/**
+	*	Contiguous block of objects of type "T" constructed by bulk operations.
+	*	Objects in block are handed out by aliasing shared pointers, so
+	*	block memory is freed when last object of block is released.
+	*	Objects share one reference count: object removed from map or released by user
+	*	is destroyed only with whole block, when every object of block is released.
+	*	Struct template definition: BulkBlock
+	**/
+	struct BulkBlock {
+		typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type Place;
+		//Memory of objects
+		std::unique_ptr<Place[]> places;
+		//Construction flags of objects
+		std::unique_ptr<bool[]> constructed;
+		//Count of places in block
+		unsigned int count;
+
+		BulkBlock(unsigned int _count) : places(new Place[_count]), constructed(new bool[_count]()), count(_count) {}
+
+		~BulkBlock() {
+			for (unsigned int _index = 0; _index < count; _index++)
+				if (constructed[_index])
+					at(_index)->~T();
+		}
+
+		inline T* at(unsigned int _index) NOEXCEPT { return reinterpret_cast<T*>(&places[_index]); }
+	};
+
+	template < class T, class... TArgs >
+	/**
+	*	\brief Constructs '_count' objects of type "T" from '_args' in one memory block.
+	*	Objects are placed with indexes from '_Id' array, existing objects are replaced.
+	*	As in scalar newObject existing object is erased before construction, so it is removed even if construction fails.
+	*	Destructors of objects run late: when every object of block is released (see BulkBlock).
+	*	Map insertion is hinted by previous insertion, so ascending '_Id' arrays are inserted in amortized constant time.
+	*	\param[in]	_Id			Array of identificators.
+	*	\param[out]	_result		Array of shared pointers to new objects.
+	*	\param[in]	_count		Count of objects to be created.
+	*	\param[out]	_success	[Optional] Per object status of successful creation.
+	*	\param[in]	_args		Constructor arguments, same for every object.
+	*	\throw nothrow
+	*	\return Count of successfully created objects.
+	**/
+	unsigned int bulkObjects(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+								bool _success[], const TArgs&... _args) NOEXCEPT
+	{
+		std::shared_ptr< BulkBlock<T> > _block(nullptr);
+		try { _block = std::make_shared< BulkBlock<T> >(_count); }
+		catch (...) {
+			#ifdef DEBUG_POLYMORPHICMAP
+				DEBUG_NEW_MESSAGE("ERROR::POLYMORPHIC_MAP::bulkObjects")
+					DEBUG_WRITE2("\tMessage: Can't allocate block of objects. Count: ", _count);
+				DEBUG_END_MESSAGE
+			#endif
+			if (_success)
+				for (unsigned int _index = 0; _index < _count; _index++)
+					_success[_index] = false;
+			return 0;
+		}
+		unsigned int _allocated = 0;
+		auto _hint = storage.end();
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			//Erase object with same index: new object is inserted in its place
+			auto _found = storage.find(_Id[_index]);
+			if (_found != storage.end())
+				_hint = storage.erase(_found);
+			try {
+				new (_block->at(_index)) T(_args...);
+				_block->constructed[_index] = true;
+				std::shared_ptr<T> _newptr(_block, _block->at(_index));
+				auto _iterator = storage.emplace_hint(_hint, _Id[_index], Member());
+				_iterator->second = _newptr;
+				_hint = std::next(_iterator);
+				_result[_index] = std::move(_newptr);
+			}
+			catch (...) {
+				if (_success)
+					_success[_index] = false;
+				continue;
+			}
+			if (_success)
+				_success[_index] = true;
+			_allocated++;
+		}
+		return _allocated;
+	}
 public:
 
 	PolymorphicMap() = default;
@@ -76,7 +168,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newObject(	const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT,
+	inline auto newObject(	const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT,
 									T* const _defptr = nullptr) -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -113,6 +205,8 @@ public:
 	template < class T >
 	/**
 	*	\brief Performs an attempt to create '_count' objects by calling newObject with default constructor.
+	*	Unless '_strategy' is BIG all objects are constructed in one memory block (see bulkObjects):
+	*	then objects are destroyed only when every object of block is released.
 	*	Increment result on every successful (nothrow) creation.
 	*	\param[in]	_Id			Array of identificators.
 	*	\param[out]	_result		Array of shared pointers to new objects.
@@ -122,12 +216,18 @@ public:
 	*	\throw Ignore : exception may occur if _Id or _result not long enougth.
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int newObject(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int newObject(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr) 
 	{
 		CONCEPT_NOT_CVRP(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		if (!_count || !_result)
 			return 0;
+		//Small objects are constructed in one block
+		if (_strategy != allocateStrategy::BIG) {
+			CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+			CONCEPT_DEFCONSTR(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must be default constuctible.")
+			return bulkObjects(_Id, _result, _count, _success);
+		}
 		//Counter of allocated objects
 		unsigned int _allocated = 0; 
 		for (unsigned int _index = 0; _index < _count; _index++) {
@@ -155,7 +255,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+	inline auto newObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
 									-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -195,7 +295,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
+	inline auto newObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		CONCEPT_CLEAR_TYPE(T,_ObjType)
 		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
@@ -212,6 +312,8 @@ public:
 	template < class T >
 	/**
 	*	\brief Performs an attempt to create '_count' objects by calling newObject on copy of '_value'.
+	*	Unless '_strategy' is BIG all objects are constructed in one memory block (see bulkObjects):
+	*	then objects are destroyed only when every object of block is released.
 	*	Increment result on every successful (nothrow) creation.
 	*	\param[in]	_value		Constant reference to be used in copy construction of new objects.
 	*	\param[in]	_Id			Array of identificators.
@@ -222,14 +324,17 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int newObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int newObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
 	{
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		CONCEPT_COPY_CONSTRUCTIBLE(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must be copy constructible.")
-		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
 		if (!_count)
 			return _count;
+		//Small objects are copy constructed in one block
+		if (_strategy != allocateStrategy::BIG)
+			return bulkObjects(_Id, _result, _count, _success, _value);
 		//Counter of allocated objects
 		unsigned int _allocated = 0;
 		for (unsigned int _index = 0; _index < _count; _index++) {
@@ -259,7 +364,7 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int newObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int newObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr) 
 	{
 		return newObject(*_valueptr, _Id, _result, _count, _strategy, _success);
@@ -278,7 +383,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newCopy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
+	inline auto newCopy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
 								-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -308,7 +413,7 @@ public:
 			{
 				_newptr.reset(new _ObjType(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			} else {
-				_newptr = std::move(std::make_shared(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
+				_newptr = std::move(std::make_shared<_ObjType>(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			}
 		}
 		//std::make_shared exception : not enougth memory
@@ -334,7 +439,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto copyObject(	const Index _sourceId, const Index _destId,
+	inline auto copyObject(	const Index _sourceId, const Index _destId,
 									const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr) 
 									-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
@@ -368,7 +473,7 @@ public:
 			{
 				_newptr.reset(new _ObjType(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			} else {
-				_newptr = std::move(std::make_shared(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
+				_newptr = std::move(std::make_shared<_ObjType>(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			}
 		}
 		//std::make_shared exception : not enougth memory
@@ -392,7 +497,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer of type "T" to moved object on success and to nullptr on error.
 	**/
-	virtual inline std::shared_ptr<T> moveObject(const Index _sourceId, const Index _destId, T* const _defptr = nullptr) {
+	inline std::shared_ptr<T> moveObject(const Index _sourceId, const Index _destId, T* const _defptr = nullptr) {
 		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::moveObject::Provided type \"T\" must be derived from \"Base\".")
 		if (_sourceId == _destId)
 			return std::shared_ptr<T>(nullptr);
@@ -428,7 +533,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto setObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+	inline auto setObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
 									-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -467,7 +572,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto setObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
+	inline auto setObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::setObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		CONCEPT_CLEAR_TYPE(T,_ObjType)
 		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::setObject::Provided type \"T\" must be derived from \"Base\".")
@@ -481,6 +586,8 @@ public:
 	template < class T >
 	/**
 	*	\brief Performs an attempt to setup '_count' objects by calling setObject on copy of '_value'.
+	*	Unless '_strategy' is BIG all objects are constructed in one memory block (see bulkObjects):
+	*	then objects are destroyed only when every object of block is released.
 	*	Increment result on every successful (nothrow) creation.
 	*	\param[in]	_value		Constant reference to be used in copy construction of new objects.
 	*	\param[in]	_Id			Array of identificators of objects that will be replaced.
@@ -491,7 +598,7 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int setObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int setObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
 	{
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::setObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
@@ -499,6 +606,9 @@ public:
 		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::setObject::Provided type \"T\" must be derived from \"Base\".")
 		if (!_count)
 			return 0;
+		//Small objects are copy constructed in one block
+		if (_strategy != allocateStrategy::BIG)
+			return bulkObjects(_Id, _result, _count, _success, _value);
 		unsigned int _allocated = 0;
 		for (unsigned int _index = 0; _index < _count; _index++) {
 			try { _result[_index] = std::move(setObject(std::move(T(_value)), _Id[_index], _strategy)); }
@@ -527,7 +637,7 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int setObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int setObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr) 
 	{
 		return setObject(*_valueptr, _Id, _result, _count, _strategy, _success);
@@ -542,7 +652,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer to object with index '_Id' or to nullptr on error.
 	**/
-	virtual inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) NOEXCEPT{
+	inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) NOEXCEPT{
 		CONCEPT_NOT_PR(T, "ASSERTION_ERROR::POLYMORPHIC_MAP::getObject::Provided type \"T\" must not be pointer or reference type.")
 		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::POLYMORPHIC_MAP::getObject::Provided type \"T\" must be derived from \"Base\".")
 		try { return std::move(std::dynamic_pointer_cast<T>(storage.at(_Id))); }
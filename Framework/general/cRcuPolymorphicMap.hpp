@@ -0,0 +1,572 @@
+#ifndef RCUPOLYMORPHICMAP_H
+#define RCUPOLYMORPHICMAP_H "[multy@cRcuPolymorphicMap.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of polymorphic map class for read-mostly use
+*		from many threads (read-copy-update).
+*		Readers work with immutable published version of index and never wait for writers.
+*		Writers are serialised, change private copy of index, publish it as new version
+*		and reclaim old version after all readers that could see it are gone.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+//OUR
+#include "vPolymorphicContainerGeneral.hpp"
+//DEBUG
+#if defined(DEBUG_RCUPOLYMORPHICMAP) && !defined(OTHER_DEBUG)
+	#include "general/mDebug.h"
+#elif  defined(DEBUG_RCUPOLYMORPHICMAP) && defined(OTHER_DEBUG)
+	#include OTHER_DEBUG
+#endif
+
+#ifndef RCUPOLYMORPHICMAP_CACHE_LINE
+	//Size of padding between reader counters
+	#define RCUPOLYMORPHICMAP_CACHE_LINE 64
+#endif
+
+template <	class _Index, class _Base,
+			allocateStrategy (_Base::* _getAllocStrategy)() = &_Base::getAllocStrategy>
+/**
+*	Class that represents polymorthic container of map type with read-copy-update index.
+*	Lookups (getObject, snapshot, size) are wait-free: they take published version of index
+*	with two atomic increments and never lock. Any other operation is a write: it locks writer
+*	mutex, changes private index 'storage', publishes copy of it and waits until readers of
+*	previous version leave (grace period), then deletes previous version.
+*	Writes cost O(n) copy of index and are intended to be rare (loads, reloads, deletes).
+*	Only index is protected: handled objects are shared and must be synchronised by user.
+*	Class template definition: RcuPolymorphicMap
+**/
+class RcuPolymorphicMap {
+	//Type used as handled pointer to objects
+	typedef std::shared_ptr<_Base> Pointer;
+public:
+	//Type used as index.
+	typedef _Index Index;
+	//Type used as base type of handled objects.
+	typedef _Base Base;
+	//Type of internal storage.
+	typedef std::map<_Index, Pointer> Storage;
+
+	/**
+	*	\brief Reader access to one published version of index.
+	*	Version stays alive while snapshot exists: hold it for a frame, not longer,
+	*	because writers wait for it to publish next versions.
+	*	Class definition: Snapshot
+	**/
+	class Snapshot {
+		friend class RcuPolymorphicMap;
+		//Owner container, nullptr for released snapshot
+		const RcuPolymorphicMap* owner;
+		//Reader phase taken on enter
+		unsigned int phase;
+		//Published version of index
+		const Storage* version;
+
+		Snapshot(const RcuPolymorphicMap* _owner) NOEXCEPT : owner(_owner), phase(_owner->enter()), version(_owner->published.load()) {}
+	public:
+		~Snapshot() NOEXCEPT { release(); }
+
+		Snapshot(const Snapshot&) = delete;
+
+		Snapshot& operator=(const Snapshot&) = delete;
+
+		Snapshot(Snapshot&& other) NOEXCEPT : owner(other.owner), phase(other.phase), version(other.version) { other.owner = nullptr; }
+
+		Snapshot& operator=(Snapshot&& other) NOEXCEPT {
+			if (&other == this)
+				return *this;
+			release();
+			owner = other.owner;
+			phase = other.phase;
+			version = other.version;
+			other.owner = nullptr;
+			return *this;
+		}
+
+		//Leaves version before snapshot destruction
+		void release() NOEXCEPT {
+			if (owner)
+				owner->leave(phase);
+			owner = nullptr;
+		}
+
+		//Published index, must not be used after release
+		inline const Storage& storage() const NOEXCEPT { return *version; }
+
+		template < class T >
+		/**
+		*	\brief Finds object with index '_Id' in this version.
+		*	\throw nothrow
+		*	\return Shared pointer to object or to nullptr if object isn't found or isn't of type "T".
+		**/
+		inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) const NOEXCEPT {
+			auto _iterator = version->find(_Id);
+			if (_iterator == version->end())
+				return std::shared_ptr<T>(nullptr);
+			return std::dynamic_pointer_cast<T>(_iterator->second);
+		}
+	};
+protected:
+	/**
+	*	Private index of writers: changed only under 'writerLock' and published by publish().
+	*	Accessible from derived classes.
+	**/
+	Storage storage;
+	//Serialises writers
+	std::mutex writerLock;
+	//Version of index visible to readers
+	std::atomic<const Storage*> published;
+	//Phase new readers are counted in
+	mutable std::atomic<unsigned int> readerPhase;
+	/**
+	*	Reader counters of two phases placed on separate cache lines.
+	**/
+	mutable struct ReaderCounter {
+		std::atomic<unsigned int> count;
+		char padding[RCUPOLYMORPHICMAP_CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+	} readers[2];
+
+	//Registers reader in current phase, wait-free
+	inline unsigned int enter() const NOEXCEPT {
+		unsigned int _phase = readerPhase.load();
+		readers[_phase].count.fetch_add(1);
+		return _phase;
+	}
+
+	//Unregisters reader of '_phase'
+	inline void leave(const unsigned int _phase) const NOEXCEPT {
+		readers[_phase].count.fetch_sub(1);
+	}
+
+	/**
+	*	\brief Waits until every reader that could see replaced version leaves.
+	*	Readers that enter during wait are counted in other phase, so each phase is drained
+	*	in bounded time. Both phases are drained because reader may take phase before flip.
+	*	\throw nothrow
+	**/
+	void synchronize() NOEXCEPT {
+		for (int _round = 0; _round < 2; _round++) {
+			unsigned int _phase = readerPhase.load();
+			readerPhase.store(_phase ^ 1);
+			while (readers[_phase].count.load())
+				std::this_thread::yield();
+		}
+	}
+
+	/**
+	*	\brief Publishes copy of 'storage' to readers and reclaims previous version.
+	*	Must be called under 'writerLock' after every change of 'storage'.
+	*	\throw std::bad_alloc On not enougth memory: previous version stays published.
+	**/
+	void publish() {
+		const Storage* _old = published.exchange(new Storage(storage));
+		synchronize();
+		delete _old;
+	}
+
+	template < class T, class... TArgs >
+	/**
+	*	\brief Constructs object of type "T" from '_args' with allocation strategy '_strategy'.
+	*	\throw std::logic_error On exception in object constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object.
+	**/
+	static std::shared_ptr<T> create(const allocateStrategy _strategy, TArgs&&... _args) {
+		try {
+			if (_strategy == allocateStrategy::BIG)
+				return std::shared_ptr<T>(new T(std::forward<TArgs>(_args)...));
+			return std::make_shared<T>(std::forward<TArgs>(_args)...);
+		}
+		//Not enougth memory
+		catch (const std::bad_alloc&) { throw; }
+		//Warp up external exception to std::logic_error
+		catch (const std::exception& e) { throw std::logic_error(e.what()); }
+		//Provide any other throw with std::logic_error
+		catch (...) { throw std::logic_error("ERROR::RCU_POLYMORPHIC_MAP::create::Object creation error."); }
+	}
+
+	template < class T >
+	/**
+	*	\brief Copies object with index '_sourceId' to index '_Id' in private index.
+	*	Must be called under 'writerLock'.
+	*	\throw std::logic_error On exception in object copy constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object on success and to nullptr on error.
+	**/
+	std::shared_ptr<T> copy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy) {
+		auto _sourceIterator = storage.find(_sourceId);
+		if (_sourceIterator == storage.end()) {
+			#ifdef DEBUG_RCUPOLYMORPHICMAP
+				DEBUG_NEW_MESSAGE("ERROR::RCU_POLYMORPHIC_MAP::copy")
+					DEBUG_WRITE2("\tMessage: Invalid '_sourceId': ", _sourceId);
+				DEBUG_END_MESSAGE
+			#endif
+			return std::shared_ptr<T>(nullptr);
+		}
+		auto _source = std::dynamic_pointer_cast<T>(_sourceIterator->second);
+		if (!_source)
+			return std::shared_ptr<T>(nullptr);
+		allocateStrategy _effective = _strategy;
+		if (_effective == allocateStrategy::NON)
+			_effective = (_source.get()->*_getAllocStrategy)();
+		auto _newptr = create<T>(_effective, *_source);
+		storage[_Id] = _newptr;
+		return _newptr;
+	}
+public:
+
+	RcuPolymorphicMap() : published(new Storage()), readerPhase(0) {
+		readers[0].count.store(0);
+		readers[1].count.store(0);
+	}
+
+	//No reader or writer may use container during destruction
+	~RcuPolymorphicMap() NOEXCEPT { delete published.load(); }
+
+	RcuPolymorphicMap(const RcuPolymorphicMap&) = delete;
+
+	RcuPolymorphicMap& operator=(const RcuPolymorphicMap&) = delete;
+
+	//No reader or writer may use 'other' during move
+	RcuPolymorphicMap(RcuPolymorphicMap&& other) : storage(std::move(other.storage)), published(new Storage(storage)), readerPhase(0) {
+		readers[0].count.store(0);
+		readers[1].count.store(0);
+		delete other.published.exchange(new Storage());
+	}
+
+	//No reader or writer may use 'other' during move
+	RcuPolymorphicMap& operator= (RcuPolymorphicMap&& other) {
+		if (&other == this)
+			return *this;
+		std::lock_guard<std::mutex> _lock(writerLock);
+		storage = std::move(other.storage);
+		delete other.published.exchange(new Storage());
+		publish();
+		return *this;
+	}
+
+	//Public interface start
+	template < class T >
+	/**
+	*	\brief Constructs new object with index '_Id' of type "T" by calling default constructor.
+	*	Replaces object with id '_Id' if it exists.
+	*	\param[in]	_Id			Identificator of new object.
+	*	\param[in]	_strategy	Defines strategy of new object allocation.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::logic_error On exception in object default constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer of type "T" to new object.
+	**/
+	inline auto newObject(	const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT,
+							T* const _defptr = nullptr) -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_DEFCONSTR(_ObjType, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be default constuctible.")
+		auto _newptr = create<_ObjType>(_strategy);
+		std::lock_guard<std::mutex> _lock(writerLock);
+		storage[_Id] = _newptr;
+		publish();
+		return _newptr;
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs '_count' new objects of type "T" with indexes from '_Id' array.
+	*	All objects are published as one version.
+	*	\param[in]	_Id			Array of identificators of new objects.
+	*	\param[out]	_result		Array of pointers to new objects.
+	*	\param[in]	_count		Count of objects.
+	*	\param[in]	_strategy	Defines strategy of new objects allocation.
+	*	\param[out]	_success	[Optional] Array of construction results.
+	*	\throw std::bad_alloc On not enougth memory for new version.
+	*	\return Count of constructed objects.
+	**/
+	inline unsigned int newObject(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		CONCEPT_NOT_CVRP(T, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		if (!_count || !_result)
+			return 0;
+		unsigned int _allocated = 0;
+		std::lock_guard<std::mutex> _lock(writerLock);
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			try {
+				_result[_index] = create<T>(_strategy);
+				storage[_Id[_index]] = _result[_index];
+			}
+			catch (...) {
+				if (_success)
+					_success[_index] = false;
+				continue;
+			}
+			if (_success)
+				_success[_index] = true;
+			_allocated++;
+		}
+		if (_allocated)
+			publish();
+		return _allocated;
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs new object with index '_Id' from '_value'.
+	*	Replaces object with id '_Id' if it exists.
+	*	\param[in]	_value		Value to be forwarded to constructor.
+	*	\param[in]	_Id			Identificator of new object.
+	*	\param[in]	_strategy	Defines strategy of new object allocation.
+	*	\throw std::logic_error On exception in object constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object.
+	**/
+	inline auto newObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_UNREF(T, _value, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided '_value' is not rvalue or lvalue reference.")
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_CONSTRUCTIBLE_F(_ObjType, T, _value, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be constructible from '_value'.")
+		auto _newptr = create<_ObjType>(_strategy, std::forward<T>(_value));
+		std::lock_guard<std::mutex> _lock(writerLock);
+		storage[_Id] = _newptr;
+		publish();
+		return _newptr;
+	}
+
+	template < class T >
+	/**
+	*	\brief Takes ownership of object pointed by '_valueptr' and places it with index '_Id'.
+	*	\param[in]	_valueptr	Pointer to object.
+	*	\param[in]	_Id			Identificator of object.
+	*	\throw std::bad_alloc On not enougth memory for new version.
+	*	\return Shared pointer to object.
+	**/
+	inline auto newObject(T* const _valueptr, const Index _Id) -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()) {
+		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		std::shared_ptr<_ObjType> _newptr((_ObjType*)_valueptr);
+		std::lock_guard<std::mutex> _lock(writerLock);
+		storage[_Id] = _newptr;
+		publish();
+		return _newptr;
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs '_count' copies of '_value' with indexes from '_Id' array.
+	*	All objects are published as one version.
+	*	\param[in]	_value		Value to be copied.
+	*	\param[in]	_Id			Array of identificators of new objects.
+	*	\param[out]	_result		Array of pointers to new objects.
+	*	\param[in]	_count		Count of objects.
+	*	\param[in]	_strategy	Defines strategy of new objects allocation.
+	*	\param[out]	_success	[Optional] Array of construction results.
+	*	\throw std::bad_alloc On not enougth memory for new version.
+	*	\return Count of constructed objects.
+	**/
+	inline unsigned int newObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
+		CONCEPT_COPY_CONSTRUCTIBLE(T, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be copy constructible.")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		if (!_count || !_result)
+			return 0;
+		unsigned int _allocated = 0;
+		std::lock_guard<std::mutex> _lock(writerLock);
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			try {
+				_result[_index] = create<T>(_strategy, _value);
+				storage[_Id[_index]] = _result[_index];
+			}
+			catch (...) {
+				if (_success)
+					_success[_index] = false;
+				continue;
+			}
+			if (_success)
+				_success[_index] = true;
+			_allocated++;
+		}
+		if (_allocated)
+			publish();
+		return _allocated;
+	}
+
+	template < class T >
+	inline unsigned int newObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		return newObject(*_valueptr, _Id, _result, _count, _strategy, _success);
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs copy of object with index '_sourceId' and places it with index '_Id'.
+	*	Replaces object with id '_Id' if it exists.
+	*	\param[in]	_sourceId	Identificator of object to be copied.
+	*	\param[in]	_Id			Identificator of new object.
+	*	\param[in]	_strategy	Defines strategy of new object allocation, NON to use strategy of source.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::logic_error On exception in object copy constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object on success and to nullptr on error.
+	**/
+	inline auto newCopy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
+						-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newCopy::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_COPY_CONSTRUCTIBLE(_ObjType, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::newCopy::Provided type \"T\" must be copy constuctible.")
+		if (_sourceId == _Id)
+			return std::shared_ptr<_ObjType>(nullptr);
+		std::lock_guard<std::mutex> _lock(writerLock);
+		auto _newptr = copy<_ObjType>(_sourceId, _Id, _strategy);
+		if (_newptr)
+			publish();
+		return _newptr;
+	}
+
+	template < class T >
+	/**
+	*	\brief Replaces existing object with index '_destId' by copy of object with index '_sourceId'.
+	*	\param[in]	_sourceId	Identificator of object to be copied.
+	*	\param[in]	_destId		Identificator of object to be replaced.
+	*	\param[in]	_strategy	Defines strategy of new object allocation, NON to use strategy of source.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::logic_error On exception in object copy constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object on success and to nullptr on error.
+	**/
+	inline auto copyObject(	const Index _sourceId, const Index _destId,
+							const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
+							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::copyObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_COPY_CONSTRUCTIBLE(_ObjType, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::copyObject::Provided type \"T\" must be copy constuctible.")
+		if (_sourceId == _destId)
+			return std::shared_ptr<_ObjType>(nullptr);
+		std::lock_guard<std::mutex> _lock(writerLock);
+		if (!storage.count(_destId))
+			return std::shared_ptr<_ObjType>(nullptr);
+		auto _newptr = copy<_ObjType>(_sourceId, _destId, _strategy);
+		if (_newptr)
+			publish();
+		return _newptr;
+	}
+
+	template < class T >
+	/**
+	*	\brief Moves object with index '_sourceId' to index '_destId'.
+	*	Readers see object either under old or under new index, never under both.
+	*	\param[in]	_sourceId	Identificator of object to be moved.
+	*	\param[in]	_destId		New identificator of object.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to moved object on success and to nullptr on error.
+	**/
+	inline std::shared_ptr<T> moveObject(const Index _sourceId, const Index _destId, T* const _defptr = nullptr) {
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::moveObject::Provided type \"T\" must be derived from \"Base\".")
+		if (_sourceId == _destId)
+			return std::shared_ptr<T>(nullptr);
+		std::lock_guard<std::mutex> _lock(writerLock);
+		auto _sourceIterator = storage.find(_sourceId);
+		if (_sourceIterator == storage.end()) {
+			#ifdef DEBUG_RCUPOLYMORPHICMAP
+				DEBUG_NEW_MESSAGE("ERROR::RCU_POLYMORPHIC_MAP::moveObject")
+					DEBUG_WRITE2("\tMessage: Invalid '_sourceId': ", _sourceId);
+				DEBUG_END_MESSAGE
+			#endif
+			return std::shared_ptr<T>(nullptr);
+		}
+		Pointer& _dest = storage[_destId];
+		_dest = std::move(_sourceIterator->second);
+		storage.erase(_sourceIterator);
+		publish();
+		return std::dynamic_pointer_cast<T>(_dest);
+	}
+
+	template < class T >
+	/**
+	*	\brief Replaces object with index '_Id' by new object constructed from '_value'.
+	*	Creates new object if there is no object with index '_Id'.
+	*	\param[in]	_value		Value to be forwarded to constructor.
+	*	\param[in]	_Id			Identificator of object.
+	*	\param[in]	_strategy	Defines strategy of new object allocation.
+	*	\throw std::logic_error On exception in object constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object.
+	**/
+	inline auto setObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		return newObject(std::forward<T>(_value), _Id, _strategy);
+	}
+
+	template < class T >
+	inline auto setObject(T* const _valueptr, const Index _Id) -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()) {
+		return newObject(_valueptr, _Id);
+	}
+
+	template < class T >
+	inline unsigned int setObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		return newObject(_value, _Id, _result, _count, _strategy, _success);
+	}
+
+	template < class T >
+	inline unsigned int setObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		return newObject(*_valueptr, _Id, _result, _count, _strategy, _success);
+	}
+
+	template < class T >
+	/**
+	*	\brief Finds object with index '_Id' in published version.
+	*	Wait-free: never blocks behind writers.
+	*	\param[in]	_Id		Identificator of object.
+	*	\param[in]	_defptr	Parameter to make template overload possible.
+	*	\throw nothrow
+	*	\return Shared pointer to object or to nullptr if object isn't found or isn't of type "T".
+	**/
+	inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) const NOEXCEPT {
+		CONCEPT_NOT_PR(T, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::getObject::Provided type \"T\" must not be pointer or reference type.")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::RCU_POLYMORPHIC_MAP::getObject::Provided type \"T\" must be derived from \"Base\".")
+		return Snapshot(this).template getObject<T>(_Id);
+	}
+
+	/**
+	*	\brief Takes published version of index for series of lookups or walk.
+	*	Wait-free: never blocks behind writers.
+	*	\throw nothrow
+	*	\return Snapshot that keeps version alive.
+	**/
+	inline Snapshot snapshot() const NOEXCEPT { return Snapshot(this); }
+
+	//Count of objects in published version, wait-free
+	inline size_t size() const NOEXCEPT { return Snapshot(this).storage().size(); }
+
+	virtual inline bool deleteObject(const Index _Id) {
+		std::lock_guard<std::mutex> _lock(writerLock);
+		if (!storage.erase(_Id))
+			return false;
+		publish();
+		return true;
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,657 @@
+#ifndef SEGREGATEDPOLYMORPHICMAP_H
+#define SEGREGATEDPOLYMORPHICMAP_H "[multy@cSegregatedPolymorphicMap.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of polymorphic map class that stores objects
+*		of same concrete type together in chunked arrays.
+*		Identifier lookup is same as in PolymorphicMap, but objects of one type
+*		may be processed by linear walk over their chunks without virtual calls.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <vector>
+#include <memory>
+#include <typeindex>
+#include <type_traits>
+#include <stdexcept>
+#include <new>
+#include <mutex>
+//OUR
+#include "vPolymorphicContainerGeneral.hpp"
+//DEBUG
+#if defined(DEBUG_SEGREGATEDPOLYMORPHICMAP) && !defined(OTHER_DEBUG)
+	#include "general/mDebug.h"
+#elif  defined(DEBUG_SEGREGATEDPOLYMORPHICMAP) && defined(OTHER_DEBUG)
+	#include OTHER_DEBUG
+#endif
+
+#ifndef SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE
+	//Count of objects in one chunk of type storage
+	#define SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE 64
+#endif
+
+template <	class _Index, class _Base,
+			allocateStrategy (_Base::* _getAllocStrategy)() = &_Base::getAllocStrategy>
+/**
+*	Class that represents polymorthic container of map type with type-segregated object storage.
+*	Every object created by container is placed to chunk of objects of the same concrete type.
+*	Chunks never move so handed out pointers stay valid.
+*	Allocation strategy parameters are accepted for interface compatibility with PolymorphicMap and ignored.
+*	Objects passed by raw pointer are owned by container but stay outside of chunks.
+*	Class template definition: SegregatedPolymorphicMap
+**/
+class SegregatedPolymorphicMap {
+	/**
+	*	Type erased storage of objects of one concrete type.
+	**/
+	struct TypeStoreBase {
+		virtual ~TypeStoreBase() {}
+
+		//Excludes object in '_slot' from per-type walks
+		virtual void detach(unsigned int _slot) NOEXCEPT = 0;
+
+		//Includes object in '_slot' to per-type walks
+		virtual void attach(unsigned int _slot) NOEXCEPT = 0;
+	};
+
+	template < class T >
+	/**
+	*	Chunked storage of objects of type "T".
+	*	Kept alive by every handed out object so objects may outlive container.
+	*	Last reference to object may be dropped on any thread: free list and count are guarded by 'lock'.
+	*	Chunks are added only by owner of container, so owner reads them without lock.
+	**/
+	class TypeStore : public TypeStoreBase, public std::enable_shared_from_this< TypeStore<T> > {
+		struct Slot {
+			typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type object;
+			//Object is constructed in slot
+			bool alive;
+			//Object is presented in container
+			bool attached;
+
+			Slot() : alive(false), attached(false) {}
+		};
+		//Chunks of SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE slots
+		std::vector< std::unique_ptr<Slot[]> > chunks;
+		//Stack of free slots
+		std::vector<unsigned int> freeSlots;
+		//Count of alive objects
+		unsigned int count;
+		//Guards chunk list, free list and count against releases from other threads
+		std::mutex lock;
+
+		inline Slot& slotAt(unsigned int _slot) NOEXCEPT {
+			return chunks[_slot / SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE][_slot % SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE];
+		}
+
+		/**
+		*	\brief Destroys object and returns slot to free stack, may be called on any thread.
+		*	Object is detached already: container drops its reference after detach.
+		*	Destructor runs without lock, so it may release other objects of type "T".
+		*	\throw nothrow
+		**/
+		void release(unsigned int _slot) NOEXCEPT {
+			Slot* _place;
+			{
+				std::lock_guard<std::mutex> _lock(lock);
+				_place = &slotAt(_slot);
+			}
+			reinterpret_cast<T*>(&_place->object)->~T();
+			std::lock_guard<std::mutex> _lock(lock);
+			_place->alive = false;
+			count--;
+			//Reserved in acquire: can't throw
+			freeSlots.push_back(_slot);
+		}
+
+		/**
+		*	Deleter of objects in slots.
+		**/
+		struct Releaser {
+			std::shared_ptr<TypeStore> store;
+			unsigned int slot;
+
+			void operator()(T*) NOEXCEPT { store->release(slot); }
+		};
+
+		//Finds free slot, adds chunk if there is none
+		unsigned int acquire() {
+			std::lock_guard<std::mutex> _lock(lock);
+			if (freeSlots.empty()) {
+				unsigned int _first = (unsigned int)chunks.size() * SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE;
+				//std::bad_alloc may be thrown here
+				chunks.emplace_back(new Slot[SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE]);
+				freeSlots.reserve(chunks.size() * SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE);
+				for (unsigned int _index = SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE; _index; _index--)
+					freeSlots.push_back(_first + _index - 1);
+			}
+			unsigned int _slot = freeSlots.back();
+			freeSlots.pop_back();
+			return _slot;
+		}
+	public:
+		TypeStore() : count(0) {}
+
+		~TypeStore() {}
+
+		/**
+		*	\brief Constructs new object of type "T" from '_args' in free slot.
+		*	\param[out]	_slot	Slot of new object.
+		*	\param[in]	_args	Constructor arguments.
+		*	\throw Any exception of "T" constructor, std::bad_alloc.
+		*	\return Shared pointer to new object.
+		**/
+		template < class... TArgs >
+		std::shared_ptr<T> emplace(unsigned int& _slot, TArgs&&... _args) {
+			_slot = acquire();
+			Slot& _place = slotAt(_slot);
+			try { new (&_place.object) T(std::forward<TArgs>(_args)...); }
+			catch (...) {
+				std::lock_guard<std::mutex> _lock(lock);
+				freeSlots.push_back(_slot);
+				throw;
+			}
+			{
+				std::lock_guard<std::mutex> _lock(lock);
+				_place.alive = true;
+				count++;
+			}
+			_place.attached = true;
+			Releaser _releaser = { this->shared_from_this(), _slot };
+			try { return std::shared_ptr<T>(reinterpret_cast<T*>(&_place.object), std::move(_releaser)); }
+			//On exception std::shared_ptr calls deleter itself
+			catch (...) { throw; }
+		}
+
+		void detach(unsigned int _slot) NOEXCEPT { slotAt(_slot).attached = false; }
+
+		void attach(unsigned int _slot) NOEXCEPT { slotAt(_slot).attached = true; }
+
+		/**
+		*	\brief Calls '_func' for every object presented in container in order of slots.
+		*	\param[in]	_func	Functor with signature void(T&).
+		*	\throw Any exception of '_func'.
+		*	\return Count of processed objects.
+		**/
+		template < class TFunc >
+		unsigned int forEach(TFunc& _func) {
+			unsigned int _processed = 0;
+			for (auto& _chunk : chunks) {
+				Slot* _end = _chunk.get() + SEGREGATEDPOLYMORPHICMAP_CHUNK_SIZE;
+				for (Slot* _place = _chunk.get(); _place != _end; _place++) {
+					if (_place->attached) {
+						_func(*reinterpret_cast<T*>(&_place->object));
+						_processed++;
+					}
+				}
+			}
+			return _processed;
+		}
+
+		//Count of alive objects of type "T"
+		unsigned int size() NOEXCEPT {
+			std::lock_guard<std::mutex> _lock(lock);
+			return count;
+		}
+	};
+
+	//Type used as handled pointer to objects
+	typedef std::shared_ptr<_Base> Pointer;
+public:
+	//Type used as index.
+	typedef _Index Index;
+	//Type used as base type of handled objects.
+	typedef _Base Base;
+
+	/**
+	*	Storage entry: pointer to object and location of object in type storage.
+	*	Entry excludes object from per-type walks when it leaves container.
+	*	Class definition: Member
+	**/
+	class Member : public Pointer {
+		friend class SegregatedPolymorphicMap;
+		//Type storage of object, nullptr for objects outside of chunks
+		TypeStoreBase* store;
+		//Slot of object in type storage
+		unsigned int slot;
+
+		void detach() NOEXCEPT {
+			if (store)
+				store->detach(slot);
+			store = nullptr;
+		}
+	public:
+		Member() NOEXCEPT : store(nullptr), slot(0) {}
+
+		Member(const Pointer& _pointer) NOEXCEPT : Pointer(_pointer), store(nullptr), slot(0) {}
+
+		~Member() NOEXCEPT { detach(); }
+
+		Member(const Member&) = delete;
+
+		Member& operator=(const Member&) = delete;
+
+		Member(Member&& other) NOEXCEPT : Pointer(std::move(other)), store(other.store), slot(other.slot) { other.store = nullptr; }
+
+		Member& operator=(Member&& other) NOEXCEPT {
+			if (&other == this)
+				return *this;
+			detach();
+			Pointer::operator=(std::move(other));
+			store = other.store;
+			slot = other.slot;
+			other.store = nullptr;
+			return *this;
+		}
+
+		Member& operator=(const Pointer& _pointer) NOEXCEPT {
+			detach();
+			Pointer::operator=(_pointer);
+			return *this;
+		}
+
+		void swap(Member& other) NOEXCEPT {
+			Pointer::swap(other);
+			std::swap(store, other.store);
+			std::swap(slot, other.slot);
+		}
+	};
+	//Type of internal storage.
+	typedef std::map<_Index, Member> Storage;
+	//Type of storage of type stores.
+	typedef std::map<std::type_index, std::shared_ptr<TypeStoreBase>> TypeStorage;
+protected:
+	/**
+	*	Storage of pointers to handled objects.
+	*	Accessible from derived classes.
+	**/
+	Storage storage;
+	/**
+	*	Type segregated storage of objects: one type storage per concrete type.
+	**/
+	TypeStorage types;
+
+	template < class T >
+	/**
+	*	\brief Finds storage of objects of type "T", creates it if there is none.
+	*	\throw std::bad_alloc
+	*	\return Pointer to type storage.
+	**/
+	TypeStore<T>* typeStore() {
+		auto& _store = types[std::type_index(typeid(T))];
+		if (!_store)
+			_store = std::make_shared< TypeStore<T> >();
+		return static_cast<TypeStore<T>*>(_store.get());
+	}
+
+	template < class T, class... TArgs >
+	/**
+	*	\brief Constructs object of type "T" from '_args' in type storage and places it with index '_Id'.
+	*	Existing object with index '_Id' is replaced.
+	*	\param[in]	_Id		Identificator of new object.
+	*	\param[in]	_args	Constructor arguments.
+	*	\throw std::logic_error On exception in object constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object.
+	**/
+	std::shared_ptr<T> emplace(const Index _Id, TArgs&&... _args) {
+		std::shared_ptr<T> _newptr(nullptr);
+		unsigned int _slot = 0;
+		TypeStore<T>* _store = typeStore<T>();
+		try { _newptr = _store->emplace(_slot, std::forward<TArgs>(_args)...); }
+		//Not enougth memory
+		catch (const std::bad_alloc&) { throw; }
+		//Warp up external exception to std::logic_error
+		catch (const std::exception& e) { throw std::logic_error(e.what()); }
+		//Provide any other throw with std::logic_error
+		catch (...) { throw std::logic_error("ERROR::SEGREGATED_POLYMORPHIC_MAP::emplace::Object creation error."); }
+		Member& _member = storage[_Id];
+		_member = _newptr;
+		_member.store = _store;
+		_member.slot = _slot;
+		return _newptr;
+	}
+public:
+
+	SegregatedPolymorphicMap() = default;
+
+	~SegregatedPolymorphicMap() = default;
+
+	SegregatedPolymorphicMap(const SegregatedPolymorphicMap&) = delete;
+
+	SegregatedPolymorphicMap& operator=(const SegregatedPolymorphicMap&) = delete;
+
+	SegregatedPolymorphicMap(SegregatedPolymorphicMap&& other) NOEXCEPT : storage(std::move(other.storage)), types(std::move(other.types)) {}
+
+	SegregatedPolymorphicMap& operator= (SegregatedPolymorphicMap&& other) NOEXCEPT {
+		storage = std::move(other.storage);
+		types = std::move(other.types);
+		return *this;
+	}
+
+	//Public interface start
+	template < class T >
+	/**
+	*	\brief Constructs new object with index '_Id' of type "T" by calling default constructor.
+	*	Replaces object with id '_Id' if it exists.
+	*	\param[in]	_Id			Identificator of new object.
+	*	\param[in]	_strategy	Ignored.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::logic_error On exception in object default constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer of type "T" to new object.
+	**/
+	inline auto newObject(	const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT,
+							T* const _defptr = nullptr) -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_DEFCONSTR(_ObjType, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be default constuctible.")
+		return emplace<_ObjType>(_Id);
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs '_count' new objects of type "T" with indexes from '_Id' array.
+	*	\param[in]	_Id			Array of identificators of new objects.
+	*	\param[out]	_result		Array of pointers to new objects.
+	*	\param[in]	_count		Count of objects.
+	*	\param[in]	_strategy	Ignored.
+	*	\param[out]	_success	[Optional] Array of construction results.
+	*	\throw nothrow
+	*	\return Count of constructed objects.
+	**/
+	inline unsigned int newObject(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		CONCEPT_NOT_CVRP(T, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
+		if (!_count || !_result)
+			return 0;
+		unsigned int _allocated = 0;
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			try { _result[_index] = newObject<T>(_Id[_index], _strategy); }
+			catch (...) {
+				if (_success)
+					_success[_index] = false;
+				continue;
+			}
+			if (_success)
+				_success[_index] = true;
+			_allocated++;
+		}
+		return _allocated;
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs new object with index '_Id' from '_value'.
+	*	Replaces object with id '_Id' if it exists.
+	*	\param[in]	_value		Value to be forwarded to constructor.
+	*	\param[in]	_Id			Identificator of new object.
+	*	\param[in]	_strategy	Ignored.
+	*	\throw std::logic_error On exception in object constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object.
+	**/
+	inline auto newObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_UNREF(T, _value, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided '_value' is not rvalue or lvalue reference.")
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_CONSTRUCTIBLE_F(_ObjType, T, _value, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be constructible from '_value'.")
+		return emplace<_ObjType>(_Id, std::forward<T>(_value));
+	}
+
+	template < class T >
+	/**
+	*	\brief Takes ownership of object pointed by '_valueptr' and places it with index '_Id'.
+	*	Object stays outside of type storage and isn't visited by forEachOf.
+	*	\param[in]	_valueptr	Pointer to object.
+	*	\param[in]	_Id			Identificator of object.
+	*	\throw nothrow
+	*	\return Shared pointer to object.
+	**/
+	inline auto newObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()) {
+		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		std::shared_ptr<_ObjType> _newptr((_ObjType*)_valueptr);
+		storage[_Id] = _newptr;
+		return _newptr;
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs '_count' copies of '_value' with indexes from '_Id' array.
+	*	\param[in]	_value		Value to be copied.
+	*	\param[in]	_Id			Array of identificators of new objects.
+	*	\param[out]	_result		Array of pointers to new objects.
+	*	\param[in]	_count		Count of objects.
+	*	\param[in]	_strategy	Ignored.
+	*	\param[out]	_success	[Optional] Array of construction results.
+	*	\throw nothrow
+	*	\return Count of constructed objects.
+	**/
+	inline unsigned int newObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
+		CONCEPT_COPY_CONSTRUCTIBLE(T, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be copy constructible.")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		if (!_count)
+			return _count;
+		unsigned int _allocated = 0;
+		for (unsigned int _index = 0; _index < _count; _index++) {
+			try { _result[_index] = emplace<T>(_Id[_index], _value); }
+			catch (...) {
+				if (_success)
+					_success[_index] = false;
+				continue;
+			}
+			if (_success)
+				_success[_index] = true;
+			_allocated++;
+		}
+		return _allocated;
+	}
+
+	template < class T >
+	inline unsigned int newObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		return newObject(*_valueptr, _Id, _result, _count, _strategy, _success);
+	}
+
+	template < class T >
+	/**
+	*	\brief Constructs copy of object with index '_sourceId' and places it with index '_Id'.
+	*	Replaces object with id '_Id' if it exists.
+	*	\param[in]	_sourceId	Identificator of object to be copied.
+	*	\param[in]	_Id			Identificator of new object.
+	*	\param[in]	_strategy	Ignored.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::logic_error On exception in object copy constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object on success and to nullptr on error.
+	**/
+	inline auto newCopy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
+						-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newCopy::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_COPY_CONSTRUCTIBLE(_ObjType, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::newCopy::Provided type \"T\" must be copy constuctible.")
+		if (_sourceId == _Id)
+			return std::shared_ptr<_ObjType>(nullptr);
+		auto _sourceIterator = storage.find(_sourceId);
+		if (_sourceIterator == storage.end()) {
+			#ifdef DEBUG_SEGREGATEDPOLYMORPHICMAP
+				DEBUG_NEW_MESSAGE("ERROR::SEGREGATED_POLYMORPHIC_MAP::newCopy")
+					DEBUG_WRITE2("\tMessage: Invalid '_sourceId': ", _sourceId);
+				DEBUG_END_MESSAGE
+			#endif
+			return std::shared_ptr<_ObjType>(nullptr);
+		}
+		//Keep source alive: it may be replaced by emplace
+		auto _source = std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second);
+		if (!_source)
+			return std::shared_ptr<_ObjType>(nullptr);
+		return emplace<_ObjType>(_Id, *_source);
+	}
+
+	template < class T >
+	/**
+	*	\brief Replaces existing object with index '_destId' by copy of object with index '_sourceId'.
+	*	\param[in]	_sourceId	Identificator of object to be copied.
+	*	\param[in]	_destId		Identificator of object to be replaced.
+	*	\param[in]	_strategy	Ignored.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::logic_error On exception in object copy constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object on success and to nullptr on error.
+	**/
+	inline auto copyObject(	const Index _sourceId, const Index _destId,
+							const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
+							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::copyObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_COPY_CONSTRUCTIBLE(_ObjType, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::copyObject::Provided type \"T\" must be copy constuctible.")
+		if (_sourceId == _destId || !storage.count(_destId))
+			return std::shared_ptr<_ObjType>(nullptr);
+		return newCopy<_ObjType>(_sourceId, _destId, _strategy);
+	}
+
+	template < class T >
+	/**
+	*	\brief Moves object with index '_sourceId' to index '_destId'.
+	*	Object stays in its slot, only index is changed.
+	*	\param[in]	_sourceId	Identificator of object to be moved.
+	*	\param[in]	_destId		New identificator of object.
+	*	\param[in]	_defptr		Parameter to make template overload possible.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to moved object on success and to nullptr on error.
+	**/
+	inline std::shared_ptr<T> moveObject(const Index _sourceId, const Index _destId, T* const _defptr = nullptr) {
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::moveObject::Provided type \"T\" must be derived from \"Base\".")
+		if (_sourceId == _destId)
+			return std::shared_ptr<T>(nullptr);
+		auto _sourceIterator = storage.find(_sourceId);
+		if (_sourceIterator == storage.end()) {
+			#ifdef DEBUG_SEGREGATEDPOLYMORPHICMAP
+				DEBUG_NEW_MESSAGE("ERROR::SEGREGATED_POLYMORPHIC_MAP::moveObject")
+					DEBUG_WRITE2("\tMessage: Invalid '_sourceId': ", _sourceId);
+				DEBUG_END_MESSAGE
+			#endif
+			return std::shared_ptr<T>(nullptr);
+		}
+		Member& _dest = storage[_destId];
+		_dest.swap(_sourceIterator->second);
+		storage.erase(_sourceIterator);
+		return std::dynamic_pointer_cast<T>(_dest);
+	}
+
+	template < class T >
+	/**
+	*	\brief Replaces object with index '_Id' by new object constructed from '_value'.
+	*	Creates new object if there is no object with index '_Id'.
+	*	\param[in]	_value		Value to be forwarded to constructor.
+	*	\param[in]	_Id			Identificator of object.
+	*	\param[in]	_strategy	Ignored.
+	*	\throw std::logic_error On exception in object constructor.
+	*	\throw std::bad_alloc On not enougth memory.
+	*	\return Shared pointer to new object.
+	**/
+	inline auto setObject(	T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
+	{
+		CONCEPT_CLEAR_TYPE(T, _ObjType)
+		CONCEPT_UNREF(T, _value, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::setObject::Provided '_value' is not rvalue or lvalue reference.")
+		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::setObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_CONSTRUCTIBLE_F(_ObjType, T, _value, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::setObject::Provided type \"T\" must be constructible from '_value'.")
+		return emplace<_ObjType>(_Id, std::forward<T>(_value));
+	}
+
+	template < class T >
+	inline auto setObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()) {
+		return newObject(_valueptr, _Id);
+	}
+
+	template < class T >
+	inline unsigned int setObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		return newObject(_value, _Id, _result, _count, _strategy, _success);
+	}
+
+	template < class T >
+	inline unsigned int setObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+									const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
+	{
+		return newObject(*_valueptr, _Id, _result, _count, _strategy, _success);
+	}
+
+	template < class T >
+	/**
+	*	\brief Finds object with index '_Id'.
+	*	\param[in]	_Id		Identificator of object.
+	*	\param[in]	_defptr	Parameter to make template overload possible.
+	*	\throw nothrow
+	*	\return Shared pointer to object or to nullptr if object isn't found or isn't of type "T".
+	**/
+	inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) NOEXCEPT {
+		CONCEPT_NOT_PR(T, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::getObject::Provided type \"T\" must not be pointer or reference type.")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::getObject::Provided type \"T\" must be derived from \"Base\".")
+		auto _iterator = storage.find(_Id);
+		if (_iterator == storage.end()) {
+			#ifdef DEBUG_SEGREGATEDPOLYMORPHICMAP
+				DEBUG_NEW_MESSAGE("ERROR::SEGREGATED_POLYMORPHIC_MAP::getObject")
+					DEBUG_WRITE3("\tMessage: Identifier '_Id': ", _Id, " doesn't exist.");
+				DEBUG_END_MESSAGE
+			#endif
+			return std::shared_ptr<T>(nullptr);
+		}
+		return std::dynamic_pointer_cast<T>(_iterator->second);
+	}
+
+	virtual inline bool deleteObject(const Index _Id) {
+		storage.erase(_Id);
+		return true;
+	}
+
+	template < class T, class TFunc >
+	/**
+	*	\brief Calls '_func' for every object of concrete type "T" presented in container.
+	*	Objects are visited in storage order, not in index order. Objects of types derived from "T"
+	*	and objects passed by raw pointer aren't visited.
+	*	'_func' receives "T&" so calls to final or qualified members of "T" aren't virtual.
+	*	Container must not be changed from '_func'.
+	*	\param[in]	_func	Functor with signature void(T&).
+	*	\throw Any exception of '_func'.
+	*	\return Count of processed objects.
+	**/
+	unsigned int forEachOf(TFunc _func) {
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::SEGREGATED_POLYMORPHIC_MAP::forEachOf::Provided type \"T\" must be derived from \"Base\".")
+		auto _iterator = types.find(std::type_index(typeid(T)));
+		if (_iterator == types.end())
+			return 0;
+		return static_cast<TypeStore<T>*>(_iterator->second.get())->forEach(_func);
+	}
+
+	template < class T >
+	/**
+	*	\brief Counts alive objects of concrete type "T" in type storage.
+	*	Count includes objects removed from container but still referenced outside.
+	**/
+	unsigned int countOf() NOEXCEPT {
+		auto _iterator = types.find(std::type_index(typeid(T)));
+		if (_iterator == types.end())
+			return 0;
+		return static_cast<TypeStore<T>*>(_iterator->second.get())->size();
+	}
+};
+#endif
\ No newline at end of file
@@ -15,16 +15,28 @@
 #include <cstring>
 #include <string.h>
 #include <stdexcept>
+#include <fstream>
 //OUR
-#include "general\vs2013tweaks.h"
-#include "general\mConcepts.hpp"
+#include "general/vs2013tweaks.h"
+#include "general/mConcepts.hpp"
+#include "general/cMappedFile.hpp"
 //DEBUG
 #if defined(DEBUG_SIMPLEINDEXPOOL) && !defined(OTHER_DEBUG)
-	#include "general\mDebug.h"		
+	#include "general/mDebug.h"		
 #elif defined(DEBUG_SIMPLEINDEXPOOL) && defined(OTHER_DEBUG)
 	#include OTHER_DEBUG
 #endif
 
+#ifndef SIMPLEINDEXPOOL_IMAGE_MAGIC
+	//Magic number of pool image file: "SIPI"
+	#define SIMPLEINDEXPOOL_IMAGE_MAGIC 0x49504953
+#endif
+
+#ifndef SIMPLEINDEXPOOL_IMAGE_VERSION
+	//Version of pool image file layout
+	#define SIMPLEINDEXPOOL_IMAGE_VERSION 1
+#endif
+
 template < class TIndex = int >
 /**
 *	\brief Performs time efficient index handling with simple algorithms.
@@ -34,6 +46,32 @@ template < class TIndex = int >
 *	Class template definition: SimpleIndexPool
 **/
 class SimpleIndexPool {
+public:
+	/**
+	*	Header of raw pool image. Bucket array follows header directly.
+	*	Image layout is platform dependent (endianness, sizeof(Bucket)), header fields are checked on load.
+	**/
+	struct ImageHeader {
+		//Must be SIMPLEINDEXPOOL_IMAGE_MAGIC
+		unsigned int magic;
+		//Must be SIMPLEINDEXPOOL_IMAGE_VERSION
+		unsigned int version;
+		//sizeof(TIndex) of pool that made image
+		unsigned int indexSize;
+		//sizeof(Bucket) of pool that made image
+		unsigned int bucketSize;
+		//Interval of pool
+		unsigned long long minIndex;
+		unsigned long long maxIndex;
+		//Length of bucket array
+		unsigned int length;
+		//Count of used bits in last bucket
+		unsigned int tail;
+		//Bucket offset of linear search position
+		unsigned int currentPosition;
+		unsigned int reserved;
+	};
+private:
 	CONCEPT_INTEGRAL(TIndex, "ASSERTION_ERROR::SIMPLE_INDEX_POOL::Provided type \"TIndex\" must be integral.")
 	//Bitset storage of state of index allocation
 	typedef unsigned int Bucket;
@@ -52,6 +90,8 @@ class SimpleIndexPool {
 	//Maximal and minimal possible indexes
 	TIndex minIndex;
 	TIndex maxIndex;
+	//Memory mapped image that holds 'pool' if pool is mapped
+	MappedFile image;
 
 	/**
 	*	\brief Performs index search based on last linear index search defined by 'currentPosition' pointer.
@@ -224,6 +264,52 @@ class SimpleIndexPool {
 		//return (TIndex)0;
 		return notFoundIndex;
 	}
+	/**
+	*	\brief Fills image header by current pool state.
+	*	\param[out]	_header	Header to be filled.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void fillImageHeader(ImageHeader& _header) NOEXCEPT {
+		_header.magic = SIMPLEINDEXPOOL_IMAGE_MAGIC;
+		_header.version = SIMPLEINDEXPOOL_IMAGE_VERSION;
+		_header.indexSize = sizeof(TIndex);
+		_header.bucketSize = sizeof(Bucket);
+		_header.minIndex = (unsigned long long)minIndex;
+		_header.maxIndex = (unsigned long long)maxIndex;
+		_header.length = length;
+		_header.tail = tail;
+		_header.currentPosition = (unsigned int)(currentPosition - pool);
+		_header.reserved = 0;
+	}
+
+	/**
+	*	\brief Checks that image with header '_header' was made by pool with same interval and layout.
+	*	\param[in]	_header	Header to be checked.
+	*	\throw nothrow
+	*	\return Compatibility of image.
+	**/
+	bool isCompatibleImage(const ImageHeader& _header) NOEXCEPT {
+		return	_header.magic == SIMPLEINDEXPOOL_IMAGE_MAGIC && _header.version == SIMPLEINDEXPOOL_IMAGE_VERSION &&
+				_header.indexSize == sizeof(TIndex) && _header.bucketSize == sizeof(Bucket) &&
+				_header.minIndex == (unsigned long long)minIndex && _header.maxIndex == (unsigned long long)maxIndex &&
+				_header.length == length && _header.tail == tail && _header.currentPosition < length;
+	}
+
+	/**
+	*	Releases bucket storage: heap memory is deleted, mapped image is updated and unmapped.
+	**/
+	void releasePool() NOEXCEPT {
+		if (image.isOpen()) {
+			if (pool)
+				((ImageHeader*)image.data())->currentPosition = (unsigned int)(currentPosition - pool);
+			image.close();
+		} else {
+			delete[] pool;
+		}
+		pool = nullptr;
+		currentPosition = nullptr;
+	}
 protected:
 	//Special index that indicates that no indexes was found.
 	TIndex notFoundIndex;
@@ -279,7 +365,7 @@ public:
 
 		MaxAllocationHelper(MaxAllocationHelper&& other) : 
 							partitions(other.partitions),	allocatedCount(other.allocatedCount),
-							realCount(sother.realCount),	length(other.length),
+							realCount(other.realCount),	length(other.length),
 							tailLength(other.tailLength),	totalAllocatedCount(other.totalAllocatedCount)
 		{
 			other.partitions = nullptr;
@@ -298,6 +384,7 @@ public:
 			tailLength = other.tailLength;
 			totalAllocatedCount = other.totalAllocatedCount;
 			other.partitions = nullptr;
+			return *this;
 		}
 
 		//Proper memory cleaning
@@ -342,15 +429,16 @@ public:
 		currentPosition = pool;
 	}
 
-	~SimpleIndexPool() NOEXCEPT {
-		currentPosition = nullptr;
-		delete[] pool; 
-	}
+	~SimpleIndexPool() NOEXCEPT { releasePool(); }
 
+	/**
+	*	Copy of mapped pool is always stored in heap memory.
+	**/
 	SimpleIndexPool(const SimpleIndexPool& other) : minIndex(other.minIndex),
 													maxIndex(other.maxIndex),
 													notFoundIndex(other.notFoundIndex),
 													size(other.size),
+													bucketBitSize(other.bucketBitSize),
 													tail(other.tail),
 													length(other.length)
 	{
@@ -364,11 +452,12 @@ public:
 	SimpleIndexPool& operator= (const SimpleIndexPool& other) {
 		if (&other == this)
 			return *this;
-		delete[] pool;
+		releasePool();
 		minIndex = other.minIndex;
 		maxIndex = other.maxIndex;
 		notFoundIndex = other.notFoundIndex;
 		size = other.size;
+		bucketBitSize = other.bucketBitSize;
 		tail = other.tail;
 		length = other.length;
 		//ERROR::SIMPLE_INDEX_POOL::CopyAssignment::System can't allocate memory for pool.
@@ -376,6 +465,7 @@ public:
 		pool = new Bucket[length];
 		std::memcpy(pool, other.pool, length * sizeof(Bucket));
 		currentPosition = pool + (other.currentPosition - other.pool);
+		return *this;
 	}
 
 	SimpleIndexPool(SimpleIndexPool&& other) NOEXCEPT_IF(CONCEPT_NOEXCEPT_MOVE_CONSTRUCTIBLE_V(TIndex)) :
@@ -383,9 +473,11 @@ public:
 					maxIndex(std::move(other.maxIndex)),
 					notFoundIndex(std::move(other.notFoundIndex)),
 					size(other.size),
+					bucketBitSize(other.bucketBitSize),
 					currentPosition(other.currentPosition),
 					tail(other.tail),
-					length(other.length)
+					length(other.length),
+					image(std::move(other.image))
 	{
 		//ERROR::SIMPLE_INDEX_POOL::MoveConstructor::Empty pool of rvalue.
 		pool = other.pool;
@@ -394,13 +486,17 @@ public:
 	}
 
 	SimpleIndexPool& operator= (SimpleIndexPool&& other) NOEXCEPT_IF(CONCEPT_NOEXCEPT_MOVE_CONSTRUCTIBLE_V(TIndex)) {
-		delete[] pool;
+		if (&other == this)
+			return *this;
+		releasePool();
 		minIndex = std::move(other.minIndex);
 		maxIndex = std::move(other.maxIndex);
 		notFoundIndex = std::move(other.notFoundIndex);
 		size = other.size;
+		bucketBitSize = other.bucketBitSize;
 		tail = other.tail;
 		length = other.length;
+		image = std::move(other.image);
 		//ERROR::SIMPLE_INDEX_POOL::MoveAssignment::Empty pool of rvalue.
 		pool = other.pool;
 		currentPosition = other.currentPosition;
@@ -408,6 +504,7 @@ public:
 			currentPosition = pool;
 		other.pool = nullptr;
 		other.currentPosition = nullptr;
+		return *this;
 	}
 
 	/**
@@ -576,7 +673,7 @@ public:
 		}
 		//Copy tail buffer
 		_currentPtr = _resultPtr + (_buff.realCount - 1) * _buff.length;
-		std::memcpy(_currentPtr, _buff.partitions[_index], _buff.tailLength * sizeof(TIndex));
+		std::memcpy(_currentPtr, _buff.partitions[_buff.realCount - 1], _buff.tailLength * sizeof(TIndex));
 		_currentPtr = nullptr;
 		return _resultPtr;
 	}
@@ -674,5 +771,131 @@ public:
 		ptr = nullptr;
 		return _result;
 	}
+
+	/**
+	*	\brief Writes current pool state to raw image file '_path'.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of writing.
+	**/
+	bool saveImage(const char* _path) NOEXCEPT {
+		if (!pool)
+			return false;
+		if (image.isOpen())
+			syncImage();
+		ImageHeader _header;
+		fillImageHeader(_header);
+		try {
+			std::ofstream _file(_path, std::ios::out | std::ios::binary | std::ios::trunc);
+			_file.write((const char*)&_header, sizeof(ImageHeader));
+			_file.write((const char*)pool, length * sizeof(Bucket));
+			return _file.good();
+		}
+		catch (...) {
+			#if defined(DEBUG_SIMPLEINDEXPOOL) && defined(WARNINGS_SIMPLEINDEXPOOL)
+				DEBUG_NEW_MESSAGE("WARNING::SIMPLE_INDEX_POOL::saveImage")
+					DEBUG_WRITE2("\tMessage: Can't write image: ", _path);
+				DEBUG_END_MESSAGE
+			#endif
+			return false;
+		}
+	}
+
+	/**
+	*	\brief Reads pool state from raw image file '_path' to heap memory.
+	*	Image must be made by pool with same interval and index type.
+	*	Pool state is unchanged on failure.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of reading.
+	**/
+	bool loadImage(const char* _path) NOEXCEPT {
+		Bucket* _buckets = nullptr;
+		ImageHeader _header;
+		try {
+			std::ifstream _file(_path, std::ios::in | std::ios::binary);
+			_file.read((char*)&_header, sizeof(ImageHeader));
+			if (!_file.good() || !isCompatibleImage(_header))
+				return false;
+			_buckets = new Bucket[length];
+			_file.read((char*)_buckets, length * sizeof(Bucket));
+			if (!_file.good()) {
+				delete[] _buckets;
+				return false;
+			}
+		}
+		catch (...) {
+			delete[] _buckets;
+			return false;
+		}
+		releasePool();
+		pool = _buckets;
+		currentPosition = pool + _header.currentPosition;
+		return true;
+	}
+
+	/**
+	*	\brief Moves pool state to read-write memory mapped image file '_path'.
+	*	If file is absent or empty it is created from current pool state,
+	*	otherwise pool state is replaced by state stored in file.
+	*	All later changes of pool are made directly in mapped file, so restarted process
+	*	that maps same file gets exactly the same set of used indexes.
+	*	Existing file is validated before mapping and never extended: incompatible file is left as is.
+	*	Pool state is unchanged on failure.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of mapping.
+	**/
+	bool mapImage(const char* _path) NOEXCEPT {
+		if (!pool)
+			return false;
+		const size_t _imageSize = sizeof(ImageHeader) + length * sizeof(Bucket);
+		bool _existing = false;
+		try {
+			std::ifstream _probe(_path, std::ios::in | std::ios::binary | std::ios::ate);
+			_existing = _probe.is_open() && _probe.tellg() > 0;
+		}
+		catch (...) { return false; }
+		MappedFile _file;
+		//Only new image is created with its size: existing file is mapped as is
+		if (!_file.open(_path, _existing ? 0 : _imageSize))
+			return false;
+		ImageHeader* _header = (ImageHeader*)_file.data();
+		Bucket* _buckets = (Bucket*)((char*)_file.data() + sizeof(ImageHeader));
+		if (!_existing) {
+			//New file: store current state
+			fillImageHeader(*_header);
+			std::memcpy(_buckets, pool, length * sizeof(Bucket));
+		} else if (_file.size() < _imageSize || !isCompatibleImage(*_header)) {
+			#if defined(DEBUG_SIMPLEINDEXPOOL) && defined(WARNINGS_SIMPLEINDEXPOOL)
+				DEBUG_NEW_MESSAGE("WARNING::SIMPLE_INDEX_POOL::mapImage")
+					DEBUG_WRITE2("\tMessage: Image isn't compatible with pool: ", _path);
+				DEBUG_END_MESSAGE
+			#endif
+			return false;
+		}
+		releasePool();
+		pool = _buckets;
+		currentPosition = pool + _header->currentPosition;
+		image = std::move(_file);
+		return true;
+	}
+
+	/**
+	*	\brief Writes linear search position to mapped image and flushes it to disk.
+	*	\throw nothrow
+	*	\return Success of flush, false if pool isn't mapped.
+	**/
+	bool syncImage() NOEXCEPT {
+		if (!image.isOpen() || !pool)
+			return false;
+		((ImageHeader*)image.data())->currentPosition = (unsigned int)(currentPosition - pool);
+		return image.sync();
+	}
+
+	/**
+	*	Checks that pool is stored in memory mapped image.
+	**/
+	bool isMapped() NOEXCEPT { return image.isOpen(); }
 };
 #endif
\ No newline at end of file
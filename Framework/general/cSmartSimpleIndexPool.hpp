@@ -17,12 +17,12 @@
 #include <string.h>
 #include <stdexcept>
 //OUR
-#include "general\vs2013tweaks.h"
-#include "general\mConcepts.hpp"
+#include "general/vs2013tweaks.h"
+#include "general/mConcepts.hpp"
 #include "cSimpleIndexPool.hpp"
 //DEBUG
 #if defined(DEBUG_SMARTSIMPLEINDEXPOOL) && !defined(OTHER_DEBUG)
-	#include "general\mDebug.h"		
+	#include "general/mDebug.h"		
 #elif defined(DEBUG_SMARTSIMPLEINDEXPOOL) && defined(OTHER_DEBUG)
 	#include OTHER_DEBUG
 #endif
@@ -45,31 +45,93 @@ class SmartSimpleIndexPool : public SimpleIndexPool<TIndex> {
 	//Estimated size of periodic requests
 	unsigned int meanRequestSize;
 	//Hide public interface of SimpleIndexPool
-	Base::newIndex;
-	Base::startLocation;
-	Base::deleteIndex;
-	Base::allocateMax;
-	Base::allocateMaxByArray;
+	using Base::newIndex;
+	using Base::startLocation;
+	using Base::deleteIndex;
+	using Base::allocateMax;
+	using Base::allocateMaxByArray;
+
+	/**
+	*	\brief Allocates up to '_count' indexes from base pool to '_array'.
+	*	Linear search of base pool doesn't wrap around, so search is restarted
+	*	from the interval start if end of interval was reached.
+	*	\param[out]	_array	Array filled with new indexes.
+	*	\param[in]	_count	Count of indexes to be allocated.
+	*	\throw nothrow
+	*	\return Count of successfully allocated indexes.
+	**/
+	unsigned int stockUp(TIndex _array[], unsigned int _count) NOEXCEPT {
+		unsigned int _allocated = Base::newIndex(_array, _count);
+		if (_allocated == _count)
+			return _allocated;
+		TIndex _first = Base::newIndex(0);
+		if (_first == this->notFoundIndex)
+			return _allocated;
+		_array[_allocated++] = _first;
+		return _allocated + Base::newIndex(_array + _allocated, _count - _allocated);
+	}
+
+	/**
+	*	\brief Tops up stock of preallocated indexes from base pool.
+	*	Stock is never shrunk: nothing is allocated if it already holds '_size' indexes.
+	*	\param[in]	_size	Wanted count of stocked indexes. Must not exceed 2 * meanRequestSize.
+	*	\throw nothrow
+	*	\return Count of stocked indexes after refill.
+	**/
+	unsigned int growStock(unsigned int _size) NOEXCEPT {
+		unsigned int _inStock = (unsigned int)(topPtr - preallocatedPool + 1);
+		if (_size > _inStock)
+			topPtr += stockUp(topPtr + 1, _size - _inStock);
+		return (unsigned int)(topPtr - preallocatedPool + 1);
+	}
+
+	/**
+	*	\brief Returns stocked preallocated indexes to base pool.
+	*	Used to store only really given indexes in pool image.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void releasePreallocated() NOEXCEPT {
+		if (!preallocatedPool)
+			return;
+		for (TIndex* _ptr = preallocatedPool; _ptr <= topPtr; _ptr++)
+			Base::deleteIndex(*_ptr);
+		topPtr = preallocatedPool - 1;
+	}
+
+	/**
+	*	\brief Fills stock of preallocated indexes from base pool.
+	*	\throw nothrow
+	*	\return noreturn
+	**/
+	void refillPreallocated() NOEXCEPT {
+		if (!preallocatedPool)
+			return;
+		growStock(meanRequestSize * 2);
+	}
 public:
 
 	SmartSimpleIndexPool() = delete;
 
 	SmartSimpleIndexPool(	TIndex _min, TIndex _max, unsigned int _meanRequestSize) : 
-							SimpleIndexPool(_max, _min), meanRequestSize(_meanRequestSize)
+							Base(_min, _max), meanRequestSize(_meanRequestSize)
 	{
 		//ERROR::SMART_SIMPLE_INDEX_POOL::Constructor::System can't allocate memory for preallocated pool.
 		//std::bad_alloc may be thrown here
 		preallocatedPool = new TIndex[meanRequestSize * 2];
-		auto _allocated = SimpleIndexPool::newIndex(preallocatedPool, meanRequestSize * 2);
-		topPtr = preallocatedPool + _allocated - 1;
+		topPtr = preallocatedPool - 1;
+		growStock(meanRequestSize * 2);
 	}
 
 	~SmartSimpleIndexPool() NOEXCEPT { 
+		//Stocked indexes must not stay allocated in mapped image
+		if (Base::isMapped())
+			releasePreallocated();
 		topPtr = nullptr;
 		delete[] preallocatedPool; 
 	}
 
-	SmartSimpleIndexPool(const SmartSimpleIndexPool& other) :	SimpleIndexPool(other),
+	SmartSimpleIndexPool(const SmartSimpleIndexPool& other) :	Base(other),
 																meanRequestSize(other.meanRequestSize)
 	{
 		//ERROR::SMART_SIMPLE_INDEX_POOL::CopyConstructor::System can't allocate memory for preallocated pool.
@@ -83,7 +145,7 @@ public:
 		if (&other == this)
 			return *this;
 		//std::bad_alloc may be thrown here
-		SimpleIndexPool::operator=(other);
+		Base::operator=(other);
 		delete[] preallocatedPool;
 		meanRequestSize = other.meanRequestSize;
 		//ERROR::SMART_SIMPLE_INDEX_POOL::CopyAssignment::System can't allocate memory for preallocated pool.
@@ -91,24 +153,31 @@ public:
 		preallocatedPool = new TIndex[meanRequestSize * 2];
 		std::memcpy(preallocatedPool, other.preallocatedPool, meanRequestSize * 2 * sizeof(TIndex));
 		topPtr = preallocatedPool + (other.topPtr - other.preallocatedPool);
+		return *this;
 	}
 
 	SmartSimpleIndexPool(SmartSimpleIndexPool&& other)	NOEXCEPT_IF(CONCEPT_NOEXCEPT_MOVE_CONSTRUCTIBLE_V(Base)) :
-														SimpleIndexPool(std::move(other))
+														Base(std::move(other)),
+														meanRequestSize(other.meanRequestSize)
 	{
 		preallocatedPool = other.preallocatedPool;
+		topPtr = other.topPtr;
 		other.preallocatedPool = nullptr;
 		other.topPtr = nullptr;
 	}
 
 	SmartSimpleIndexPool& operator= (SmartSimpleIndexPool&& other) NOEXCEPT_IF(CONCEPT_NOEXCEPT_MOVE_CONSTRUCTIBLE_V(Base))	{
+		if (&other == this)
+			return *this;
+		if (Base::isMapped())
+			releasePreallocated();
 		delete[] preallocatedPool;
 		meanRequestSize = other.meanRequestSize;
 		//ERROR::SMART_SIMPLE_INDEX_POOL::MoveAssignment::Empty preallocatedPool of rvalue.
 		preallocatedPool = other.preallocatedPool;
 		//This is not safe:
 		topPtr = other.topPtr;
-		try { SimpleIndexPool::operator=(std::move(other)); }
+		try { Base::operator=(std::move(other)); }
 		catch (...) { 
 			delete[] preallocatedPool;
 			preallocatedPool = nullptr;
@@ -117,12 +186,13 @@ public:
 		}
 		other.preallocatedPool = nullptr;
 		other.topPtr = nullptr;
+		return *this;
 	}
 
 	/**
 	*	Computes memory used by this pool.
 	**/
-	size_t usedMemory() NOEXCEPT { return SimpleIndexPool::usedMemory() - sizeof(SimpleIndexPool) + sizeof(SmartSimpleIndexPool); }
+	size_t usedMemory() NOEXCEPT { return Base::usedMemory() - sizeof(Base) + sizeof(SmartSimpleIndexPool) + meanRequestSize * 2 * sizeof(TIndex); }
 
 	/**
 	*	\brief Performs an allocation of new index.
@@ -130,19 +200,14 @@ public:
 	*	\return Newly allocated index or 'notFoundIndex'.
 	**/
 	TIndex newIndex() NOEXCEPT {
-		if (topPtr < preallocatedPool + meanRequestSize) {
-			/*unsigned int _allocated = 2 * meanRequestSize - (topPtr - preallocatedPool + 1);
-			_allocated = SimpleIndexPool::newIndex(++topPtr, _allocated);
-			topPtr += _allocated;*/
-			//oneliner:
-			topPtr += SimpleIndexPool::newIndex(++topPtr, 2 * meanRequestSize - (topPtr - preallocatedPool)) - 1;
-		}
+		if (topPtr < preallocatedPool + meanRequestSize)
+			growStock(meanRequestSize * 2);
 		if (topPtr != preallocatedPool - 1) {
 			--topPtr;
 			return *(topPtr + 1);
 		}
 		//throw std::out_of_range("ERROR::SMART_SIMPLE_INDEX_POOL::newIndex::Can't allocate more indexes.");
-		return notFoundIndex;
+		return this->notFoundIndex;
 	}
 
 	/**
@@ -166,9 +231,13 @@ public:
 			topPtr = preallocatedPool + (_inStock - _count) - 1;
 			std::memcpy(_array, topPtr + 1, _count * sizeof(TIndex));
 			return _count;
+		} else if (_count > 2 * meanRequestSize) {
+			//Request is bigger than stock: give whole stock and allocate rest directly
+			std::memcpy(_array, preallocatedPool, _inStock * sizeof(TIndex));
+			topPtr = preallocatedPool - 1;
+			return _inStock + stockUp(_array + _inStock, _count - _inStock);
 		} else {
-			topPtr += SimpleIndexPool::newIndex(++topPtr, _count - _inStock) - 1;
-			_inStock = topPtr - preallocatedPool + 1;
+			_inStock = growStock(_count);
 			if (_count <= _inStock) {
 				topPtr = preallocatedPool + (_inStock - _count) - 1;
 				std::memcpy(_array, topPtr + 1, _count * sizeof(TIndex));
@@ -179,7 +248,7 @@ public:
 				#if defined(DEBUG_SMARTSIMPLEINDEXPOOL) && defined(WARNINGS_SMARTSIMPLEINDEXPOOL)
 					DEBUG_NEW_MESSAGE("WARNING::SMART_SIMPLE_INDEX_POOL::newIndex")
 						DEBUG_WRITE1("\tMessage: Can't allocate more indexes.");
-						DEBUG_WRITE2("\tFinal allocated count: ", _index);
+						DEBUG_WRITE2("\tFinal allocated count: ", _inStock);
 					DEBUG_END_MESSAGE
 				#endif
 				return _inStock;
@@ -201,10 +270,10 @@ public:
 	*	\return noreturn
 	**/
 	void deleteIndex(TIndex _index) NOEXCEPT {
-		for (int _index = 0; _index <= topPtr - preallocatedPool; _index++)
-			if (*(preallocatedPool + _index) == _index)
+		for (TIndex* _ptr = preallocatedPool; _ptr <= topPtr; _ptr++)
+			if (*_ptr == _index)
 				return;
-		SimpleIndexPool::deleteIndex(_index);
+		Base::deleteIndex(_index);
 	}
 
 	/**
@@ -215,8 +284,8 @@ public:
 	*	\return noreturn
 	**/
 	void deleteIndex(TIndex _begin, TIndex _end) NOEXCEPT {
-		SimpleIndexPool::deleteIndex(_begin, _end);
-		SimpleIndexPool::allocateSpecific(preallocatedPool, (unsigned int)(topPtr - preallocatedPool + 1));
+		Base::deleteIndex(_begin, _end);
+		Base::allocateSpecific(preallocatedPool, (unsigned int)(topPtr - preallocatedPool + 1));
 	}
 
 	/**
@@ -226,16 +295,60 @@ public:
 	*	\return Index allocation status.
 	**/
 	bool isUsed(TIndex _index) NOEXCEPT {
-		if (_index < minIndex || _index > maxIndex)
-			return false;
-		if (SimpleIndexPool::isUsed(_index)) {
-			for (int _index0 = 0; _index0 <= topPtr - preallocatedPool; _index0++)
-				if (*(preallocatedPool + _index0) == _index0)
+		if (Base::isUsed(_index)) {
+			for (TIndex* _ptr = preallocatedPool; _ptr <= topPtr; _ptr++)
+				if (*_ptr == _index)
 					return false;
 			return true;
 		} else {
 			return false;
 		}
 	}
+
+	/**
+	*	\brief Writes current pool state to raw image file '_path'.
+	*	Stocked preallocated indexes aren't stored as used, so restored pool has
+	*	exactly the same set of used indexes as this one. Order of new indexes may differ:
+	*	restored pool refills its stock from saved search position, not from this stock.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of writing.
+	**/
+	bool saveImage(const char* _path) NOEXCEPT {
+		unsigned int _inStock = (unsigned int)(topPtr - preallocatedPool + 1);
+		for (TIndex* _ptr = preallocatedPool; _ptr <= topPtr; _ptr++)
+			Base::deleteIndex(*_ptr);
+		bool _result = Base::saveImage(_path);
+		Base::allocateSpecific(preallocatedPool, _inStock);
+		return _result;
+	}
+
+	/**
+	*	\brief Reads pool state from raw image file '_path'.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of reading.
+	**/
+	bool loadImage(const char* _path) NOEXCEPT {
+		releasePreallocated();
+		bool _result = Base::loadImage(_path);
+		refillPreallocated();
+		return _result;
+	}
+
+	/**
+	*	\brief Moves pool state to memory mapped image file '_path'.
+	*	Stocked preallocated indexes are marked used in mapped image while pool is alive
+	*	and are returned on destruction. After crash they stay lost until image is rebuilt.
+	*	\param[in]	_path	Path to image file.
+	*	\throw nothrow
+	*	\return Success of mapping.
+	**/
+	bool mapImage(const char* _path) NOEXCEPT {
+		releasePreallocated();
+		bool _result = Base::mapImage(_path);
+		refillPreallocated();
+		return _result;
+	}
 };
 #endif
\ No newline at end of file
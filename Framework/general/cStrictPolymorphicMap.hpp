@@ -14,7 +14,7 @@
 #include "vPolymorphicContainerGeneral.hpp"
 //DEBUG
 #if defined(DEBUG_STRICTPOLYMORPHICMAP) && !defined(OTHER_DEBUG)
-	#include "general\mDebug.h"
+	#include "general/mDebug.h"
 #elif  defined(DEBUG_STRICTPOLYMORPHICMAP) && defined(OTHER_DEBUG)
 	#include OTHER_DEBUG
 #endif
@@ -76,7 +76,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newObject(	const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT,
+	inline auto newObject(	const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT,
 									T* const _defptr = nullptr) -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -128,7 +128,7 @@ public:
 	*	\throw Ignore : exception may occur if _Id or _result not long enougth.
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int newObject(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int newObject(	const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr) 
 	{
 		CONCEPT_NOT_CVRP(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
@@ -166,7 +166,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newObject(T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+	inline auto newObject(T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
 							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -213,7 +213,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
+	inline auto newObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		CONCEPT_CLEAR_TYPE(T,_ObjType)
 		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
@@ -256,12 +256,12 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int newObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int newObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
 	{
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		CONCEPT_COPY_CONSTRUCTIBLE(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be copy constructible.")
-		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
+		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::newObject::Provided type \"T\" must be derived from \"Base\".")
 		if (!_count)
 			return _count;
 		//Counter of allocated objects
@@ -298,7 +298,7 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int newObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int newObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr) 
 	{
 		return newObject(*_valueptr, _Id, _result, _count, _strategy, _success);
@@ -317,7 +317,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto newCopy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
+	inline auto newCopy(const Index _sourceId, const Index _Id, const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr)
 						-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -351,7 +351,7 @@ public:
 			{
 				_newptr.reset(new _ObjType(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			} else {
-				_newptr = std::move(std::make_shared(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
+				_newptr = std::move(std::make_shared<_ObjType>(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			}
 		}
 		//std::make_shared exception : not enougth memory
@@ -377,7 +377,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto copyObject(	const Index _sourceId, const Index _destId,
+	inline auto copyObject(	const Index _sourceId, const Index _destId,
 									const allocateStrategy _strategy = allocateStrategy::NON, T* const _defptr = nullptr) 
 							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
@@ -411,7 +411,7 @@ public:
 			{
 				_newptr.reset(new _ObjType(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			} else {
-				_newptr = std::move(std::make_shared(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
+				_newptr = std::move(std::make_shared<_ObjType>(*(std::dynamic_pointer_cast<_ObjType>(_sourceIterator->second))));
 			}
 		}
 		//std::make_shared exception : not enougth memory
@@ -435,7 +435,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer of type "T" to moved object on success and to nullptr on error.
 	**/
-	virtual inline std::shared_ptr<T> moveObject(const Index _sourceId, const Index _destId, T* const _defptr = nullptr) {
+	inline std::shared_ptr<T> moveObject(const Index _sourceId, const Index _destId, T* const _defptr = nullptr) {
 		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::moveObject::Provided type \"T\" must be derived from \"Base\".")
 		if (_sourceId == _destId)
 			return std::shared_ptr<T>(nullptr);
@@ -474,7 +474,7 @@ public:
 	*	\throw std::bad_alloc On not enougth memory in make_shared operation.
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto setObject(T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
+	inline auto setObject(T&& _value, const Index _Id, const allocateStrategy _strategy = allocateStrategy::DEFAULT)
 							-> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>())
 	{
 		CONCEPT_CLEAR_TYPE(T, _ObjType)
@@ -511,7 +511,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer of type "T" to new object on success and to nullptr on error.
 	**/
-	virtual inline auto setObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
+	inline auto setObject(T* const _valueptr, const Index _Id) NOEXCEPT -> decltype(std::shared_ptr<CONCEPT_CLEAR_TYPE_T(T)>()){
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::setObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
 		CONCEPT_CLEAR_TYPE(T,_ObjType)
 		CONCEPT_DERIVED(_ObjType, Base, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::setObject::Provided type \"T\" must be derived from \"Base\".")
@@ -543,7 +543,7 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int setObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int setObject(	const T& _value, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr)
 	{
 		CONCEPT_NOT_CVPR(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::setObject::Provided type \"T\" must not be constant/volatile pointer or reference.")
@@ -584,7 +584,7 @@ public:
 	*	\throw nothrow
 	*	\return Count of successfully allocated objects.
 	**/
-	virtual inline unsigned int setObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
+	inline unsigned int setObject(	T* const _valueptr, const Index _Id[], std::shared_ptr<T> _result[], const unsigned int _count,
 											const allocateStrategy _strategy = allocateStrategy::DEFAULT, bool _success[] = nullptr) 
 	{
 		return setObject(*_valueptr, _Id, _result, _count, _strategy, _success);
@@ -599,7 +599,7 @@ public:
 	*	\throw nothrow
 	*	\return Shared pointer to object with index '_Id' or to nullptr on error.
 	**/
-	virtual inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) NOEXCEPT{
+	inline std::shared_ptr<T> getObject(const Index _Id, T* const _defptr = nullptr) NOEXCEPT{
 		CONCEPT_NOT_PR(T, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::getObject::Provided type \"T\" must not be pointer or reference type.")
 		CONCEPT_DERIVED(T, Base, "ASSERTION_ERROR::STRICT_POLYMORPHIC_MAP::getObject::Provided type \"T\" must be derived from \"Base\".")
 		try { return std::move(std::dynamic_pointer_cast<T>(storage.at(_Id))); }
@@ -0,0 +1,112 @@
+#ifndef TEXTUREFILE_H
+#define TEXTUREFILE_H "[multi@cTextureFile.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains definition of baked texture file: pixels ready for glTexImage.
+*		Layout:
+*			Header (48 bytes) | level 0 | level 1 | ... | last level
+*		Levels are mipmaps from full size down to 1x1, rows are tightly packed,
+*		first row of image is first row in memory (as SOIL loads it).
+*		Numbers are stored in little-endian byte order.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+//OUR
+#include "general/vs2013tweaks.h"
+
+/**
+*	\brief Baked texture file format.
+*	Struct definition: TextureFile
+**/
+struct TextureFile {
+	//File header
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+		//Bytes per pixel: one byte per channel
+		uint32_t channels;
+		//Count of mipmap levels
+		uint32_t levels;
+		//glTexImage internalFormat, format and type
+		uint32_t glInternalFormat;
+		uint32_t glFormat;
+		uint32_t glType;
+		//Offset of level 0 from file start
+		uint32_t dataOffset;
+		//Size of all levels
+		uint64_t dataSize;
+	};
+
+	static_assert(sizeof(Header) == 48, "TextureFile: unexpected padding of header");
+
+	//Magic bytes of texture file
+	static const char* magic() NOEXCEPT { return "GTEX"; }
+
+	//Version of format
+	CONST_OR_CONSTEXPR static uint32_t VERSION = 1;
+
+	//Width of level '_level' of '_width' wide image
+	static inline uint32_t levelSize(uint32_t _size, uint32_t _level) NOEXCEPT { return (_size >> _level) ? (_size >> _level) : 1; }
+
+	//Count of levels of full mipmap chain
+	static uint32_t fullChain(uint32_t _width, uint32_t _height) NOEXCEPT {
+		uint32_t _levels = 1;
+		while ((_width >> _levels) || (_height >> _levels))
+			_levels++;
+		return _levels;
+	}
+
+	//Size of levels [0, _levels) of '_width' x '_height' image
+	static uint64_t dataSize(uint32_t _width, uint32_t _height, uint32_t _channels, uint32_t _levels) NOEXCEPT {
+		uint64_t _size = 0;
+		for (uint32_t _level = 0; _level < _levels; _level++)
+			_size += (uint64_t)levelSize(_width, _level) * levelSize(_height, _level) * _channels;
+		return _size;
+	}
+
+	/**
+	*	\brief Checks that '_size' bytes of '_data' are valid texture file.
+	*	\throw nothrow
+	*	\return Header of file or nullptr.
+	**/
+	static const Header* parse(const char* _data, size_t _size) NOEXCEPT {
+		if (!_data || _size < sizeof(Header))
+			return nullptr;
+		const Header* _header = (const Header*)_data;
+		if (std::memcmp(_header->magic, magic(), 4) || _header->version != VERSION)
+			return nullptr;
+		if (!_header->width || !_header->height || !_header->channels || _header->channels > 4 ||
+			!_header->levels || _header->levels > fullChain(_header->width, _header->height))
+			return nullptr;
+		if (_header->dataOffset < sizeof(Header) || _header->dataOffset > _size || _header->dataSize > _size - _header->dataOffset ||
+			_header->dataSize != dataSize(_header->width, _header->height, _header->channels, _header->levels))
+			return nullptr;
+		return _header;
+	}
+
+	/**
+	*	\brief Writes texture file with header '_header' and '_pixels' of all levels to '_out'.
+	*	Header fields dataOffset and dataSize are set by this function.
+	*	\throw std::bad_alloc
+	**/
+	static void write(Header _header, const std::vector<unsigned char>& _pixels, std::vector<char>& _out) {
+		std::memcpy(_header.magic, magic(), 4);
+		_header.version = VERSION;
+		_header.dataOffset = sizeof(Header);
+		_header.dataSize = _pixels.size();
+		_out.resize(sizeof(Header) + _pixels.size());
+		std::memcpy(_out.data(), &_header, sizeof(Header));
+		if (!_pixels.empty())
+			std::memcpy(_out.data() + sizeof(Header), _pixels.data(), _pixels.size());
+	}
+};
+#endif
\ No newline at end of file
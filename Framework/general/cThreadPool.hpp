@@ -0,0 +1,166 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H "[multi@cThreadPool.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of fixed size thread pool with
+*		parallel loop over index range.
+*		Pool is meant for blocking work (fallback file reads) that must not occupy
+*		job system workers. CPU parallel work of framework uses JobSystem::global().
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+//OUR
+#include "general/vs2013tweaks.h"
+
+/**
+*	\brief Pool of worker threads that run submitted tasks in FIFO order.
+*	Class definition: ThreadPool
+**/
+class ThreadPool {
+	/**
+	*	Shared state of one parallelFor call.
+	*	Helpers that start after all chunks are taken never touch loop body,
+	*	so state outlives caller stack safely.
+	**/
+	struct LoopState {
+		//Next chunk to be taken
+		std::atomic<size_t> next;
+		//Count of finished chunks
+		size_t done;
+		//Count of chunks
+		size_t chunks;
+		//First exception thrown by loop body
+		std::exception_ptr error;
+		std::mutex lock;
+		std::condition_variable finished;
+
+		LoopState(size_t _chunks) : next(0), done(0), chunks(_chunks) {}
+	};
+
+	std::vector<std::thread> workers;
+	std::deque< std::function<void()> > tasks;
+	std::mutex lock;
+	std::condition_variable wake;
+	bool stopping;
+
+	//Worker thread loop
+	void work() {
+		for (;;) {
+			std::function<void()> _task;
+			{
+				std::unique_lock<std::mutex> _lock(lock);
+				wake.wait(_lock, [this]() { return stopping || !tasks.empty(); });
+				if (tasks.empty())
+					return;
+				_task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			_task();
+		}
+	}
+
+	template < class TFunc >
+	/**
+	*	\brief Takes and processes chunks of loop until none left.
+	*	\throw nothrow
+	**/
+	static void runChunks(LoopState& _state, size_t _count, size_t _grain, TFunc& _func) NOEXCEPT {
+		for (;;) {
+			size_t _chunk = _state.next.fetch_add(1);
+			if (_chunk >= _state.chunks)
+				return;
+			size_t _begin = _chunk * _grain;
+			try { _func(_begin, std::min(_begin + _grain, _count)); }
+			catch (...) {
+				std::lock_guard<std::mutex> _lock(_state.lock);
+				if (!_state.error)
+					_state.error = std::current_exception();
+			}
+			std::lock_guard<std::mutex> _lock(_state.lock);
+			if (++_state.done == _state.chunks)
+				_state.finished.notify_all();
+		}
+	}
+public:
+	/**
+	*	\brief Starts '_workers' worker threads.
+	*	Pool without workers is valid: parallelFor runs on calling thread.
+	*	\throw std::system_error If thread can't be started.
+	**/
+	explicit ThreadPool(unsigned int _workers) : stopping(false) {
+		workers.reserve(_workers);
+		for (unsigned int _index = 0; _index < _workers; _index++)
+			workers.emplace_back([this]() { work(); });
+	}
+
+	//Finishes queued tasks and joins workers
+	~ThreadPool() NOEXCEPT {
+		{
+			std::lock_guard<std::mutex> _lock(lock);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& _worker : workers)
+			_worker.join();
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	//Count of worker threads
+	inline unsigned int size() const NOEXCEPT { return (unsigned int)workers.size(); }
+
+	/**
+	*	\brief Queues '_task' to be run by one of workers.
+	*	\throw std::bad_alloc
+	**/
+	void submit(std::function<void()> _task) {
+		{
+			std::lock_guard<std::mutex> _lock(lock);
+			tasks.push_back(std::move(_task));
+		}
+		wake.notify_one();
+	}
+
+	template < class TFunc >
+	/**
+	*	\brief Calls '_func(begin, end)' for chunks of range [0, _count) in parallel.
+	*	Chunks are '_grain' long (last may be shorter). Calling thread processes chunks too,
+	*	so nested calls from workers don't deadlock. Returns when all chunks are processed.
+	*	\param[in]	_count	Length of index range.
+	*	\param[in]	_grain	Count of indexes in one chunk, 0 is treated as 1.
+	*	\param[in]	_func	Functor with signature void(size_t begin, size_t end).
+	*	\throw First exception thrown by '_func', other chunks are still processed.
+	**/
+	void parallelFor(size_t _count, size_t _grain, TFunc _func) {
+		if (!_count)
+			return;
+		if (!_grain)
+			_grain = 1;
+		size_t _chunks = (_count + _grain - 1) / _grain;
+		auto _state = std::make_shared<LoopState>(_chunks);
+		size_t _helpers = std::min<size_t>(_chunks - 1, workers.size());
+		for (size_t _index = 0; _index < _helpers; _index++)
+			submit([_state, _count, _grain, &_func]() { runChunks(*_state, _count, _grain, _func); });
+		runChunks(*_state, _count, _grain, _func);
+		std::unique_lock<std::mutex> _lock(_state->lock);
+		_state->finished.wait(_lock, [&_state]() { return _state->done == _state->chunks; });
+		if (_state->error)
+			std::rethrow_exception(_state->error);
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,318 @@
+#ifndef VIRTUALFILESYSTEM_H
+#define VIRTUALFILESYSTEM_H "[multi@cVirtualFileSystem.hpp]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of virtual file system.
+*		Directories and pack archives are mounted to mount points,
+*		paths under mount point are looked up in its source.
+*		Mounted later sources override earlier ones.
+*		Path not found in any source is opened as is from disk:
+*		absolute paths of assets stay working without mounts.
+*		Lookups don't lock: list of mounts is replaced on mount/unmount.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <utility>
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/cPackArchive.hpp"
+
+/**
+*	\brief Source of files mounted to virtual file system.
+*	Paths given to source are normalized and relative to its mount point.
+*	Methods may be called from many threads simultaneously.
+*	Class definition: FileSource
+**/
+class FileSource {
+public:
+	virtual ~FileSource() {}
+
+	//Checks that source contains file '_path'
+	virtual bool exists(const std::string& _path) const = 0;
+
+	/**
+	*	\brief Reads whole file '_path' to '_out'.
+	*	\return False if file isn't found or can't be read.
+	**/
+	virtual bool read(const std::string& _path, std::vector<char>& _out) const = 0;
+
+	/**
+	*	\brief Returns content of file '_path' without copying if source can do it.
+	*	Content stays valid while source is mounted.
+	*	\return Pointer to content or nullptr.
+	**/
+	virtual const char* view(const std::string&, size_t&) const { return nullptr; }
+
+	/**
+	*	\brief Gives path on disk of file '_path' if source keeps it as plain file.
+	*	Such file may be mapped or read by system calls directly.
+	*	\return False if file isn't found or isn't plain file on disk.
+	**/
+	virtual bool resolve(const std::string&, std::string&) const { return false; }
+};
+
+/**
+*	\brief Directory on disk as file source.
+*	Class definition: DirectorySource
+**/
+class DirectorySource : public FileSource {
+	std::string root;
+public:
+	//Directory '_root' is used as prefix of all paths
+	explicit DirectorySource(const std::string& _root) : root(_root) {
+		if (!root.empty() && root.back() != '/' && root.back() != '\\')
+			root += '/';
+	}
+
+	bool exists(const std::string& _path) const override {
+		return std::ifstream(root + _path, std::ios::binary).is_open();
+	}
+
+	bool read(const std::string& _path, std::vector<char>& _out) const override {
+		std::ifstream _stream(root + _path, std::ios::binary | std::ios::ate);
+		if (!_stream)
+			return false;
+		std::streamoff _size = _stream.tellg();
+		if (_size < 0)
+			return false;
+		_out.resize((size_t)_size);
+		_stream.seekg(0);
+		return _size == 0 || (bool)_stream.read(_out.data(), _size);
+	}
+
+	bool resolve(const std::string& _path, std::string& _diskPath) const override {
+		if (!exists(_path))
+			return false;
+		_diskPath = root + _path;
+		return true;
+	}
+};
+
+/**
+*	\brief Pack archive as file source.
+*	Stored entries are viewed in mapped archive, compressed ones are decompressed on read.
+*	Class definition: PackSource
+**/
+class PackSource : public FileSource {
+	PackArchive archive;
+public:
+	/**
+	*	\brief Opens archive '_path'.
+	*	\throw std::runtime_error If archive can't be opened.
+	**/
+	explicit PackSource(const std::string& _path) {
+		if (!archive.open(_path))
+			throw std::runtime_error("ERROR::PACK_SOURCE::PackSource::Can't open pack archive: " + _path);
+	}
+
+	bool exists(const std::string& _path) const override { return archive.find(_path) != nullptr; }
+
+	bool read(const std::string& _path, std::vector<char>& _out) const override {
+		const PackArchive::Entry* _entry = archive.find(_path);
+		return _entry && archive.read(*_entry, _out);
+	}
+
+	const char* view(const std::string& _path, size_t& _size) const override {
+		const PackArchive::Entry* _entry = archive.find(_path);
+		if (!_entry)
+			return nullptr;
+		_size = (size_t)_entry->size;
+		return archive.view(*_entry);
+	}
+
+	//Archive of this source
+	inline const PackArchive& pack() const NOEXCEPT { return archive; }
+};
+
+/**
+*	\brief Virtual file system: set of file sources under mount points.
+*	Class definition: VirtualFileSystem
+**/
+class VirtualFileSystem {
+	struct Mount {
+		//Normalized mount point ending with '/', empty for root
+		std::string point;
+		std::shared_ptr<FileSource> source;
+	};
+
+	typedef std::vector<Mount> MountList;
+
+	//Current list of mounts, it is never changed after publication
+	std::shared_ptr<const MountList> mounts;
+	//Serializes mount and unmount
+	std::mutex lock;
+
+	//Current list of mounts
+	std::shared_ptr<const MountList> current() const { return std::atomic_load(&mounts); }
+
+	//Normalizes '_point' and ensures it ends with '/'
+	static std::string mountPoint(const std::string& _point) {
+		std::string _result = normalize(_point);
+		if (!_result.empty() && _result.back() != '/')
+			_result += '/';
+		return _result;
+	}
+
+	template < class F >
+	/**
+	*	\brief Calls '_func(source, relativePath)' for sources of '_path' from the last mounted one
+	*	until it returns true.
+	*	\return True if any call returned true.
+	**/
+	bool lookup(const std::string& _path, F _func) const {
+		std::shared_ptr<const MountList> _mounts = current();
+		std::string _normalized = normalize(_path);
+		for (auto _mount = _mounts->rbegin(); _mount != _mounts->rend(); ++_mount)
+			if (!_normalized.compare(0, _mount->point.size(), _mount->point) &&
+				_func(*_mount->source, _normalized.substr(_mount->point.size())))
+				return true;
+		return false;
+	}
+public:
+	VirtualFileSystem() : mounts(std::make_shared<MountList>()) {}
+
+	VirtualFileSystem(const VirtualFileSystem&) = delete;
+
+	VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+	/**
+	*	\brief Normalizes path: '\' to '/', removes "./" parts and repeated '/'.
+	*	\throw std::bad_alloc
+	**/
+	static std::string normalize(const std::string& _path) {
+		std::string _result;
+		_result.reserve(_path.size());
+		for (size_t _index = 0; _index < _path.size(); _index++) {
+			char _char = _path[_index] == '\\' ? '/' : _path[_index];
+			bool _start = _result.empty() || _result.back() == '/';
+			if (_char == '/' && !_result.empty() && _result.back() == '/')
+				continue;
+			if (_char == '.' && _start && (_index + 1 == _path.size() || _path[_index + 1] == '/' || _path[_index + 1] == '\\')) {
+				_index++;
+				continue;
+			}
+			_result += _char;
+		}
+		return _result;
+	}
+
+	/**
+	*	\brief Mounts '_source' to '_point'. Empty point is root: source gets all paths.
+	*	\throw std::bad_alloc
+	**/
+	void mount(const std::string& _point, std::shared_ptr<FileSource> _source) {
+		std::lock_guard<std::mutex> _guard(lock);
+		auto _mounts = std::make_shared<MountList>(*current());
+		_mounts->push_back(Mount{ mountPoint(_point), std::move(_source) });
+		std::atomic_store(&mounts, std::shared_ptr<const MountList>(std::move(_mounts)));
+	}
+
+	//Mounts directory '_directory' to '_point'
+	void mountDirectory(const std::string& _point, const std::string& _directory) {
+		mount(_point, std::make_shared<DirectorySource>(_directory));
+	}
+
+	/**
+	*	\brief Mounts pack archive '_path' to '_point'.
+	*	\throw std::runtime_error If archive can't be opened.
+	**/
+	void mountPack(const std::string& _point, const std::string& _path) {
+		mount(_point, std::make_shared<PackSource>(_path));
+	}
+
+	/**
+	*	\brief Unmounts all sources of '_point'.
+	*	Source is destroyed when the last read from it is finished.
+	*	\return Count of unmounted sources.
+	**/
+	size_t unmount(const std::string& _point) {
+		std::lock_guard<std::mutex> _guard(lock);
+		std::string _normalized = mountPoint(_point);
+		auto _mounts = std::make_shared<MountList>(*current());
+		size_t _count = _mounts->size();
+		_mounts->erase(std::remove_if(_mounts->begin(), _mounts->end(), [&_normalized](const Mount& _mount) { return _mount.point == _normalized; }), _mounts->end());
+		_count -= _mounts->size();
+		std::atomic_store(&mounts, std::shared_ptr<const MountList>(std::move(_mounts)));
+		return _count;
+	}
+
+	//Checks that file '_path' exists in mounted sources or on disk
+	bool exists(const std::string& _path) const {
+		if (lookup(_path, [](const FileSource& _source, const std::string& _relative) { return _source.exists(_relative); }))
+			return true;
+		return std::ifstream(_path, std::ios::binary).is_open();
+	}
+
+	/**
+	*	\brief Reads whole file '_path' to '_out'.
+	*	\throw std::bad_alloc
+	*	\return False if file isn't found or can't be read.
+	**/
+	bool read(const std::string& _path, std::vector<char>& _out) const {
+		if (lookup(_path, [&_out](const FileSource& _source, const std::string& _relative) { return _source.read(_relative, _out); }))
+			return true;
+		return DirectorySource("").read(_path, _out);
+	}
+
+	/**
+	*	\brief Reads whole file '_path' to '_out' as text.
+	*	\throw std::bad_alloc
+	*	\return False if file isn't found or can't be read.
+	**/
+	bool readText(const std::string& _path, std::string& _out) const {
+		std::vector<char> _content;
+		if (!read(_path, _content))
+			return false;
+		_out.assign(_content.begin(), _content.end());
+		return true;
+	}
+
+	/**
+	*	\brief Returns content of file '_path' without copying: only stored entries of mounted packs are viewable.
+	*	Content stays valid while pack is mounted.
+	*	\return Pointer to content or nullptr, use read() in that case.
+	**/
+	const char* view(const std::string& _path, size_t& _size) const {
+		const char* _result = nullptr;
+		lookup(_path, [&_result, &_size](const FileSource& _source, const std::string& _relative) {
+			_result = _source.view(_relative, _size);
+			return _result != nullptr || _source.exists(_relative);
+		});
+		return _result;
+	}
+
+	/**
+	*	\brief Gives path on disk of file '_path' if source that provides it keeps it as plain file.
+	*	Source is chosen as in read: file of pack mounted later hides same file in directory and on disk.
+	*	\throw std::bad_alloc
+	*	\return False if file isn't found or is provided by source that isn't plain file, use read() in that case.
+	**/
+	bool resolve(const std::string& _path, std::string& _diskPath) const {
+		bool _resolved = false;
+		if (lookup(_path, [&_resolved, &_diskPath](const FileSource& _source, const std::string& _relative) {
+				_resolved = _source.resolve(_relative, _diskPath);
+				return _resolved || _source.exists(_relative);
+			}))
+			return _resolved;
+		if (!std::ifstream(_path, std::ios::binary).is_open())
+			return false;
+		_diskPath = _path;
+		return true;
+	}
+
+	//File system used by asset loaders
+	static VirtualFileSystem& global() {
+		static VirtualFileSystem _instance;
+		return _instance;
+	}
+};
+#endif
\ No newline at end of file
@@ -10,6 +10,8 @@
 */
 //GLEW
 #include <GL/glew.h>
+//OUR
+#include "CGLStateCache.h"
 
 /* The manual allocator of OpenGL buffers.
 *  Class definition: GLBufferHandler
@@ -106,9 +108,9 @@ protected:
 	void bindBuffer(BufferType type, GLuint target = GL_ARRAY_BUFFER) {
 		if (allocator & type) {
 			if (type == VERTEXARRAY) {
-				glBindVertexArray(GLbuffers[VERTEXARRAY]);
+				GLStateCache::global().bindVertexArray(GLbuffers[VERTEXARRAY]);
 			} else {
-				glBindBuffer(target, GLbuffers[type]);
+				GLStateCache::global().bindBuffer(target, GLbuffers[type]);
 			}
 		}
 	}
@@ -118,15 +120,16 @@ public:
 	GLBufferHandler(int alloc) : allocator(alloc) {	allocate(alloc); }
 
 	~GLBufferHandler() {
-		glDeleteBuffers(1, &GLbuffers.vertex);
-		glDeleteBuffers(1, &GLbuffers.color);
-		glDeleteBuffers(1, &GLbuffers.textureCoord);
-		glDeleteBuffers(1, &GLbuffers.normal);
-		glDeleteBuffers(1, &GLbuffers.tangent);
-		glDeleteBuffers(1, &GLbuffers.bitangent);
-		glDeleteBuffers(1, &GLbuffers.element);
-		glDeleteBuffers(1, &GLbuffers.combined);
-		glDeleteVertexArrays(1, &GLbuffers.vertexArray);
+		GLStateCache& _state = GLStateCache::global();
+		_state.deleteBuffer(GLbuffers.vertex);
+		_state.deleteBuffer(GLbuffers.color);
+		_state.deleteBuffer(GLbuffers.textureCoord);
+		_state.deleteBuffer(GLbuffers.normal);
+		_state.deleteBuffer(GLbuffers.tangent);
+		_state.deleteBuffer(GLbuffers.bitangent);
+		_state.deleteBuffer(GLbuffers.element);
+		_state.deleteBuffer(GLbuffers.combined);
+		_state.deleteVertexArray(GLbuffers.vertexArray);
 	}
 };
 #endif
\ No newline at end of file
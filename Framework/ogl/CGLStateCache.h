@@ -0,0 +1,274 @@
+#ifndef GLSTATECACHE_H
+#define GLSTATECACHE_H "[0.0.5@CGLStateCache.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of shadow copy of OpenGL binding state:
+*		program, vertex array, buffers, active texture unit, textures of units
+*		and capability bits. Call that sets state which is already current is skipped.
+*		All framework state changes go through GLStateCache::global(): code that
+*		changes same state directly must call invalidate() after it.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//GLEW
+#include <GL/glew.h>
+
+#ifndef GLSTATECACHE_MAX_TEXTURE_UNITS
+	//Count of texture units tracked: units above it are always bound
+	#define GLSTATECACHE_MAX_TEXTURE_UNITS 32
+#endif
+
+#ifndef GLSTATECACHE_MAX_UNIFORM_BUFFER_BINDINGS
+	//Count of indexed uniform buffer binding points tracked
+	#define GLSTATECACHE_MAX_UNIFORM_BUFFER_BINDINGS 16
+#endif
+
+/* Counters of state changes made and skipped by GLStateCache.
+*  Struct definition: GLStateStatistics
+*/
+struct GLStateStatistics {
+	unsigned int issued = 0;
+	unsigned int skipped = 0;
+};
+
+/* Shadow copy of OpenGL binding state of one context.
+*  Class definition: GLStateCache
+*/
+class GLStateCache {
+	//NO COPYCONSTRUCT
+	GLStateCache(const GLStateCache&) = delete;
+	GLStateCache& operator=(const GLStateCache&) = delete;
+
+	//Value that never equals real state: next call is always issued
+	static const GLuint UNKNOWN = ~GLuint(0);
+
+	enum BufferTarget : int {
+		ARRAY_BUFFER = 0,
+		ELEMENT_ARRAY_BUFFER,
+		UNIFORM_BUFFER,
+		COPY_READ_BUFFER,
+		COPY_WRITE_BUFFER,
+		PIXEL_UNPACK_BUFFER,
+		BUFFER_TARGET_COUNT
+	};
+
+	enum TextureTarget : int {
+		TEXTURE_1D = 0,
+		TEXTURE_2D,
+		TEXTURE_3D,
+		TEXTURE_CUBE_MAP,
+		TEXTURE_TARGET_COUNT
+	};
+
+	enum Capability : int {
+		DEPTH_TEST = 0,
+		BLEND,
+		CULL_FACE,
+		STENCIL_TEST,
+		SCISSOR_TEST,
+		CAPABILITY_COUNT
+	};
+
+	GLuint program;
+	GLuint vertexArray;
+	GLuint buffers[BUFFER_TARGET_COUNT];
+	GLuint uniformBuffers[GLSTATECACHE_MAX_UNIFORM_BUFFER_BINDINGS];
+	//Index of active unit: GL_TEXTURE0 + activeUnit
+	GLuint activeUnit;
+	GLuint textures[GLSTATECACHE_MAX_TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+	//0 - disabled, 1 - enabled, UNKNOWN
+	GLuint capabilities[CAPABILITY_COUNT];
+	GLStateStatistics statistics;
+
+	static int bufferTarget(GLenum _target) {
+		switch (_target) {
+			case GL_ARRAY_BUFFER:			return ARRAY_BUFFER;
+			case GL_ELEMENT_ARRAY_BUFFER:	return ELEMENT_ARRAY_BUFFER;
+			case GL_UNIFORM_BUFFER:			return UNIFORM_BUFFER;
+			case GL_COPY_READ_BUFFER:		return COPY_READ_BUFFER;
+			case GL_COPY_WRITE_BUFFER:		return COPY_WRITE_BUFFER;
+			case GL_PIXEL_UNPACK_BUFFER:	return PIXEL_UNPACK_BUFFER;
+			default:						return -1;
+		}
+	}
+
+	static int textureTarget(GLenum _target) {
+		switch (_target) {
+			case GL_TEXTURE_1D:			return TEXTURE_1D;
+			case GL_TEXTURE_2D:			return TEXTURE_2D;
+			case GL_TEXTURE_3D:			return TEXTURE_3D;
+			case GL_TEXTURE_CUBE_MAP:	return TEXTURE_CUBE_MAP;
+			default:					return -1;
+		}
+	}
+
+	static int capability(GLenum _capability) {
+		switch (_capability) {
+			case GL_DEPTH_TEST:		return DEPTH_TEST;
+			case GL_BLEND:			return BLEND;
+			case GL_CULL_FACE:		return CULL_FACE;
+			case GL_STENCIL_TEST:	return STENCIL_TEST;
+			case GL_SCISSOR_TEST:	return SCISSOR_TEST;
+			default:				return -1;
+		}
+	}
+
+	//Updates '_current' to '_value': returns false if state is already set
+	bool change(GLuint& _current, GLuint _value) {
+		if (_current == _value) {
+			statistics.skipped++;
+			return false;
+		}
+		_current = _value;
+		statistics.issued++;
+		return true;
+	}
+
+	void setCapability(GLenum _capability, GLuint _enabled) {
+		int _index = capability(_capability);
+		if (_index < 0) { //Untracked capability is always set
+			statistics.issued++;
+		} else if (!change(capabilities[_index], _enabled)) {
+			return;
+		}
+		if (_enabled)
+			glEnable(_capability);
+		else
+			glDisable(_capability);
+	}
+public:
+	GLStateCache() { invalidate(); }
+
+	//Cache of context used by framework
+	static GLStateCache& global() {
+		static GLStateCache _cache;
+		return _cache;
+	}
+
+	//Forgets all state: next call of every kind is issued. Call after state is changed bypassing cache
+	void invalidate() {
+		program = UNKNOWN;
+		vertexArray = UNKNOWN;
+		for (auto &_buffer : buffers)
+			_buffer = UNKNOWN;
+		for (auto &_buffer : uniformBuffers)
+			_buffer = UNKNOWN;
+		activeUnit = UNKNOWN;
+		for (auto &_unit : textures)
+			for (auto &_texture : _unit)
+				_texture = UNKNOWN;
+		for (auto &_capability : capabilities)
+			_capability = UNKNOWN;
+	}
+
+	void useProgram(GLuint _program) {
+		if (change(program, _program))
+			glUseProgram(_program);
+	}
+
+	/* Element array buffer binding is part of vertex array state:
+	*  it is unknown after other vertex array is bound.
+	*/
+	void bindVertexArray(GLuint _vertexArray) {
+		if (change(vertexArray, _vertexArray)) {
+			glBindVertexArray(_vertexArray);
+			buffers[ELEMENT_ARRAY_BUFFER] = UNKNOWN;
+		}
+	}
+
+	void bindBuffer(GLenum _target, GLuint _buffer) {
+		int _index = bufferTarget(_target);
+		if (_index < 0) {
+			statistics.issued++;
+		} else if (!change(buffers[_index], _buffer)) {
+			return;
+		}
+		glBindBuffer(_target, _buffer);
+	}
+
+	//Binds '_buffer' to indexed binding point '_binding' and to generic binding of '_target'
+	void bindBufferBase(GLenum _target, GLuint _binding, GLuint _buffer) {
+		if (_target == GL_UNIFORM_BUFFER && _binding < GLSTATECACHE_MAX_UNIFORM_BUFFER_BINDINGS) {
+			if (uniformBuffers[_binding] == _buffer && buffers[UNIFORM_BUFFER] == _buffer) {
+				statistics.skipped++;
+				return;
+			}
+			uniformBuffers[_binding] = _buffer;
+			buffers[UNIFORM_BUFFER] = _buffer;
+		} else {
+			int _index = bufferTarget(_target);
+			if (_index >= 0)
+				buffers[_index] = _buffer;
+		}
+		statistics.issued++;
+		glBindBufferBase(_target, _binding, _buffer);
+	}
+
+	//Selects texture unit: '_unit' is GL_TEXTURE0 + i
+	void activeTexture(GLenum _unit) {
+		if (change(activeUnit, _unit - GL_TEXTURE0))
+			glActiveTexture(_unit);
+	}
+
+	//Binds '_texture' to '_target' of active texture unit
+	void bindTexture(GLenum _target, GLuint _texture) {
+		int _index = textureTarget(_target);
+		if (_index < 0 || activeUnit >= GLSTATECACHE_MAX_TEXTURE_UNITS) {
+			statistics.issued++;
+		} else if (!change(textures[activeUnit][_index], _texture)) {
+			return;
+		}
+		glBindTexture(_target, _texture);
+	}
+
+	void enable(GLenum _capability) { setCapability(_capability, 1); }
+
+	void disable(GLenum _capability) { setCapability(_capability, 0); }
+
+	/* Deleted object is unbound by OpenGL: cache follows it.
+	*  Deleted current program stays in use: it is forgotten so same name is bound again.
+	*/
+	void deleteProgram(GLuint _program) {
+		if (_program && program == _program)
+			program = UNKNOWN;
+		glDeleteProgram(_program);
+	}
+
+	void deleteVertexArray(GLuint _vertexArray) {
+		if (_vertexArray && vertexArray == _vertexArray) {
+			vertexArray = 0;
+			buffers[ELEMENT_ARRAY_BUFFER] = UNKNOWN;
+		}
+		glDeleteVertexArrays(1, &_vertexArray);
+	}
+
+	void deleteBuffer(GLuint _buffer) {
+		if (_buffer) {
+			for (auto &_current : buffers)
+				if (_current == _buffer)
+					_current = 0;
+			for (auto &_current : uniformBuffers)
+				if (_current == _buffer)
+					_current = 0;
+		}
+		glDeleteBuffers(1, &_buffer);
+	}
+
+	void deleteTexture(GLuint _texture) {
+		if (_texture)
+			for (auto &_unit : textures)
+				for (auto &_current : _unit)
+					if (_current == _texture)
+						_current = 0;
+		glDeleteTextures(1, &_texture);
+	}
+
+	//Returns counters of state changes issued to OpenGL and skipped
+	const GLStateStatistics& getStatistics() const { return statistics; }
+
+	//Resets counters: call once per frame to get per-frame numbers
+	void resetStatistics() { statistics = GLStateStatistics(); }
+};
+#endif
\ No newline at end of file
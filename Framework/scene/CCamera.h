@@ -117,7 +117,7 @@ protected:
 public:
 	
 	ProjectionHandler() : state(State::UNINITIALISED), MatrixAutomaticStorage<>() {
-		setName(PROJECTION_HANDLER_STD_PROJECTION_SHADER_VARIABLE_NAME);
+		setName(UNIFORM_NAME_ID(PROJECTION_HANDLER_STD_PROJECTION_SHADER_VARIABLE_NAME));
 	}
 
 	ProjectionHandler(	float _fov,			float _aspect, 
@@ -267,6 +267,16 @@ class SimpleCamera : public ProjectionHandler {
 	glm::vec3 up;
 	glm::vec3 right;
 	MatrixAutomaticStorage<> view;
+	//Vectors the view matrix was computed from: unchanged camera keeps uniform version
+	glm::vec3 viewPosition, viewFront, viewUp;
+
+	//Compute view matrix
+	void updateView() {
+		viewPosition = position;
+		viewFront = front;
+		viewUp = up;
+		view.setValue(our::lookAt(position, position + front, up));
+	}
 public:
 	glm::vec3 position;
 	GLfloat speed;
@@ -280,9 +290,10 @@ public:
 
 	SimpleCamera() :	ProjectionHandler(), position(glm::vec3(0.0f, 0.0f, 0.0f)), 
 						front(glm::vec3(0.0f, 0.0f, -1.0f)), up(glm::vec3(0.0f, 1.0f, 0.0f)),
-						right(glm::vec3(-1.0f, 0.0f, 0.0f)), view(), mode(CameraMode::FPS), lockUp(false)
+						right(glm::vec3(-1.0f, 0.0f, 0.0f)), view(), mode(CameraMode::FPS), lockUp(false),
+						viewPosition(0.0f), viewFront(0.0f), viewUp(0.0f)
 	{
-		view.setName(SIMPLE_CAMERA_STD_VIEW_SHADER_VARIABLE_NAME);
+		view.setName(UNIFORM_NAME_ID(SIMPLE_CAMERA_STD_VIEW_SHADER_VARIABLE_NAME));
 	}
 
 	//Setup new main shader
@@ -296,7 +307,7 @@ public:
 	*/
 	void Setup() {
 		updateProjection();
-		view.setValue(our::lookAt(position, position + front, up));
+		updateView();
 	}
 
 	/*Setup all parameters for OpenGL draw calls including shader
@@ -304,7 +315,7 @@ public:
 	*/
 	void Setup(Shader *_shader) {
 		updateProjection();
-		view.setValue(our::lookAt(position, position + front, up));
+		updateView();
 		ProjectionHandler::setShader(_shader);
 		view.setShader(_shader);
 	}
@@ -317,7 +328,20 @@ public:
 
 	//Periodic update function
 	void Update() {
-		view.setValue(our::lookAt(position, position + front, up));
+		if (position != viewPosition || front != viewFront || up != viewUp)
+			updateView();
+	}
+
+	/* Write camera uniform block (std140): mat4 projection, mat4 view, vec4 viewPos.
+	*  Update need to be called first
+	*/
+	template < class TWriter >
+	void writeStd140(TWriter& _writer) {
+		our::mat4 _projection = ProjectionHandler::getValue();
+		our::mat4 _view = view.getValue();
+		_writer.mat4(_projection.getValuePtr());
+		_writer.mat4(_view.getValuePtr());
+		_writer.vec4(glm::vec4(position, 1.0f));
 	}
 
 	/* Control camera view by deltaX and deltaY parameters.
@@ -0,0 +1,13 @@
+// Camera of goOGL12 scene: one uniform buffer shared by all programs.
+// Bound to UNIFORM_BLOCK_CAMERA_BINDING, written by SimpleCamera::writeStd140.
+
+#ifndef CAMERA_GLSL
+#define CAMERA_GLSL
+
+layout(std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
+
+#endif
@@ -1,87 +1,25 @@
 #version 330 core
 
-struct Material {
-    sampler2D diffuse;
-    sampler2D specular;
-    float shininess;
-}; 
-
-uniform Material material;
-
-struct DirectionLight {
-    vec4 direction;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
-uniform DirectionLight directionLight; 
-
-struct PointLight {    
-    vec3 position; 
-
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    
-    float constant;
-    float linear;
-    float quadratic; 
-};  
-
-#define NR_POINT_LIGHTS 4  
-uniform PointLight pointLights[NR_POINT_LIGHTS];
-
 out vec4 color;
 
-uniform vec3 viewPos;
+#include "camera.glsl"
 
 in vec3 Normal;
 in vec3 FragPos; 
 in vec2 TexCoords;
 
-vec3 calculateDirectionLight(DirectionLight light, vec3 normal, vec3 viewDir) {
-    vec3 lightDir = normalize(-(light.direction.xyz));
-    // Diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // Specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // Combine results
-    vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-    return (ambient + diffuse + specular); 
-}
-
-vec3 calculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position.xyz - fragPos);
-    // Diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // Specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // Attenuation
-    float distance    = length(light.position.xyz - fragPos);
-    float attenuation = 1.0f / (light.constant + light.linear * distance + 
-  			     light.quadratic * (distance * distance));    
-    // Combine results
-    vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-    return attenuation * (ambient + diffuse + specular);
-}
+#include "lighting.glsl"
 
 void main()
 {
     // Properties
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     // Phase 1: Directional lighting
     vec3 result = calculateDirectionLight(directionLight, norm, viewDir);
     // Phase 2: Point lights
-    for(int i = 0; i < NR_POINT_LIGHTS; i++)
-        result += calculatePointLight(pointLights[i], norm, FragPos, viewDir);        
+    for(int i = 0; i < POINT_LIGHT_COUNT; i++)
+        result += calculatePointLight(getPointLight(i), norm, FragPos, viewDir);        
     
     color = vec4(result, 1.0);
 }
@@ -5,8 +5,8 @@ layout(location = 2) in vec2 texCoords;
 layout(location = 3) in vec3 normal;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+#include "camera.glsl"
 
 out vec3 Normal;
 out vec3 FragPos;
@@ -8,8 +8,8 @@ out vec3 ourColor;
 out vec2 TexCoord;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+#include "camera.glsl"
 
 void main()
 {
@@ -3,8 +3,8 @@
 layout(location = 0) in vec3 position;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+#include "camera.glsl"
 
 void main()
 {
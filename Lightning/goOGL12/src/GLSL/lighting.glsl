@@ -0,0 +1,114 @@
+// Lighting of goOGL12 scene: material, direction light and NR_POINT_LIGHTS point lights.
+// Variant defines:
+//     NR_POINT_LIGHTS - count of point lights (at least 1), 4 if not defined
+//     NO_SPECULAR     - specular term is not computed
+//     POINT_LIGHT_ARRAYS - point lights are arrays of members (PointLightArray):
+//                       every member is uploaded by one call, pointLightCount lights are used
+// Uses TexCoords input of including shader.
+
+#ifndef LIGHTING_GLSL
+#define LIGHTING_GLSL
+
+struct Material {
+    sampler2D diffuse;
+    sampler2D specular;
+    float shininess;
+}; 
+
+uniform Material material;
+
+struct DirectionLight {
+    vec4 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+uniform DirectionLight directionLight; 
+
+struct PointLight {    
+    vec3 position; 
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    
+    float constant;
+    float linear;
+    float quadratic; 
+};  
+
+#ifndef NR_POINT_LIGHTS
+    #define NR_POINT_LIGHTS 4
+#endif
+#ifdef POINT_LIGHT_ARRAYS
+uniform vec4  pointLightPosition[NR_POINT_LIGHTS];
+uniform vec3  pointLightAmbient[NR_POINT_LIGHTS];
+uniform vec3  pointLightDiffuse[NR_POINT_LIGHTS];
+uniform vec3  pointLightSpecular[NR_POINT_LIGHTS];
+uniform float pointLightConstant[NR_POINT_LIGHTS];
+uniform float pointLightLinear[NR_POINT_LIGHTS];
+uniform float pointLightQuadratic[NR_POINT_LIGHTS];
+uniform int   pointLightCount;
+
+#define POINT_LIGHT_COUNT min(pointLightCount, NR_POINT_LIGHTS)
+
+PointLight getPointLight(int i) {
+    return PointLight(pointLightPosition[i].xyz, pointLightAmbient[i], pointLightDiffuse[i], pointLightSpecular[i],
+                      pointLightConstant[i], pointLightLinear[i], pointLightQuadratic[i]);
+}
+#else
+uniform PointLight pointLights[NR_POINT_LIGHTS];
+
+#define POINT_LIGHT_COUNT NR_POINT_LIGHTS
+
+PointLight getPointLight(int i) {
+    return pointLights[i];
+}
+#endif
+
+vec3 calculateDirectionLight(DirectionLight light, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-(light.direction.xyz));
+    // Diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+#ifndef NO_SPECULAR
+    // Specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+#endif
+    // Combine results
+    vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, TexCoords));
+    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.diffuse, TexCoords));
+#ifdef NO_SPECULAR
+    vec3 specular = vec3(0.0);
+#else
+    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+#endif
+    return (ambient + diffuse + specular); 
+}
+
+vec3 calculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.position.xyz - fragPos);
+    // Diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+#ifndef NO_SPECULAR
+    // Specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+#endif
+    // Attenuation
+    float distance    = length(light.position.xyz - fragPos);
+    float attenuation = 1.0f / (light.constant + light.linear * distance + 
+  			     light.quadratic * (distance * distance));    
+    // Combine results
+    vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, TexCoords));
+    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.diffuse, TexCoords));
+#ifdef NO_SPECULAR
+    vec3 specular = vec3(0.0);
+#else
+    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+#endif
+    return attenuation * (ambient + diffuse + specular);
+}
+
+#endif
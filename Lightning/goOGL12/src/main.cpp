@@ -19,6 +19,7 @@ static const std::string lightCubeVSP(R"(C:\Users\123\Desktop\OpenGL\PROJECTS\GO
 static const std::string lightCubeFSP(R"(C:\Users\123\Desktop\OpenGL\PROJECTS\GOOPENGL\Lightning\goOGL12\src\GLSL\lightCube.fs)");
 
 static SimpleCamera *camera;
+static UniformBlock *cameraBlock;
 
 //Key handler array
 bool keys[1024];
@@ -56,7 +57,7 @@ int main()
 	glfwGetFramebufferSize(window, &width, &height);
 	glViewport(0, 0, width, height);
 	//Enable z-buffer test
-	glEnable(GL_DEPTH_TEST);
+	GLStateCache::global().enable(GL_DEPTH_TEST);
 	//Disable mouse movement
 	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
@@ -66,7 +67,7 @@ int main()
 	lightCube = new SeparateModel<>(8, 36, cubeV, nullptr, nullptr, nullptr, cubeI);
 	// 
 	WorldOriginShader = new Shader(WorldOriginVSP.c_str(), WorldOriginFSP.c_str());
-	cubeShader = new Shader(cubeVSP.c_str(), cubeFSP.c_str());
+	cubeShader = new Shader(cubeVSP.c_str(), cubeFSP.c_str(), ShaderDefines{ { "POINT_LIGHT_ARRAYS", "" } });
 	lightCubeShader = new Shader(lightCubeVSP.c_str(), lightCubeFSP.c_str());
 
 	WorldOrigin->setShader(WorldOriginShader);
@@ -94,19 +95,16 @@ int main()
 								glm::vec3(1.0f, 1.0f, 1.0f));
 	DirectionalLightsourceAutomaticStorage<> directLight(light, cubeShader, "directionLight");
 
-	std::vector<PointLightsourceAutomaticStorage<>> pointLights;
+	PointLightArray<> pointLights(cubeShader, "pointLight");
 	for (int _index = 0; _index < 4; _index++) {
-		pointLights.push_back(PointLightsourceAutomaticStorage<>(	
+		pointLights.add(PointLightPOD<>(
 			glm::vec4(pointLightPositions[_index], 1.0f),
 			pointLightColour[_index],
 			pointLightColour[_index],
 			pointLightColour[_index],
 			pointLightAttenuation[_index].x,
 			pointLightAttenuation[_index].y,
-			pointLightAttenuation[_index].z,
-			cubeShader,
-			"pointLights"));
-		pointLights.back()[_index];
+			pointLightAttenuation[_index].z));
 
 		our::mat4 _buffMat = our::translate(glm::mat4(), pointLightPositions[_index]);
 		_buffMat = our::scale(_buffMat, glm::vec3(0.4f));
@@ -119,7 +117,7 @@ int main()
 		our::mat4 _buffMat = our::translate(glm::mat4(), cubePositions[_index]);
 		_buffMat = our::rotate(_buffMat, _index*20.0f, glm::vec3(1.0f, 0.3f, 0.5f));
 		dynamic_cast<InstanceData*>((*cube)[_index])->modelMatrix.setValue(_buffMat);
-		dynamic_cast<InstanceData*>((*cube)[_index])->modelMatrix.setName("model");
+		dynamic_cast<InstanceData*>((*cube)[_index])->modelMatrix.setName(UNIFORM_NAME_ID("model"));
 		float _buffShi = 128.0f;
 		dynamic_cast<InstanceData*>((*cube)[_index])->material(_buffShi, TextureMaterialStructComponents::SHININESS);
 		dynamic_cast<InstanceData*>((*cube)[_index])->setShader(cubeShader);
@@ -130,16 +128,18 @@ int main()
 	camera = new SimpleCamera();
 	camera->setPerspectiveData(glm::radians(100.0f), (float)width / height, 0.1f, 1000.0f);
 	camera->setProjectionMode(SimpleCamera::ProjectionMode::MODE_PERSPECTIVE);
-	camera->Setup(cubeShader);
-	camera->push(WorldOriginShader);
-	camera->push(lightCubeShader);
+	camera->Setup();
+	//Camera is written once per frame to buffer shared by all shaders
+	cameraBlock = new UniformBlock("Camera", UNIFORM_BLOCK_CAMERA_BINDING);
+	cameraBlock->attach(WorldOriginShader);
+	cameraBlock->attach(cubeShader);
+	cameraBlock->attach(lightCubeShader);
 	camera->speed = 1.5f;
 	camera->sensitivity.x = 0.15f;
 	camera->sensitivity.y = 0.15f;
 	camera->position.z = 5.0f;
 	camera->position.y = 6.0f;
 	camera->lockUp = true;
-	Vec3AutomaticObserver<> viewPosition(&(camera->position), cubeShader, "viewPos");
 
 	//main loop
 	while (!glfwWindowShouldClose(window))
@@ -154,6 +154,9 @@ int main()
 		
 		//Update camera state
 		camera->Update();
+		cameraBlock->writer().reset();
+		camera->writeStd140(cameraBlock->writer());
+		cameraBlock->upload();
 
 		offset += deltaTime;
 
@@ -168,6 +171,7 @@ int main()
 		deltaTime = currentFrame - lastFrame;
 		lastFrame = currentFrame;
 	}
+	delete cameraBlock;
 	glfwTerminate();
 	return 0;
 }
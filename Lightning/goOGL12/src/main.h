@@ -33,6 +33,7 @@
 #include "general/CIndexPool.h"
 #include "assets/textures/CUniformTexture.h"
 #include "assets/shader/CShader.h"
+#include "assets/shader/CUniformBlock.h"
 #include "assets/model/CSimpleModel.h"
 #include "assets/model/CSeparateModel.h"
 #include "assets/model/CCombinedModel.h"
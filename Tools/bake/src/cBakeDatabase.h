@@ -0,0 +1,162 @@
+#ifndef BAKEDATABASE_H
+#define BAKEDATABASE_H "[multi@cBakeDatabase.h]"
+/*
+*	DESCRIPTION:
+*		Module contains implementation of dependency database of bake tool.
+*		For every baked asset database stores size, modification time and content hash
+*		of its source, version of baker that made it and size and time of other files
+*		read with source (included files of shader).
+*		Source with the same size and time and unchanged dependencies isn't read at all,
+*		otherwise asset is rebuilt only if its content hash is changed.
+*		Database is a text file, one record per line, followed by its dependencies:
+*			version size time hash key
+*			+ size time path
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+//PLATFORM
+#include <sys/types.h>
+#include <sys/stat.h>
+//OUR
+#include "general/cPackArchive.hpp"
+
+namespace bake {
+
+	/**
+	*	\brief State of one baked asset.
+	*	Struct definition: BakeRecord
+	**/
+	struct BakeRecord {
+		uint32_t version;
+		uint64_t size;
+		int64_t time;
+		uint64_t hash;
+		//Other files read with source: path, size and time
+		struct Dependency {
+			std::string path;
+			uint64_t size;
+			int64_t time;
+		};
+		std::vector<Dependency> dependencies;
+
+		BakeRecord() : version(0), size(0), time(0), hash(0) {}
+	};
+
+	/**
+	*	\brief Size and modification time of file '_path'.
+	*	\return False if file doesn't exist.
+	**/
+	inline bool fileStamp(const std::string& _path, uint64_t& _size, int64_t& _time) {
+		struct stat _stat;
+		if (stat(_path.c_str(), &_stat) != 0)
+			return false;
+		_size = (uint64_t)_stat.st_size;
+		_time = (int64_t)_stat.st_mtime;
+		return true;
+	}
+
+	/**
+	*	\brief Checks that any dependency of '_record' is changed or missing.
+	**/
+	inline bool dependenciesChanged(const BakeRecord& _record) {
+		for (auto& _dependency : _record.dependencies) {
+			uint64_t _size;
+			int64_t _time;
+			if (!fileStamp(_dependency.path, _size, _time) || _size != _dependency.size || _time != _dependency.time)
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	*	\brief Content hash of '_content'.
+	**/
+	inline uint64_t contentHash(const std::vector<char>& _content) {
+		return PackArchive::hash(_content.data(), _content.size());
+	}
+
+	/**
+	*	\brief Dependency database: records of baked assets by key.
+	*	Methods may be called from many threads simultaneously.
+	*	Class definition: BakeDatabase
+	**/
+	class BakeDatabase {
+		std::map<std::string, BakeRecord> records;
+		mutable std::mutex lock;
+		std::string path;
+	public:
+		/**
+		*	\brief Loads database from '_path'. Missing file is empty database.
+		**/
+		explicit BakeDatabase(const std::string& _path) : path(_path) {
+			std::ifstream _stream(path);
+			std::string _line;
+			BakeRecord* _last = nullptr;
+			while (std::getline(_stream, _line)) {
+				std::istringstream _fields(_line);
+				if (!_line.compare(0, 2, "+ ")) {
+					BakeRecord::Dependency _dependency;
+					_fields.ignore(2);
+					_fields >> _dependency.size >> _dependency.time;
+					_fields.get();
+					if (_last && _fields && std::getline(_fields, _dependency.path) && !_dependency.path.empty())
+						_last->dependencies.push_back(std::move(_dependency));
+					continue;
+				}
+				BakeRecord _record;
+				std::string _key;
+				_fields >> _record.version >> _record.size >> _record.time >> std::hex >> _record.hash >> std::dec;
+				_fields.get();
+				_last = nullptr;
+				if (_fields && std::getline(_fields, _key) && !_key.empty())
+					_last = &(records[_key] = _record);
+			}
+		}
+
+		/**
+		*	\brief Finds record of '_key'.
+		*	\return False if there is no record.
+		**/
+		bool find(const std::string& _key, BakeRecord& _record) const {
+			std::lock_guard<std::mutex> _guard(lock);
+			auto _it = records.find(_key);
+			if (_it == records.end())
+				return false;
+			_record = _it->second;
+			return true;
+		}
+
+		//Sets record of '_key'
+		void update(const std::string& _key, const BakeRecord& _record) {
+			std::lock_guard<std::mutex> _guard(lock);
+			records[_key] = _record;
+		}
+
+		/**
+		*	\brief Writes database to its file.
+		*	\return False if file can't be written.
+		**/
+		bool save() const {
+			std::lock_guard<std::mutex> _guard(lock);
+			std::ofstream _stream(path, std::ios::trunc);
+			for (auto& _record : records) {
+				_stream << _record.second.version << ' ' << _record.second.size << ' ' << _record.second.time << ' '
+						<< std::hex << _record.second.hash << std::dec << ' ' << _record.first << '\n';
+				for (auto& _dependency : _record.second.dependencies)
+					_stream << "+ " << _dependency.size << ' ' << _dependency.time << ' ' << _dependency.path << '\n';
+			}
+			return (bool)_stream;
+		}
+	};
+}
+#endif
\ No newline at end of file
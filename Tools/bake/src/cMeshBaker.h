@@ -0,0 +1,292 @@
+#ifndef MESHBAKER_H
+#define MESHBAKER_H "[multi@cMeshBaker.h]"
+/*
+*	DESCRIPTION:
+*		Module contains mesh baker: Wavefront OBJ source to MeshFile.
+*		Faces are triangulated, equal vertices are merged.
+*		Triangles are reordered for post-transform vertex cache
+*		(T. Forsyth, "Linear-speed vertex cache optimisation"),
+*		then vertices are reordered by first use for sequential fetch.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <map>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+//OUR
+#include "general/cMeshFile.hpp"
+
+namespace bake {
+
+	//Version of mesh baker: change to rebuild all meshes
+	CONST_OR_CONSTEXPR uint32_t MESH_BAKER_VERSION = 1;
+
+	//Size of modeled vertex cache
+	CONST_OR_CONSTEXPR int VERTEX_CACHE_SIZE = 32;
+
+	/**
+	*	\brief Score of vertex by its position in cache and count of triangles left to be drawn with it.
+	**/
+	inline float vertexScore(int _cachePosition, int _remaining) {
+		if (!_remaining)
+			return -1.0f;
+		float _score = 0.0f;
+		if (_cachePosition >= 0) {
+			//Vertices of the last triangle are scored lower: they shouldn't be used twice in a row
+			if (_cachePosition < 3)
+				_score = 0.75f;
+			else
+				_score = std::pow(1.0f - (float)(_cachePosition - 3) / (VERTEX_CACHE_SIZE - 3), 1.5f);
+		}
+		//Vertices with few triangles left are preferred to finish them off
+		return _score + 2.0f * std::pow((float)_remaining, -0.5f);
+	}
+
+	/**
+	*	\brief Reorders triangles of '_indices' for vertex cache.
+	*	\param[in,out]	_indices	Triangle list.
+	*	\param[in]		_vertices	Count of vertices.
+	**/
+	inline void optimizeVertexCache(std::vector<uint32_t>& _indices, size_t _vertices) {
+		size_t _triangles = _indices.size() / 3;
+		if (_triangles < 2)
+			return;
+		//Triangles of every vertex in one array
+		std::vector<uint32_t> _firstTriangle(_vertices + 1, 0);
+		for (uint32_t _index : _indices)
+			_firstTriangle[_index + 1]++;
+		for (size_t _vertex = 0; _vertex < _vertices; _vertex++)
+			_firstTriangle[_vertex + 1] += _firstTriangle[_vertex];
+		std::vector<uint32_t> _adjacency(_indices.size());
+		std::vector<int> _remaining(_vertices, 0);
+		for (size_t _index = 0; _index < _indices.size(); _index++) {
+			uint32_t _vertex = _indices[_index];
+			_adjacency[_firstTriangle[_vertex] + _remaining[_vertex]++] = (uint32_t)(_index / 3);
+		}
+		std::vector<int> _cachePosition(_vertices, -1);
+		std::vector<float> _vertexScore(_vertices);
+		for (size_t _vertex = 0; _vertex < _vertices; _vertex++)
+			_vertexScore[_vertex] = vertexScore(-1, _remaining[_vertex]);
+		std::vector<float> _triangleScore(_triangles);
+		std::vector<bool> _drawn(_triangles, false);
+		for (size_t _triangle = 0; _triangle < _triangles; _triangle++)
+			_triangleScore[_triangle] = _vertexScore[_indices[_triangle * 3]] + _vertexScore[_indices[_triangle * 3 + 1]] + _vertexScore[_indices[_triangle * 3 + 2]];
+		std::vector<uint32_t> _result;
+		_result.reserve(_indices.size());
+		std::vector<uint32_t> _cache, _newCache;
+		size_t _scan = 0;
+		while (_result.size() < _indices.size()) {
+			//Best triangle of vertices in cache, or the first not drawn one
+			long long _best = -1;
+			float _bestScore = -1.0f;
+			for (uint32_t _vertex : _cache)
+				for (uint32_t _index = _firstTriangle[_vertex]; _index < _firstTriangle[_vertex + 1]; _index++) {
+					uint32_t _triangle = _adjacency[_index];
+					if (!_drawn[_triangle] && _triangleScore[_triangle] > _bestScore) {
+						_bestScore = _triangleScore[_triangle];
+						_best = _triangle;
+					}
+				}
+			if (_best < 0) {
+				while (_drawn[_scan])
+					_scan++;
+				_best = (long long)_scan;
+			}
+			_drawn[(size_t)_best] = true;
+			_newCache.clear();
+			for (int _corner = 0; _corner < 3; _corner++) {
+				uint32_t _vertex = _indices[(size_t)_best * 3 + _corner];
+				_result.push_back(_vertex);
+				_newCache.push_back(_vertex);
+				_remaining[_vertex]--;
+			}
+			for (uint32_t _vertex : _cache)
+				if (_vertex != _newCache[0] && _vertex != _newCache[1] && _vertex != _newCache[2])
+					_newCache.push_back(_vertex);
+			for (uint32_t _vertex : _cache)
+				_cachePosition[_vertex] = -1;
+			for (size_t _position = 0; _position < _newCache.size(); _position++) {
+				uint32_t _vertex = _newCache[_position];
+				_cachePosition[_vertex] = _position < (size_t)VERTEX_CACHE_SIZE ? (int)_position : -1;
+				_vertexScore[_vertex] = vertexScore(_cachePosition[_vertex], _remaining[_vertex]);
+			}
+			//Scores of triangles changed only for vertices that were or are in cache
+			for (uint32_t _vertex : _newCache)
+				for (uint32_t _index = _firstTriangle[_vertex]; _index < _firstTriangle[_vertex + 1]; _index++) {
+					uint32_t _triangle = _adjacency[_index];
+					if (!_drawn[_triangle])
+						_triangleScore[_triangle] = _vertexScore[_indices[_triangle * 3]] + _vertexScore[_indices[_triangle * 3 + 1]] + _vertexScore[_indices[_triangle * 3 + 2]];
+				}
+			if (_newCache.size() > (size_t)VERTEX_CACHE_SIZE)
+				_newCache.resize(VERTEX_CACHE_SIZE);
+			_cache.swap(_newCache);
+		}
+		_indices.swap(_result);
+	}
+
+	/**
+	*	\brief Reorders '_vertices' of '_stride' floats in order of first use by '_indices'.
+	*	Unused vertices are removed.
+	**/
+	inline void optimizeVertexFetch(std::vector<float>& _vertices, std::vector<uint32_t>& _indices, size_t _stride) {
+		const uint32_t _unused = ~0u;
+		std::vector<uint32_t> _remap(_vertices.size() / _stride, _unused);
+		std::vector<float> _result;
+		_result.reserve(_vertices.size());
+		uint32_t _next = 0;
+		for (uint32_t& _index : _indices) {
+			if (_remap[_index] == _unused) {
+				_remap[_index] = _next++;
+				_result.insert(_result.end(), _vertices.begin() + _index * _stride, _vertices.begin() + (_index + 1) * _stride);
+			}
+			_index = _remap[_index];
+		}
+		_vertices.swap(_result);
+	}
+
+	/**
+	*	\brief Resolves OBJ index '_token' (1-based or negative relative) to 0-based index in array of '_count' elements.
+	*	\return False if index is out of range.
+	**/
+	inline bool objIndex(const std::string& _token, size_t _count, long& _index) {
+		char* _end = nullptr;
+		long _value = std::strtol(_token.c_str(), &_end, 10);
+		if (_end == _token.c_str() || !_value)
+			return false;
+		_index = _value < 0 ? (long)_count + _value : _value - 1;
+		return _index >= 0 && (size_t)_index < _count;
+	}
+
+	/**
+	*	\brief Bakes Wavefront OBJ content '_source' to mesh file '_out'.
+	*	Positions, texture coordinates and normals are used; materials and groups are ignored.
+	*	\param[out]	_error	Message if baking fails.
+	*	\return Success of baking.
+	**/
+	inline bool bakeMesh(const std::vector<char>& _source, std::vector<char>& _out, std::string& _error) {
+		std::vector<float> _positions, _texCoords, _normals;
+		//Face corners: position, texture coordinate and normal indices, -1 if absent
+		std::vector<std::tuple<long, long, long>> _corners;
+		std::istringstream _stream(std::string(_source.begin(), _source.end()));
+		std::string _line;
+		size_t _lineNumber = 0;
+		while (std::getline(_stream, _line)) {
+			_lineNumber++;
+			std::istringstream _fields(_line);
+			std::string _type;
+			_fields >> _type;
+			float _value[3] = { 0.0f, 0.0f, 0.0f };
+			if (_type == "v") {
+				_fields >> _value[0] >> _value[1] >> _value[2];
+				_positions.insert(_positions.end(), _value, _value + 3);
+			} else if (_type == "vt") {
+				_fields >> _value[0] >> _value[1];
+				_texCoords.insert(_texCoords.end(), _value, _value + 2);
+			} else if (_type == "vn") {
+				_fields >> _value[0] >> _value[1] >> _value[2];
+				_normals.insert(_normals.end(), _value, _value + 3);
+			} else if (_type == "f") {
+				std::vector<std::tuple<long, long, long>> _face;
+				std::string _corner;
+				while (_fields >> _corner) {
+					std::string _parts[3];
+					size_t _part = 0;
+					for (char _char : _corner) {
+						if (_char == '/') {
+							if (++_part > 2)
+								break;
+						} else {
+							_parts[_part] += _char;
+						}
+					}
+					long _position = -1, _texCoord = -1, _normal = -1;
+					if (!objIndex(_parts[0], _positions.size() / 3, _position) ||
+						(!_parts[1].empty() && !objIndex(_parts[1], _texCoords.size() / 2, _texCoord)) ||
+						(!_parts[2].empty() && !objIndex(_parts[2], _normals.size() / 3, _normal)))
+					{
+						_error = "bad face index at line " + std::to_string(_lineNumber);
+						return false;
+					}
+					_face.emplace_back(_position, _texCoord, _normal);
+				}
+				//Polygon as fan of triangles
+				for (size_t _index = 2; _index < _face.size(); _index++) {
+					_corners.push_back(_face[0]);
+					_corners.push_back(_face[_index - 1]);
+					_corners.push_back(_face[_index]);
+				}
+			}
+		}
+		if (_corners.empty()) {
+			_error = "mesh has no faces";
+			return false;
+		}
+		bool _hasTexCoords = true, _hasNormals = true;
+		for (auto& _corner : _corners) {
+			_hasTexCoords = _hasTexCoords && std::get<1>(_corner) >= 0;
+			_hasNormals = _hasNormals && std::get<2>(_corner) >= 0;
+		}
+		MeshFile::Header _header;
+		std::memset(&_header, 0, sizeof(_header));
+		for (auto& _attribute : _header.attributes) {
+			_attribute[0] = -1;
+			_attribute[1] = 0;
+		}
+		_header.stride = 0;
+		_header.attributes[MeshFile::POSITION][0] = (int32_t)_header.stride;
+		_header.attributes[MeshFile::POSITION][1] = 3;
+		_header.stride += 3;
+		if (_hasTexCoords) {
+			_header.attributes[MeshFile::TEXCOORD][0] = (int32_t)_header.stride;
+			_header.attributes[MeshFile::TEXCOORD][1] = 2;
+			_header.stride += 2;
+		}
+		if (_hasNormals) {
+			_header.attributes[MeshFile::NORMAL][0] = (int32_t)_header.stride;
+			_header.attributes[MeshFile::NORMAL][1] = 3;
+			_header.stride += 3;
+		}
+		std::vector<float> _vertices;
+		std::vector<uint32_t> _indices;
+		std::map<std::tuple<long, long, long>, uint32_t> _unique;
+		for (auto& _corner : _corners) {
+			auto _found = _unique.find(_corner);
+			if (_found != _unique.end()) {
+				_indices.push_back(_found->second);
+				continue;
+			}
+			uint32_t _index = (uint32_t)_unique.size();
+			_unique[_corner] = _index;
+			_indices.push_back(_index);
+			const float* _position = &_positions[std::get<0>(_corner) * 3];
+			_vertices.insert(_vertices.end(), _position, _position + 3);
+			if (_hasTexCoords)
+				_vertices.insert(_vertices.end(), &_texCoords[std::get<1>(_corner) * 2], &_texCoords[std::get<1>(_corner) * 2] + 2);
+			if (_hasNormals)
+				_vertices.insert(_vertices.end(), &_normals[std::get<2>(_corner) * 3], &_normals[std::get<2>(_corner) * 3] + 3);
+		}
+		optimizeVertexCache(_indices, _unique.size());
+		optimizeVertexFetch(_vertices, _indices, _header.stride);
+		for (int _axis = 0; _axis < 3; _axis++) {
+			_header.boundsMin[_axis] = _vertices[_axis];
+			_header.boundsMax[_axis] = _vertices[_axis];
+		}
+		for (size_t _vertex = 0; _vertex < _vertices.size(); _vertex += _header.stride)
+			for (int _axis = 0; _axis < 3; _axis++) {
+				_header.boundsMin[_axis] = std::fmin(_header.boundsMin[_axis], _vertices[_vertex + _axis]);
+				_header.boundsMax[_axis] = std::fmax(_header.boundsMax[_axis], _vertices[_vertex + _axis]);
+			}
+		MeshFile::write(_header, _vertices, _indices, _out);
+		return true;
+	}
+}
+#endif
\ No newline at end of file
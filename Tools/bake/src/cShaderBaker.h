@@ -0,0 +1,111 @@
+#ifndef SHADERBAKER_H
+#define SHADERBAKER_H "[multi@cShaderBaker.h]"
+/*
+*	DESCRIPTION:
+*		Module contains shader baker: GLSL source to compact GLSL source.
+*		Includes are expanded by ShaderPreprocessor when source is read (readShader),
+*		so baked shader is self-contained and included files are its dependencies.
+*		Comments, indentation and trailing spaces are removed, line ends are '\n'.
+*		Line count is kept: compiler messages point to lines of original source.
+*		Source string numbers of #line are indexes of files in readShader '_files'.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <cstdint>
+//OUR
+#include "general/vs2013tweaks.h"
+#include "general/cVirtualFileSystem.hpp"
+#include "assets/shader/CShaderPreprocessor.h"
+
+namespace bake {
+
+	//Version of shader baker: change to rebuild all shaders
+	CONST_OR_CONSTEXPR uint32_t SHADER_BAKER_VERSION = 2;
+
+	/**
+	*	\brief Reads GLSL source '_path' from disk with all its includes expanded.
+	*	\param[out]	_out	Expanded source.
+	*	\param[out]	_files	Read files: '_path' first, then included files in order of first inclusion.
+	*	\param[out]	_error	Message if reading fails.
+	*	\return Success of reading.
+	**/
+	inline bool readShader(const std::string& _path, std::vector<char>& _out, std::vector<std::string>& _files, std::string& _error) {
+		//File system without mounts reads paths from disk as is
+		VirtualFileSystem _disk;
+		ShaderPreprocessor _preprocessor(_disk);
+		std::string _text;
+		bool _success = _preprocessor.load(_path, std::string(), _text);
+		_files = _preprocessor.getFiles();
+		if (!_success) {
+			_error = "source or included file can't be read";
+			return false;
+		}
+		_out.assign(_text.begin(), _text.end());
+		return true;
+	}
+
+	/**
+	*	\brief Bakes GLSL source '_source' to '_out'.
+	*	\param[out]	_error	Message if baking fails.
+	*	\return Success of baking.
+	**/
+	inline bool bakeShader(const std::vector<char>& _source, std::vector<char>& _out, std::string& _error) {
+		std::string _text(_source.begin(), _source.end());
+		//UTF-8 byte order mark
+		if (!_text.compare(0, 3, "\xEF\xBB\xBF"))
+			_text.erase(0, 3);
+		if (_text.find("#version") == std::string::npos) {
+			_error = "#version directive is missing";
+			return false;
+		}
+		std::string _result, _line;
+		bool _blockComment = false;
+		for (size_t _index = 0; _index <= _text.size(); _index++) {
+			char _char = _index < _text.size() ? _text[_index] : '\n';
+			char _next = _index + 1 < _text.size() ? _text[_index + 1] : '\0';
+			if (_char == '\r')
+				continue;
+			if (_char == '\n') {
+				size_t _begin = _line.find_first_not_of(" \t");
+				size_t _end = _line.find_last_not_of(" \t");
+				if (_begin != std::string::npos)
+					_result.append(_line, _begin, _end - _begin + 1);
+				if (_index < _text.size())
+					_result += '\n';
+				_line.clear();
+				continue;
+			}
+			if (_blockComment) {
+				if (_char == '*' && _next == '/') {
+					_blockComment = false;
+					_index++;
+				}
+				continue;
+			}
+			if (_char == '/' && _next == '/') {
+				while (_index + 1 < _text.size() && _text[_index + 1] != '\n')
+					_index++;
+				continue;
+			}
+			if (_char == '/' && _next == '*') {
+				_blockComment = true;
+				_line += ' ';
+				_index++;
+				continue;
+			}
+			_line += _char;
+		}
+		if (_blockComment) {
+			_error = "unterminated comment";
+			return false;
+		}
+		_out.assign(_result.begin(), _result.end());
+		return true;
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef TEXTUREBAKER_H
+#define TEXTUREBAKER_H "[multi@cTextureBaker.h]"
+/*
+*	DESCRIPTION:
+*		Module contains texture baker: PNG/JPG/... source to TextureFile.
+*		Image is decoded by SOIL and expanded to RGBA8: four byte pixels are
+*		uploaded by driver without repacking and rows never need unpack alignment.
+*		Full mipmap chain is made by 2x2 box filter.
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <vector>
+#include <string>
+#include <cstring>
+//SOIL
+#include <SOIL/SOIL.h>
+//OUR
+#include "general/cTextureFile.hpp"
+
+namespace bake {
+
+	//Version of texture baker: change to rebuild all textures
+	CONST_OR_CONSTEXPR uint32_t TEXTURE_BAKER_VERSION = 1;
+
+	/**
+	*	\brief Makes level of half size from '_source' level '_width' x '_height' of RGBA pixels.
+	*	Odd last row and column are averaged with themselves.
+	**/
+	inline void downsample(const unsigned char* _source, uint32_t _width, uint32_t _height, unsigned char* _destination) {
+		uint32_t _newWidth = TextureFile::levelSize(_width, 1);
+		uint32_t _newHeight = TextureFile::levelSize(_height, 1);
+		for (uint32_t _y = 0; _y < _newHeight; _y++) {
+			uint32_t _y0 = _y * 2, _y1 = _y0 + 1 < _height ? _y0 + 1 : _y0;
+			for (uint32_t _x = 0; _x < _newWidth; _x++) {
+				uint32_t _x0 = _x * 2, _x1 = _x0 + 1 < _width ? _x0 + 1 : _x0;
+				for (uint32_t _channel = 0; _channel < 4; _channel++) {
+					unsigned int _sum = _source[(_y0 * _width + _x0) * 4 + _channel] + _source[(_y0 * _width + _x1) * 4 + _channel] +
+										_source[(_y1 * _width + _x0) * 4 + _channel] + _source[(_y1 * _width + _x1) * 4 + _channel];
+					_destination[(_y * _newWidth + _x) * 4 + _channel] = (unsigned char)((_sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	/**
+	*	\brief Bakes image file content '_source' to texture file '_out'.
+	*	\param[out]	_error	Message if baking fails.
+	*	\return Success of baking.
+	**/
+	inline bool bakeTexture(const std::vector<char>& _source, std::vector<char>& _out, std::string& _error) {
+		int _width = 0, _height = 0, _channels = 0;
+		unsigned char* _image = SOIL_load_image_from_memory((const unsigned char*)_source.data(), (int)_source.size(), &_width, &_height, &_channels, SOIL_LOAD_RGBA);
+		if (!_image) {
+			_error = SOIL_last_result();
+			return false;
+		}
+		TextureFile::Header _header;
+		std::memset(&_header, 0, sizeof(_header));
+		_header.width = (uint32_t)_width;
+		_header.height = (uint32_t)_height;
+		_header.channels = 4;
+		_header.levels = TextureFile::fullChain(_header.width, _header.height);
+		//GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE
+		_header.glInternalFormat = 0x8058;
+		_header.glFormat = 0x1908;
+		_header.glType = 0x1401;
+		std::vector<unsigned char> _pixels((size_t)TextureFile::dataSize(_header.width, _header.height, 4, _header.levels));
+		std::memcpy(_pixels.data(), _image, (size_t)_width * _height * 4);
+		SOIL_free_image_data(_image);
+		unsigned char* _level = _pixels.data();
+		for (uint32_t _index = 0; _index + 1 < _header.levels; _index++) {
+			uint32_t _levelWidth = TextureFile::levelSize(_header.width, _index);
+			uint32_t _levelHeight = TextureFile::levelSize(_header.height, _index);
+			unsigned char* _next = _level + (size_t)_levelWidth * _levelHeight * 4;
+			downsample(_level, _levelWidth, _levelHeight, _next);
+			_level = _next;
+		}
+		TextureFile::write(_header, _pixels, _out);
+		return true;
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,258 @@
+/*
+*	DESCRIPTION:
+*		Offline asset bake tool: converts source assets to engine-ready formats
+*		and packs them to one pack archive for VirtualFileSystem.
+*			texture : image -> TextureFile (RGBA8, full mipmap chain), stored for mapping
+*			mesh    : Wavefront OBJ -> MeshFile (vertex cache optimized), stored for mapping
+*			shader  : GLSL -> GLSL with expanded includes and without comments, LZ4 compressed
+*		Manifest is a text file, one asset per line ('#' starts comment):
+*			<kind> <source path> <name in pack>
+*		Path with spaces is written in double quotes.
+*		Baked assets are kept in cache directory with dependency database:
+*		only assets with changed sources, included files or bakers are rebuilt, by all cores.
+*		Build (Linux):
+*			g++ -std=c++14 -O2 -I../../../Framework -I../../../Framework/general main.cpp -lSOIL -pthread -o bake
+*		Run:
+*			./bake <manifest> <output pack> [cache directory]
+*	AUTHOR:
+*		Mikhail Demchenko
+*		mailto:dev.echo.mike@gmail.com
+*		https://github.com/echo-Mike
+*/
+//STD
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstdio>
+//OUR
+#include "general/cJobSystem.hpp"
+#include "general/cPackArchive.hpp"
+#include "general/cVirtualFileSystem.hpp"
+#include "cBakeDatabase.h"
+#include "cTextureBaker.h"
+#include "cMeshBaker.h"
+#include "cShaderBaker.h"
+
+/**
+*	\brief One asset of manifest.
+*	Struct definition: BakeItem
+**/
+struct BakeItem {
+	std::string kind;
+	std::string source;
+	std::string name;
+	//Baked file in cache directory
+	std::string output;
+};
+
+/**
+*	\brief Splits '_line' to whitespace separated fields, double quotes group field with spaces.
+**/
+std::vector<std::string> splitFields(const std::string& _line) {
+	std::vector<std::string> _fields;
+	std::string _field;
+	bool _quoted = false, _started = false;
+	for (char _char : _line) {
+		if (_char == '"') {
+			_quoted = !_quoted;
+			_started = true;
+		} else if (!_quoted && (_char == ' ' || _char == '\t' || _char == '\r')) {
+			if (_started)
+				_fields.push_back(_field);
+			_field.clear();
+			_started = false;
+		} else if (!_quoted && _char == '#') {
+			break;
+		} else {
+			_field += _char;
+			_started = true;
+		}
+	}
+	if (_started)
+		_fields.push_back(_field);
+	return _fields;
+}
+
+/**
+*	\brief Reads whole file '_path' to '_out'.
+**/
+bool readFile(const std::string& _path, std::vector<char>& _out) {
+	return DirectorySource("").read(_path, _out);
+}
+
+/**
+*	\brief Writes '_data' to file '_path'.
+**/
+bool writeFile(const std::string& _path, const std::vector<char>& _data) {
+	std::ofstream _stream(_path, std::ios::binary | std::ios::trunc);
+	_stream.write(_data.data(), (std::streamsize)_data.size());
+	return (bool)_stream;
+}
+
+/**
+*	\brief Reads source of '_item' to '_out': shader is read with expanded includes.
+*	Included files are added to dependencies of '_record'.
+*	\param[out]	_error	Message if reading fails.
+**/
+bool readSource(const BakeItem& _item, std::vector<char>& _out, bake::BakeRecord& _record, std::string& _error) {
+	if (_item.kind != "shader") {
+		if (!readFile(_item.source, _out))
+			_error = "source can't be read";
+		return _error.empty();
+	}
+	std::vector<std::string> _files;
+	if (!bake::readShader(_item.source, _out, _files, _error))
+		return false;
+	for (size_t _index = 1; _index < _files.size(); _index++) {
+		bake::BakeRecord::Dependency _dependency;
+		_dependency.path = _files[_index];
+		if (!bake::fileStamp(_dependency.path, _dependency.size, _dependency.time)) {
+			_error = "included file not found: " + _dependency.path;
+			return false;
+		}
+		_record.dependencies.push_back(std::move(_dependency));
+	}
+	return true;
+}
+
+/**
+*	\brief Version of baker of '_kind', 0 for unknown kind.
+**/
+uint32_t bakerVersion(const std::string& _kind) {
+	if (_kind == "texture")
+		return bake::TEXTURE_BAKER_VERSION;
+	if (_kind == "mesh")
+		return bake::MESH_BAKER_VERSION;
+	if (_kind == "shader")
+		return bake::SHADER_BAKER_VERSION;
+	return 0;
+}
+
+/**
+*	\brief Bakes '_source' content by baker of '_kind'.
+**/
+bool bakeContent(const std::string& _kind, const std::vector<char>& _source, std::vector<char>& _out, std::string& _error) {
+	if (_kind == "texture")
+		return bake::bakeTexture(_source, _out, _error);
+	if (_kind == "mesh")
+		return bake::bakeMesh(_source, _out, _error);
+	return bake::bakeShader(_source, _out, _error);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3) {
+		std::cerr << "Usage: bake <manifest> <output pack> [cache directory]" << std::endl;
+		return 2;
+	}
+	std::string _cache = argc > 3 ? argv[3] : ".";
+	if (_cache.back() != '/' && _cache.back() != '\\')
+		_cache += '/';
+
+	std::vector<BakeItem> _items;
+	{
+		std::ifstream _manifest(argv[1]);
+		if (!_manifest) {
+			std::cerr << "ERROR::BAKE::Can't open manifest: " << argv[1] << std::endl;
+			return 1;
+		}
+		std::string _line;
+		size_t _lineNumber = 0;
+		//Items with same name would be baked to same cache file and packed twice
+		std::set<std::string> _names;
+		while (std::getline(_manifest, _line)) {
+			_lineNumber++;
+			std::vector<std::string> _fields = splitFields(_line);
+			if (_fields.empty())
+				continue;
+			if (_fields.size() != 3 || !bakerVersion(_fields[0])) {
+				std::cerr << "ERROR::BAKE::Bad manifest line " << _lineNumber << ": " << _line << std::endl;
+				return 1;
+			}
+			BakeItem _item;
+			_item.kind = _fields[0];
+			_item.source = _fields[1];
+			_item.name = VirtualFileSystem::normalize(_fields[2]);
+			if (!_names.insert(_item.name).second) {
+				std::cerr << "ERROR::BAKE::Duplicate name in pack at manifest line " << _lineNumber << ": " << _item.name << std::endl;
+				return 1;
+			}
+			char _file[32];
+			std::snprintf(_file, sizeof(_file), "%016llx.baked", (unsigned long long)PackArchive::hash(_item.name.data(), _item.name.size()));
+			_item.output = _cache + _file;
+			_items.push_back(std::move(_item));
+		}
+	}
+
+	bake::BakeDatabase _database(_cache + "bake.db");
+	std::atomic<unsigned int> _built(0), _failed(0);
+	std::mutex _log;
+	{
+		//Main thread helps while waiting: all cores are used
+		unsigned int _cores = std::thread::hardware_concurrency();
+		JobSystem _jobs(_cores > 1 ? _cores - 1 : 1);
+		JobSystem::Counter _counter;
+		for (auto& _item : _items)
+			_jobs.run([&_item, &_database, &_built, &_failed, &_log]() {
+				std::string _key = _item.kind + ' ' + _item.name + ' ' + _item.source;
+				bake::BakeRecord _record, _stored;
+				_record.version = bakerVersion(_item.kind);
+				std::string _error;
+				uint64_t _outputSize;
+				int64_t _outputTime;
+				bool _known = _database.find(_key, _stored) && _stored.version == _record.version && bake::fileStamp(_item.output, _outputSize, _outputTime);
+				if (!bake::fileStamp(_item.source, _record.size, _record.time)) {
+					_error = "source not found";
+				} else if (!_known || _stored.size != _record.size || _stored.time != _record.time || bake::dependenciesChanged(_stored)) {
+					std::vector<char> _source, _baked;
+					if (readSource(_item, _source, _record, _error)) {
+						_record.hash = bake::contentHash(_source);
+						if (!_known || _record.hash != _stored.hash) {
+							if (!bakeContent(_item.kind, _source, _baked, _error))
+								_error = _error.empty() ? "baking failed" : _error;
+							else if (!writeFile(_item.output, _baked))
+								_error = "output can't be written: " + _item.output;
+							else
+								_built++;
+						}
+						if (_error.empty())
+							_database.update(_key, _record);
+					}
+				}
+				if (!_error.empty()) {
+					_failed++;
+					std::lock_guard<std::mutex> _guard(_log);
+					std::cerr << "ERROR::BAKE::" << _item.kind << "::" << _item.source << "::" << _error << std::endl;
+				}
+			}, &_counter);
+		_jobs.wait(_counter);
+	}
+	if (!_database.save())
+		std::cerr << "WARNING::BAKE::Dependency database can't be written" << std::endl;
+	if (_failed) {
+		std::cerr << _failed << " of " << _items.size() << " assets failed" << std::endl;
+		return 1;
+	}
+
+	PackWriter _pack;
+	for (auto& _item : _items) {
+		std::vector<char> _baked;
+		if (!readFile(_item.output, _baked)) {
+			std::cerr << "ERROR::BAKE::Baked file is missing: " << _item.output << std::endl;
+			return 1;
+		}
+		_pack.add(_item.name, _baked.data(), _baked.size(), _item.kind == "shader" ? PackArchive::LZ4 : PackArchive::STORED);
+	}
+	if (!_pack.write(argv[2])) {
+		std::cerr << "ERROR::BAKE::Pack can't be written: " << argv[2] << std::endl;
+		return 1;
+	}
+	std::cout << _built << " of " << _items.size() << " assets rebuilt, pack written: " << argv[2] << std::endl;
+	return 0;
+}
\ No newline at end of file